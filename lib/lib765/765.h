@@ -151,6 +151,46 @@ FDRV_PTR fd_newnc9(FDRV_PTR fd);
 FDRV_PTR fd9_getproxy(FDRV_PTR self);
 void     fd9_setproxy(FDRV_PTR self, FDRV_PTR PROXY);
 
+/* Subclass of FLOPPY_DRIVE: a drive whose methods are implemented by the 
+ * host program. The method table has one entry per wrapper function below;
+ * a NULL entry behaves as on a dummy drive. The table must outlive the 
+ * drive. "data" is the host's own drive state, returned by fdh_getdata(). */
+
+typedef struct floppy_drive_vtable
+{
+	fd_err_t  (*fdv_seek_cylinder)(FDRV_PTR fd, int cylinder);
+	fd_err_t  (*fdv_read_id)      (FDRV_PTR fd, int head, 
+                                 int sector, fdc_byte *buf);
+	fd_err_t  (*fdv_read_sector  )(FDRV_PTR fd, int xcylinder, 
+		int xhead, int head, int sector, fdc_byte *buf, int len, 
+		int *deleted, int skip_deleted, int mfm, int multi);
+	fd_err_t  (*fdv_read_track   )(FDRV_PTR fd, int xcylinder,
+		int xhead, int head, fdc_byte *buf, int *len);
+	fd_err_t  (*fdv_write_sector )(FDRV_PTR fd, int xcylinder,
+		int xhead, int head, int sector, fdc_byte *buf, int len,
+		int deleted, int skip_deleted, int mfm, int multi);
+	fd_err_t (*fdv_format_track )(FDRV_PTR fd, int head, 
+		int sectors, fdc_byte *buf, fdc_byte filler);
+	fdc_byte (*fdv_drive_status )(FDRV_PTR fd);
+	int      (*fdv_isready)(FDRV_PTR fd);
+	int	 (*fdv_dirty  )(FDRV_PTR fd);
+	void     (*fdv_eject  )(FDRV_PTR fd);
+	void	 (*fdv_set_datarate)(FDRV_PTR fd, fdc_byte rate);
+	void     (*fdv_reset  )(FDRV_PTR fd);
+	void     (*fdv_destroy)(FDRV_PTR fd);
+	int	 (*fdv_changed)(FDRV_PTR fd);
+} FLOPPY_DRIVE_VTABLE;
+
+FDRV_PTR fd_newhost(FLOPPY_DRIVE_VTABLE *vtable, void *data);
+void *   fdh_getdata(FDRV_PTR self);
+
+/* For use by host drive methods only: update the READONLY members, and 
+ * compute the usual status bits from the drive type, readiness, read-only
+ * flag and current cylinder. */
+void     fd_setmotor (FDRV_PTR fd, int motor);
+void     fd_setcurcyl(FDRV_PTR fd, int cyl);
+fdc_byte fdd_drive_status(FDRV_PTR fd);
+
 
 /* Subclass of FLOPPY_DRIVE: a drive which emulates discs using the CPCEMU 
  * .DSK format */
@@ -278,6 +318,9 @@ void fdc_set_terminal_count(FDC_PTR self, fdc_byte value);
 void fdc_set_motor(FDC_PTR self, fdc_byte running);
 /* Call this once every cycle round the emulator's main loop */
 void fdc_tick(FDC_PTR self);
+/* Cut a pending interrupt countdown short, so that the interrupt is raised
+ * by the next call to fdc_tick() */
+void fdc_expire(FDC_PTR self);
 /* Write to the Digital Output Register. Write -1 to disable DOR emulation */
 void fdc_write_dor(FDC_PTR self, int value);
 /* Read from the Digital Input Register. */
@@ -232,6 +232,23 @@ FDRV_PTR fd_new(void)
 	return fd_inew(sizeof(FLOPPY_DRIVE));
 }
 
+/* Initialise a drive implemented by the host program */
+FDRV_PTR fd_newhost(FLOPPY_DRIVE_VTABLE *vtable, void *data)
+{
+	FDRV_PTR p = fd_inew(sizeof(HOST_FLOPPY_DRIVE));
+
+	if (!p) return NULL;
+	p->fd_vtable  = vtable;
+	p->fd_changed = 0;
+	((HOST_FLOPPY_DRIVE *)p)->fdh_data = data;
+	return p;
+}
+
+void *   fdh_getdata(FDRV_PTR self)
+{
+	return ((HOST_FLOPPY_DRIVE *)self)->fdh_data;
+}
+
 /* Initialise a 9256 dummy drive */
 FDRV_PTR fd_newnc9(FDRV_PTR fd)
 {
@@ -276,6 +293,9 @@ void fd_setreadonly(FDRV_PTR fd, int ro)    { fd->fd_readonly = ro; }
 int fd_getmotor    (FDRV_PTR fd) { return fd->fd_motor; }
 int fd_getcurcyl   (FDRV_PTR fd) { return fd->fd_cylinder; }
 
+void fd_setmotor   (FDRV_PTR fd, int motor) { fd->fd_motor = motor; }
+void fd_setcurcyl  (FDRV_PTR fd, int cyl)   { fd->fd_cylinder = cyl; }
+
 
 FDRV_PTR fd9_getproxy(FDRV_PTR self)
 {
@@ -1006,6 +1006,11 @@ void fdc_tick(FDC_765 *self)
 	} 
 }
 
+void fdc_expire(FDC_765 *self)
+{
+	if (self->fdc_isr_countdown > 1) self->fdc_isr_countdown = 1;
+}
+
 
 /* Simulate the Digital Output Register in the IBM PC and clones
  * This is not part of the uPD765A itself, but part of the support 
@@ -30,32 +30,6 @@
 
 
 
-typedef struct floppy_drive_vtable
-{
-	fd_err_t  (*fdv_seek_cylinder)(FDRV_PTR fd, int cylinder);
-	fd_err_t  (*fdv_read_id)      (FDRV_PTR fd, int head, 
-                                 int sector, fdc_byte *buf);
-	fd_err_t  (*fdv_read_sector  )(FDRV_PTR fd, int xcylinder, 
-		int xhead, int head, int sector, fdc_byte *buf, int len, 
-		int *deleted, int skip_deleted, int mfm, int multi);
-	fd_err_t  (*fdv_read_track   )(FDRV_PTR fd, int xcylinder,
-		int xhead, int head, fdc_byte *buf, int *len);
-	fd_err_t  (*fdv_write_sector )(FDRV_PTR fd, int xcylinder,
-		int xhead, int head, int sector, fdc_byte *buf, int len,
-		int deleted, int skip_deleted, int mfm, int multi);
-	fd_err_t (*fdv_format_track )(FDRV_PTR fd, int head, 
-		int sectors, fdc_byte *buf, fdc_byte filler);
-	fdc_byte (*fdv_drive_status )(FDRV_PTR fd);
-	int      (*fdv_isready)(FDRV_PTR fd);
-	int	 (*fdv_dirty  )(FDRV_PTR fd);
-	void     (*fdv_eject  )(FDRV_PTR fd);
-	void	 (*fdv_set_datarate)(FDRV_PTR fd, fdc_byte rate);
-	void     (*fdv_reset  )(FDRV_PTR fd);
-	void     (*fdv_destroy)(FDRV_PTR fd);
-	int	 (*fdv_changed)(FDRV_PTR fd);
-} FLOPPY_DRIVE_VTABLE;
-
-
 typedef struct floppy_drive
 {
 /* PRIVATE variables 
@@ -124,6 +98,12 @@ typedef struct nc9_floppy_drive
 	FLOPPY_DRIVE *nc9_fdd;		/* Pointer to the 9256's B drive */
 } NC9_FLOPPY_DRIVE;
 
+typedef struct host_floppy_drive
+{
+	FLOPPY_DRIVE fdh;		/* Base class */
+	void *fdh_data;			/* Host program's drive state */
+} HOST_FLOPPY_DRIVE;
+
 
 FDRV_PTR fd_inew(size_t size);
 
@@ -0,0 +1,278 @@
+/*
+ * cpc-framehash.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#define XCPC_CRC32C_SSE42 1
+#endif
+#include <xcpc/libxcpc-priv.h>
+#include "cpc-framehash.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::HashTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct HashTraits
+{
+    struct Table
+    {
+        uint32_t data[8][256];
+
+        Table()
+        {
+            constexpr uint32_t polynomial = 0x82f63b78u;
+
+            for(uint32_t index = 0; index < 256; ++index) {
+                uint32_t value = index;
+                for(int bit = 0; bit < 8; ++bit) {
+                    value = ((value >> 1) ^ ((value & 1) != 0 ? polynomial : 0));
+                }
+                data[0][index] = value;
+            }
+            for(uint32_t index = 0; index < 256; ++index) {
+                for(int slice = 1; slice < 8; ++slice) {
+                    const uint32_t value = data[slice - 1][index];
+                    data[slice][index] = (data[0][value & 0xff] ^ (value >> 8));
+                }
+            }
+        }
+    };
+
+    static auto table() -> const Table&
+    {
+        static const Table table;
+
+        return table;
+    }
+
+    static auto load32(const uint8_t* data) -> uint32_t
+    {
+        return (static_cast<uint32_t>(data[0]) <<  0)
+             | (static_cast<uint32_t>(data[1]) <<  8)
+             | (static_cast<uint32_t>(data[2]) << 16)
+             | (static_cast<uint32_t>(data[3]) << 24);
+    }
+
+    static auto crc32c_soft(uint32_t crc, const uint8_t* data, size_t size) -> uint32_t
+    {
+        const auto& table(HashTraits::table().data);
+
+        /* slicing-by-8: eight bytes per iteration */ {
+            while(size >= 8) {
+                const uint32_t lo = (load32(data + 0) ^ crc);
+                const uint32_t hi = (load32(data + 4));
+                crc = table[7][(lo >>  0) & 0xff]
+                    ^ table[6][(lo >>  8) & 0xff]
+                    ^ table[5][(lo >> 16) & 0xff]
+                    ^ table[4][(lo >> 24) & 0xff]
+                    ^ table[3][(hi >>  0) & 0xff]
+                    ^ table[2][(hi >>  8) & 0xff]
+                    ^ table[1][(hi >> 16) & 0xff]
+                    ^ table[0][(hi >> 24) & 0xff];
+                data += 8;
+                size -= 8;
+            }
+        }
+        /* one byte at a time for the tail */ {
+            while(size != 0) {
+                crc = (table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8));
+                --size;
+            }
+        }
+        return crc;
+    }
+
+#if defined(XCPC_CRC32C_SSE42)
+    __attribute__((target("sse4.2")))
+    static auto crc32c_sse42(uint32_t crc, const uint8_t* data, size_t size) -> uint32_t
+    {
+        uint64_t crc64 = crc;
+
+        while(size >= 8) {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            crc64 = _mm_crc32_u64(crc64, value);
+            data += 8;
+            size -= 8;
+        }
+        crc = static_cast<uint32_t>(crc64);
+        while(size != 0) {
+            crc = _mm_crc32_u8(crc, *data++);
+            --size;
+        }
+        return crc;
+    }
+
+    static auto has_sse42() -> bool
+    {
+        static const bool supported = (__builtin_cpu_supports("sse4.2") != 0);
+
+        return supported;
+    }
+#endif
+
+    static auto open_golden(const std::string& filename) -> FILE*
+    {
+        FILE* file = ::fopen(filename.c_str(), "r");
+
+        if(file == nullptr) {
+            throw std::runtime_error(std::string("unable to open golden list") + ' ' + '<' + filename + '>');
+        }
+        return file;
+    }
+
+    static auto open_output(const std::string& filename) -> FILE*
+    {
+        FILE* file = ::fopen(filename.c_str(), "w");
+
+        if(file == nullptr) {
+            throw std::runtime_error(std::string("unable to open hash output") + ' ' + '<' + filename + '>');
+        }
+        return file;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// cpc::FrameHash
+// ---------------------------------------------------------------------------
+
+namespace cpc {
+
+FrameHash::FrameHash()
+    : _output(nullptr)
+    , _golden()
+    , _comparing(false)
+    , _frame(0UL)
+{
+}
+
+FrameHash::~FrameHash()
+{
+    stop();
+}
+
+auto FrameHash::record(const std::string& filename) -> void
+{
+    FILE* output = HashTraits::open_output(filename);
+
+    if(_output != nullptr) {
+        _output = (::fclose(_output), nullptr);
+    }
+    _output = output;
+    _frame  = 0UL;
+}
+
+auto FrameHash::compare(const std::string& filename) -> void
+{
+    FILE*  file = HashTraits::open_golden(filename);
+    Golden golden;
+    char   line[256];
+
+    auto parse_line = [&]() -> void
+    {
+        unsigned long frame = 0UL;
+        unsigned int  hash  = 0U;
+
+        if((line[0] == '#') || (line[0] == '\n') || (line[0] == '\0')) {
+            return;
+        }
+        if((::sscanf(line, "%lu %x", &frame, &hash) != 2) || (frame != golden.size())) {
+            throw std::runtime_error(std::string("malformed golden list") + ' ' + '<' + filename + '>');
+        }
+        golden.push_back(static_cast<uint32_t>(hash));
+    };
+
+    try {
+        while(::fgets(line, sizeof(line), file) != nullptr) {
+            parse_line();
+        }
+        file = (::fclose(file), nullptr);
+    }
+    catch(...) {
+        file = (::fclose(file), nullptr);
+        throw;
+    }
+    _golden    = std::move(golden);
+    _comparing = true;
+    _frame     = 0UL;
+}
+
+auto FrameHash::stop() -> void
+{
+    if(_output != nullptr) {
+        _output = (::fclose(_output), nullptr);
+    }
+    _golden.clear();
+    _comparing = false;
+    _frame     = 0UL;
+}
+
+auto FrameHash::update(uint32_t hash) -> bool
+{
+    const unsigned long frame = _frame++;
+
+    if(_output != nullptr) {
+        static_cast<void>(::fprintf(_output, "%lu %08x\n", frame, hash));
+    }
+    if(_comparing != false) {
+        if(frame >= _golden.size()) {
+            ::xcpc_log_print("frame hash: all %lu frames match the golden list", frame);
+            _comparing = false;
+        }
+        else if(_golden[frame] != hash) {
+            ::xcpc_log_error("frame hash: frame %lu is %08x, expected %08x", frame, hash, _golden[frame]);
+            _comparing = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+auto FrameHash::crc32c(uint32_t crc, const uint8_t* data, size_t size) -> uint32_t
+{
+    crc = ~crc;
+#if defined(XCPC_CRC32C_SSE42)
+    if(HashTraits::has_sse42() != false) {
+        return ~HashTraits::crc32c_sse42(crc, data, size);
+    }
+#endif
+    crc = HashTraits::crc32c_soft(crc, data, size);
+    return ~crc;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,78 @@
+/*
+ * cpc-framehash.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_CPC_FRAMEHASH_H__
+#define __XCPC_CPC_FRAMEHASH_H__
+
+// ---------------------------------------------------------------------------
+// cpc::FrameHash
+// ---------------------------------------------------------------------------
+
+namespace cpc {
+
+class FrameHash
+{
+public: // public interface
+    FrameHash();
+
+    FrameHash(FrameHash&&) = delete;
+
+    FrameHash(const FrameHash&) = delete;
+
+    FrameHash& operator=(FrameHash&&) = delete;
+
+    FrameHash& operator=(const FrameHash&) = delete;
+
+    virtual ~FrameHash();
+
+    auto record(const std::string& filename) -> void;
+
+    auto compare(const std::string& filename) -> void;
+
+    auto stop() -> void;
+
+    auto update(uint32_t hash) -> bool;
+
+    auto is_enabled() const -> bool
+    {
+        return (_output != nullptr) || (_comparing != false);
+    }
+
+    auto get_frame() const -> unsigned long
+    {
+        return _frame;
+    }
+
+public: // public static interface
+    static auto crc32c(uint32_t crc, const uint8_t* data, size_t size) -> uint32_t;
+
+private: // private types
+    using Golden = std::vector<uint32_t>;
+
+private: // private data
+    FILE*         _output;
+    Golden        _golden;
+    bool          _comparing;
+    unsigned long _frame;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_CPC_FRAMEHASH_H__ */
@@ -98,6 +98,11 @@ auto Machine::clock() -> void
     _mainboard.clock();
 }
 
+auto Machine::fork(const unsigned int count) -> std::vector<std::unique_ptr<Mainboard>>
+{
+    return _mainboard.fork(count);
+}
+
 auto Machine::load_snapshot(const std::string& filename) -> void
 {
     return _mainboard.load_snapshot(filename);
@@ -138,6 +143,41 @@ auto Machine::remove_disk_from_drive1() -> void
     return _mainboard.remove_disk_from_drive1();
 }
 
+auto Machine::insert_tape(const std::string& filename) -> void
+{
+    return _mainboard.insert_tape(filename);
+}
+
+auto Machine::remove_tape() -> void
+{
+    return _mainboard.remove_tape();
+}
+
+auto Machine::rewind_tape() -> void
+{
+    return _mainboard.rewind_tape();
+}
+
+auto Machine::start_capture(const std::string& filename) -> void
+{
+    return _mainboard.start_capture(filename);
+}
+
+auto Machine::stop_capture() -> void
+{
+    return _mainboard.stop_capture();
+}
+
+auto Machine::start_frame_hashing(const std::string& output, const std::string& golden) -> void
+{
+    return _mainboard.start_frame_hashing(output, golden);
+}
+
+auto Machine::stop_frame_hashing() -> void
+{
+    return _mainboard.stop_frame_hashing();
+}
+
 auto Machine::set_parameterb(const std::string& parameter, bool value) -> void
 {
     return _mainboard.set_parameterb(parameter, value);
@@ -228,6 +268,11 @@ auto Machine::get_drive1_filename() const -> std::string
     return _mainboard.get_drive1_filename();
 }
 
+auto Machine::get_tape_filename() const -> std::string
+{
+    return _mainboard.get_tape_filename();
+}
+
 auto Machine::get_system_info() const -> std::string
 {
     return _mainboard.get_system_info();
@@ -243,6 +288,11 @@ auto Machine::get_volume() const -> float
     return _mainboard.get_volume();
 }
 
+auto Machine::get_snapshot_progress() const -> SnapshotProgress
+{
+    return _mainboard.get_snapshot_progress();
+}
+
 auto Machine::get_backend() const -> const Backend*
 {
     return &_backend;
@@ -51,6 +51,8 @@ public: // public interface
     virtual auto clock() -> void override final;
 
 public: // public interface
+    auto fork(const unsigned int count) -> std::vector<std::unique_ptr<Mainboard>>;
+
     auto load_snapshot(const std::string& filename) -> void;
 
     auto save_snapshot(const std::string& filename) -> void;
@@ -67,6 +69,20 @@ public: // public interface
 
     auto remove_disk_from_drive1() -> void;
 
+    auto insert_tape(const std::string& filename) -> void;
+
+    auto remove_tape() -> void;
+
+    auto rewind_tape() -> void;
+
+    auto start_capture(const std::string& filename) -> void;
+
+    auto stop_capture() -> void;
+
+    auto start_frame_hashing(const std::string& output, const std::string& golden) -> void;
+
+    auto stop_frame_hashing() -> void;
+
     auto set_parameterb(const std::string& parameter, bool value) -> void;
 
     auto set_parameteri(const std::string& parameter, int value) -> void;
@@ -103,12 +119,16 @@ public: // public interface
 
     auto get_drive1_filename() const -> std::string;
 
+    auto get_tape_filename() const -> std::string;
+
     auto get_system_info() const -> std::string;
 
     auto get_statistics() const -> std::string;
 
     auto get_volume() const -> float;
 
+    auto get_snapshot_progress() const -> SnapshotProgress;
+
     auto get_backend() const -> const Backend*;
 
     auto get_audio_device() -> AudioDevice&
@@ -53,6 +53,7 @@ struct Traits
     using State     = cpc::Mainboard::State;
     using Audio     = cpc::Mainboard::Audio;
     using Video     = cpc::Mainboard::Video;
+    using Dirty     = cpc::Mainboard::Dirty;
 
     static auto gettimeofday(TimeVal& tv) -> void
     {
@@ -73,6 +74,8 @@ struct Traits
         setup.speedup       = 1;
         setup.xshm          = true;
         setup.crt_emulation = true;
+        setup.crt_filter    = false;
+        setup.turbo_disk    = false;
     }
 
     static auto construct(Stats& stats) -> void
@@ -107,6 +110,7 @@ struct Traits
         state.psg_ticks   = 0;
         state.snd_clock   = 44100;
         state.snd_ticks   = 0;
+        state.cas_ticks   = 0;
         state.vdc_hsync   = 0; /* no hsync      */
         state.vdc_vsync   = 0; /* no vsync      */
         state.lnk_lk1     = 1; /* amstrad       */
@@ -165,6 +169,14 @@ struct Traits
         video.frame_time = 20000;
     }
 
+    static auto construct(Dirty& dirty) -> void
+    {
+        dirty.ram_base = nullptr;
+        for(auto& bits : dirty.bitmap) {
+            bits = ~0ULL;
+        }
+    }
+
     static auto destruct(Setup& setup) -> void
     {
         setup = Setup();
@@ -200,6 +212,11 @@ struct Traits
         video = Video();
     }
 
+    static auto destruct(Dirty& dirty) -> void
+    {
+        dirty = Dirty();
+    }
+
     static auto reset(Setup& setup) -> void
     {
     }
@@ -235,6 +252,7 @@ struct Traits
         state.psg_ticks   &= 0;
         state.snd_clock   |= 0;
         state.snd_ticks   &= 0;
+        state.cas_ticks   &= 0;
         state.vdc_hsync   &= 0;
         state.vdc_vsync   &= 0;
         state.lnk_lk1     |= 0;
@@ -292,6 +310,13 @@ struct Traits
         video.frame_time |= 0;
     }
 
+    static auto reset(Dirty& dirty) -> void
+    {
+        for(auto& bits : dirty.bitmap) {
+            bits |= ~0ULL;
+        }
+    }
+
     static auto reset(dpy::Instance* dpy)
     {
         if(dpy != nullptr) {
@@ -354,6 +379,59 @@ struct Traits
             mem->reset();
         }
     }
+
+    template <typename Instance>
+    static auto clone(Instance* dst, Instance* src)
+    {
+        if((dst != nullptr) && (src != nullptr)) {
+            *(dst->operator->()) = *(src->operator->());
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ArenaTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ArenaTraits
+{
+    using Mainboard = cpc::Mainboard;
+
+    static constexpr uint32_t RAM_BASE    = 0;
+    static constexpr uint32_t ROM_BASE    = RAM_BASE + Mainboard::RAM_BANKS;
+    static constexpr uint32_t EXP_BASE    = ROM_BASE + Mainboard::ROM_BANKS;
+    static constexpr uint32_t BANK_COUNT  = EXP_BASE + Mainboard::EXP_BANKS;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::DirtyTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct DirtyTraits
+{
+    using Mainboard = cpc::Mainboard;
+    using Dirty     = cpc::Mainboard::Dirty;
+
+#ifdef ENABLE_DIRTY_TRACKING
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    static inline auto mark(Dirty& dirty, const uint8_t* data) -> void
+    {
+        const uint32_t page = static_cast<uint32_t>((data - dirty.ram_base) / Mainboard::DIRTY_SIZE);
+
+        dirty.bitmap[page >> 6] |= (1ULL << (page & 63));
+    }
 };
 
 }
@@ -443,6 +521,9 @@ Mainboard::Mainboard(Machine& machine)
     , _state()
     , _audio()
     , _video()
+    , _dirty()
+    , _framehash()
+    , _saver()
     , _dpy()
     , _kbd()
     , _cpu()
@@ -451,6 +532,8 @@ Mainboard::Mainboard(Machine& machine)
     , _ppi()
     , _psg()
     , _fdc()
+    , _tape()
+    , _arena(ArenaTraits::BANK_COUNT)
     , _ram()
     , _rom()
     , _exp()
@@ -462,6 +545,7 @@ Mainboard::Mainboard(Machine& machine)
     Traits::construct(_state);
     Traits::construct(_audio);
     Traits::construct(_video);
+    Traits::construct(_dirty);
     if(_dpy == nullptr) {
         _dpy = new dpy::Instance(*this);
     }
@@ -490,14 +574,20 @@ Mainboard::Mainboard(Machine& machine)
     }
     for(auto& ram : _ram) {
         if(ram == nullptr) {
-            ram = new mem::Instance(mem::RAM_BANK, *this);
+            ram = new mem::Instance(mem::RAM_BANK, *this, _arena.bank(ArenaTraits::RAM_BASE + (&ram - _ram)));
         }
     }
     for(auto& rom : _rom) {
         if(rom == nullptr) {
-            rom = new mem::Instance(mem::ROM_BANK, *this);
+            rom = new mem::Instance(mem::ROM_BANK, *this, _arena.bank(ArenaTraits::ROM_BASE + (&rom - _rom)));
         }
     }
+    /* dirty pages are tracked relatively to the first ram bank */ {
+        _dirty.ram_base = _arena.bank(ArenaTraits::RAM_BASE);
+    }
+    if(_arena.huge_pages() != false) {
+        ::xcpc_log_debug("mainboard: memory arena of %lu bytes backed by huge pages", static_cast<unsigned long>(_arena.size()));
+    }
     for(auto& exp : _exp) {
         if(exp == nullptr) {
             exp = nullptr;
@@ -533,6 +623,9 @@ Mainboard::~Mainboard()
             ram = (delete ram, nullptr);
         }
     }
+    if(_tape != nullptr) {
+        _tape = (delete _tape, nullptr);
+    }
     if(_fdc != nullptr) {
         _fdc = (delete _fdc, nullptr);
     }
@@ -557,6 +650,7 @@ Mainboard::~Mainboard()
     if(_dpy != nullptr) {
         _dpy = (delete _dpy, nullptr);
     }
+    Traits::destruct(_dirty);
     Traits::destruct(_video);
     Traits::destruct(_audio);
     Traits::destruct(_state);
@@ -585,6 +679,7 @@ auto Mainboard::reset() -> void
     Traits::reset(_state);
     Traits::reset(_audio);
     Traits::reset(_video);
+    Traits::reset(_dirty);
     Traits::reset(_dpy);
     Traits::reset(_kbd);
     Traits::reset(_cpu);
@@ -671,17 +766,100 @@ auto Mainboard::clock() -> void
             clock_snd();
         }
         _state.cpc_ticks -= _state.cpc_clock;
+        update_tape();
     };
 
     return emulate();
 }
 
-auto Mainboard::load_snapshot(const std::string& filename) -> void
+auto Mainboard::fork(const unsigned int count) -> std::vector<std::unique_ptr<Mainboard>>
 {
-    sna::Snapshot snapshot;
+    const MutexLock lock(_mutex);
+    std::vector<std::unique_ptr<Mainboard>> children;
+    mem::Image image(_arena);
+
+    auto build_image = [&]() -> void
+    {
+        for(uint32_t index = 0; index < countof(_ram); ++index) {
+            if(_ram[index] != nullptr) {
+                image.store(_arena, ArenaTraits::RAM_BASE + index);
+            }
+        }
+        for(auto* rom : _rom) {
+            if(rom != nullptr) {
+                static_cast<void>(rom->map());
+            }
+        }
+        for(auto* exp : _exp) {
+            if(exp != nullptr) {
+                static_cast<void>(exp->map());
+            }
+        }
+    };
 
+    auto fork_memory = [&](Mainboard& child) -> void
+    {
+        for(uint32_t index = 0; index < countof(_exp); ++index) {
+            if((_exp[index] != nullptr) && (child._exp[index] == nullptr)) {
+                child._exp[index] = new mem::Instance(mem::ROM_BANK, child, child._arena.bank(ArenaTraits::EXP_BASE + index));
+            }
+        }
+        child._arena.attach(image);
+        for(uint32_t index = 0; index < countof(_rom); ++index) {
+            if((_rom[index] != nullptr) && (child._rom[index] != nullptr)) {
+                child._rom[index]->share(*_rom[index]);
+            }
+        }
+        for(uint32_t index = 0; index < countof(_exp); ++index) {
+            if((_exp[index] != nullptr) && (child._exp[index] != nullptr)) {
+                child._exp[index]->share(*_exp[index]);
+            }
+        }
+    };
+
+    auto fork_state = [&](Mainboard& child) -> void
+    {
+        child._setup = _setup;
+        child._clock = _clock;
+        child._state = _state;
+        child._video = _video;
+        static_cast<void>(::memcpy(child._dirty.bitmap, _dirty.bitmap, sizeof(_dirty.bitmap)));
+        Traits::clone(child._kbd, _kbd);
+        Traits::clone(child._cpu, _cpu);
+        Traits::clone(child._vga, _vga);
+        Traits::clone(child._vdc, _vdc);
+        Traits::clone(child._ppi, _ppi);
+        Traits::clone(child._psg, _psg);
+        child.update_pal();
+    };
+
+    auto fork_child = [&]() -> void
+    {
+        std::unique_ptr<Mainboard> child(new Mainboard(_machine));
+
+        fork_memory(*child);
+        fork_state(*child);
+        children.push_back(std::move(child));
+    };
+
+    auto fork_all = [&]() -> void
+    {
+        build_image();
+        children.reserve(count);
+        for(unsigned int index = 0; index < count; ++index) {
+            fork_child();
+        }
+    };
+
+    fork_all();
+
+    return children;
+}
+
+auto Mainboard::load_snapshot(const std::string& filename) -> void
+{
     try {
-        snapshot.load(filename);
+        sna::SnapshotFile snapshot(filename);
         load_cpc(snapshot);
     }
     catch(...) {
@@ -692,16 +870,12 @@ auto Mainboard::load_snapshot(const std::string& filename) -> void
 
 auto Mainboard::save_snapshot(const std::string& filename) -> void
 {
-    sna::Snapshot snapshot;
-
-    try {
+    auto do_capture = [&](sna::Snapshot& snapshot) -> void
+    {
         save_cpc(snapshot);
-        snapshot.save(filename);
-    }
-    catch(...) {
-    //  reset();
-        throw;
-    }
+    };
+
+    _saver.submit(filename, do_capture);
 }
 
 auto Mainboard::create_disk_into_drive0(const std::string& filename) -> void
@@ -754,6 +928,84 @@ auto Mainboard::remove_disk_from_drive1() -> void
     }
 }
 
+auto Mainboard::insert_tape(const std::string& filename) -> void
+{
+    const MutexLock lock(_mutex);
+    std::unique_ptr<cdt::Tape> tape(new cdt::Tape(filename));
+
+    if(_tape != nullptr) {
+        _tape = (delete _tape, nullptr);
+    }
+    _tape = tape.release();
+    _state.cas_ticks   = (*_cpu)->t_states;
+    _state.cas_rd_data = _tape->get_level();
+}
+
+auto Mainboard::remove_tape() -> void
+{
+    const MutexLock lock(_mutex);
+
+    if(_tape != nullptr) {
+        _tape = (delete _tape, nullptr);
+    }
+    _state.cas_rd_data = 0;
+}
+
+auto Mainboard::rewind_tape() -> void
+{
+    const MutexLock lock(_mutex);
+
+    if(_tape != nullptr) {
+        _tape->rewind();
+        _state.cas_rd_data = _tape->get_level();
+    }
+}
+
+auto Mainboard::start_capture(const std::string& filename) -> void
+{
+    auto has_suffix = [&](const std::string& suffix) -> bool
+    {
+        if(filename.size() >= suffix.size()) {
+            return filename.compare((filename.size() - suffix.size()), suffix.size(), suffix) == 0;
+        }
+        return false;
+    };
+
+    auto get_format = [&]() -> int
+    {
+        if(has_suffix(".rgb") || has_suffix(".raw")) {
+            return dpy::Capture::FORMAT_RGB;
+        }
+        return dpy::Capture::FORMAT_Y4M;
+    };
+
+    if(_dpy != nullptr) {
+        _dpy->start_capture(filename, get_format(), dpy::Capture::POLICY_DROP);
+    }
+}
+
+auto Mainboard::stop_capture() -> void
+{
+    if(_dpy != nullptr) {
+        _dpy->stop_capture();
+    }
+}
+
+auto Mainboard::start_frame_hashing(const std::string& output, const std::string& golden) -> void
+{
+    if(output.size() > 0) {
+        _framehash.record(output);
+    }
+    if(golden.size() > 0) {
+        _framehash.compare(golden);
+    }
+}
+
+auto Mainboard::stop_frame_hashing() -> void
+{
+    _framehash.stop();
+}
+
 auto Mainboard::set_parameterb(const std::string& parameter, bool value) -> void
 {
     if(parameter.compare(0, 6, "video.") == 0) {
@@ -767,6 +1019,13 @@ auto Mainboard::set_parameterb(const std::string& parameter, bool value) -> void
                 update_vga();
             }
         }
+        if(parameter == "video.crt_filter") {
+            const auto old_crt_filter = _setup.crt_filter;
+            const auto new_crt_filter = _setup.crt_filter = value;
+            if(new_crt_filter != old_crt_filter) {
+                update_vga();
+            }
+        }
     }
 }
 
@@ -1098,6 +1357,14 @@ auto Mainboard::get_drive1_filename() const -> std::string
     return "";
 }
 
+auto Mainboard::get_tape_filename() const -> std::string
+{
+    if(_tape != nullptr) {
+        return _tape->get_filename();
+    }
+    return "";
+}
+
 auto Mainboard::get_system_info() const -> std::string
 {
     std::string system_info;
@@ -1131,6 +1398,46 @@ auto Mainboard::get_volume() const -> float
     return _audio.volume;
 }
 
+auto Mainboard::get_snapshot_progress() const -> SnapshotProgress
+{
+    return _saver.get_progress();
+}
+
+auto Mainboard::has_dirty_tracking() const -> bool
+{
+    return DirtyTraits::enabled;
+}
+
+auto Mainboard::mark_dirty_pages() -> void
+{
+    for(auto& bits : _dirty.bitmap) {
+        bits |= ~0ULL;
+    }
+}
+
+auto Mainboard::clear_dirty_pages() -> void
+{
+    for(auto& bits : _dirty.bitmap) {
+        bits &= 0ULL;
+    }
+}
+
+auto Mainboard::for_each_dirty_page(const DirtyPageFunc& function) const -> void
+{
+    constexpr uint32_t pages_per_bank = (mem::BANK_SIZE / DIRTY_SIZE);
+
+    uint32_t page = 0;
+    for(auto bits : _dirty.bitmap) {
+        for(uint32_t count = 64; count != 0; --count, ++page, bits >>= 1) {
+            if((bits & 1ULL) != 0) {
+                const uint32_t bank   = (page / pages_per_bank);
+                const uint32_t offset = (page % pages_per_bank) * DIRTY_SIZE;
+                function(bank, offset, _dirty.ram_base + (page * DIRTY_SIZE), DIRTY_SIZE);
+            }
+        }
+    }
+}
+
 auto Mainboard::on_reset(Event& event) -> unsigned long
 {
     /* reset the mainboard */ {
@@ -1149,6 +1456,11 @@ auto Mainboard::on_clock(Event& event) -> unsigned long
     /* clock the mainboard */ {
         clock();
     }
+    /* insert the disk images that have been inflated in the background */ {
+        if(_fdc != nullptr) {
+            _fdc->poll();
+        }
+    }
     /* compute the next deadline */ {
         if((_clock.deadline.tv_usec += frame_time) >= 1000000) {
             _clock.deadline.tv_usec -= 1000000;
@@ -1170,6 +1482,14 @@ auto Mainboard::on_clock(Event& event) -> unsigned long
             skip_frame |= 1;
         }
     }
+    /* run at full speed while the disk drive motor is on in turbo mode */ {
+        if((_fdc != nullptr) && (_fdc->has_turbo() != false)) {
+            _clock.deadline = _clock.currtime;
+            timeout    &= 0UL;
+            timedrift  &= 0UL;
+            skip_frame  = ((_stats.frame_count % TURBO_FRAMES) != 0 ? 1 : 0);
+        }
+    }
     /* always force the first frame and skip frames if needed in speedup mode */ {
         if(_stats.frame_count == 0) {
             skip_frame &= 0;
@@ -1178,12 +1498,24 @@ auto Mainboard::on_clock(Event& event) -> unsigned long
             skip_frame |= 1;
         }
     }
+    /* hash the frame and pause on the first golden mismatch */ {
+        if(_framehash.is_enabled()) {
+            if(_framehash.update(hash_frame()) == false) {
+                pause();
+            }
+        }
+    }
     /* draw the frame if needed */ {
         if(skip_frame == 0) {
             (*_funcs.render_func)(this);
             ++_stats.frame_drawn;
         }
     }
+    /* report the startup profile once the first frame has been drawn */ {
+        if(_stats.frame_count == 0) {
+            StartupProfile::report("first frame");
+        }
+    }
     /* compute stats */ {
         if(++_stats.frame_count == _video.frame_rate) {
             update_stats();
@@ -1291,6 +1623,7 @@ auto Mainboard::on_create_window(Event& event) -> unsigned long
     /* realize display with renderer */ {
         _dpy->realize(_setup.renderer_type, x11_event->xany.display, x11_event->xany.window, _setup.xshm);
         _dpy->set_parameterb("video.crt_emulation", _setup.crt_emulation);
+        _dpy->set_parameterb("video.crt_filter", _setup.crt_filter);
     }
     /* update gate-array */ {
         update_vga();
@@ -1324,7 +1657,12 @@ auto Mainboard::on_expose_window(Event& event) -> unsigned long
     XEvent* x11_event = event.u.expose_window.x11_event;
 
     if((_dpy != nullptr) && (x11_event != nullptr)) {
-        _dpy->expose(x11_event->xexpose);
+        if(x11_event->type == Expose) {
+            _dpy->expose(x11_event->xexpose);
+        }
+        else {
+            _dpy->notify(*x11_event);
+        }
     }
     return 0UL;
 }
@@ -1416,7 +1754,12 @@ auto Mainboard::configure(const Settings& settings) -> void
         _setup.speedup       = clamp_int(::atoi(settings.opt_speedup.c_str()), 1, 100);
         _setup.xshm          = settings.opt_xshm;
         _setup.crt_emulation = settings.opt_crt_emulation;
+        _setup.crt_filter    = settings.opt_crt_filter;
+        _setup.turbo_disk    = settings.opt_turbo_disk;
         _state.snd_clock     = _device->sampleRate;
+        if(_fdc != nullptr) {
+            _fdc->set_turbo(_setup.turbo_disk);
+        }
     };
 
     auto load_system_roms = [&]() -> void
@@ -1530,16 +1873,62 @@ auto Mainboard::configure(const Settings& settings) -> void
         }
     };
 
+    auto load_initial_tape = [&]() -> void
+    {
+        try {
+            if(is_set(settings.opt_tape)) {
+                _machine.insert_tape(settings.opt_tape);
+            }
+        }
+        catch(const std::exception& e) {
+            ::xcpc_log_error("error while loading initial tape: %s", e.what());
+        }
+    };
+
+    auto start_initial_capture = [&]() -> void
+    {
+        try {
+            if(is_set(settings.opt_capture)) {
+                start_capture(settings.opt_capture);
+            }
+        }
+        catch(const std::exception& e) {
+            ::xcpc_log_error("error while starting initial capture: %s", e.what());
+        }
+    };
+
+    auto start_initial_frame_hashing = [&]() -> void
+    {
+        try {
+            const std::string output(is_set(settings.opt_hash_out) ? settings.opt_hash_out : "");
+            const std::string golden(is_set(settings.opt_hash_ref) ? settings.opt_hash_ref : "");
+            start_frame_hashing(output, golden);
+        }
+        catch(const std::exception& e) {
+            ::xcpc_log_error("error while starting initial frame hashing: %s", e.what());
+        }
+    };
+
     auto initialize = [&]() -> void
     {
         try {
             init_machine();
+            StartupProfile::mark("mainboard: init machine");
             load_system_roms();
             load_expansions_roms();
+            StartupProfile::mark("mainboard: register roms");
             reset();
+            StartupProfile::mark("mainboard: reset");
             load_initial_snapshot();
+            StartupProfile::mark("mainboard: load snapshot");
             load_initial_drive0();
             load_initial_drive1();
+            StartupProfile::mark("mainboard: insert disks");
+            load_initial_tape();
+            StartupProfile::mark("mainboard: insert tape");
+            start_initial_capture();
+            start_initial_frame_hashing();
+            StartupProfile::mark("mainboard: start capture");
         }
         catch(const std::exception& e) {
             reset();
@@ -1556,7 +1945,7 @@ auto Mainboard::load_lower_rom(const std::string& filename) -> void
     auto*         rom   = _rom[index];
 
     if(rom == nullptr) {
-        rom = _rom[index] = new mem::Instance(mem::ROM_BANK, *this);
+        rom = _rom[index] = new mem::Instance(mem::ROM_BANK, *this, _arena.bank(ArenaTraits::ROM_BASE + index));
     }
     if(rom != nullptr) {
         std::string path(filename);
@@ -1573,7 +1962,7 @@ auto Mainboard::load_upper_rom(const std::string& filename) -> void
     auto*         rom   = _rom[index];
 
     if(rom == nullptr) {
-        rom = _rom[index] = new mem::Instance(mem::ROM_BANK, *this);
+        rom = _rom[index] = new mem::Instance(mem::ROM_BANK, *this, _arena.bank(ArenaTraits::ROM_BASE + index));
     }
     if(rom != nullptr) {
         std::string path(filename);
@@ -1589,7 +1978,7 @@ auto Mainboard::load_expansion(const std::string& filename, const int index) ->
     auto* rom = _exp[index];
 
     if(rom == nullptr) {
-        rom = _exp[index] = new mem::Instance(mem::ROM_BANK, *this);
+        rom = _exp[index] = new mem::Instance(mem::ROM_BANK, *this, _arena.bank(ArenaTraits::EXP_BASE + index));
     }
     if(rom != nullptr) {
         std::string path(filename);
@@ -1600,8 +1989,10 @@ auto Mainboard::load_expansion(const std::string& filename, const int index) ->
     }
 }
 
-auto Mainboard::load_cpc(sna::Snapshot& snapshot) -> void
+auto Mainboard::load_cpc(sna::SnapshotFile& snapshot) -> void
 {
+    const sna::Header& header(snapshot.header());
+
     auto set_vdc = [&](const uint8_t index, const uint8_t value) -> void
     {
         auto& vdc(*_vdc);
@@ -1632,153 +2023,162 @@ auto Mainboard::load_cpc(sna::Snapshot& snapshot) -> void
     {
         auto& cpu(*_cpu);
 
-        cpu.set_af_l(snapshot->header.cpu_p_af_l);
-        cpu.set_af_h(snapshot->header.cpu_p_af_h);
-        cpu.set_bc_l(snapshot->header.cpu_p_bc_l);
-        cpu.set_bc_h(snapshot->header.cpu_p_bc_h);
-        cpu.set_de_l(snapshot->header.cpu_p_de_l);
-        cpu.set_de_h(snapshot->header.cpu_p_de_h);
-        cpu.set_hl_l(snapshot->header.cpu_p_hl_l);
-        cpu.set_hl_h(snapshot->header.cpu_p_hl_h);
-        cpu.set_ir_l(snapshot->header.cpu_p_ir_l);
-        cpu.set_ir_h(snapshot->header.cpu_p_ir_h);
-        cpu.set_iff1(snapshot->header.cpu_p_iff1);
-        cpu.set_iff2(snapshot->header.cpu_p_iff2);
-        cpu.set_ix_l(snapshot->header.cpu_p_ix_l);
-        cpu.set_ix_h(snapshot->header.cpu_p_ix_h);
-        cpu.set_iy_l(snapshot->header.cpu_p_iy_l);
-        cpu.set_iy_h(snapshot->header.cpu_p_iy_h);
-        cpu.set_sp_l(snapshot->header.cpu_p_sp_l);
-        cpu.set_sp_h(snapshot->header.cpu_p_sp_h);
-        cpu.set_pc_l(snapshot->header.cpu_p_pc_l);
-        cpu.set_pc_h(snapshot->header.cpu_p_pc_h);
-        cpu.set_im_l(snapshot->header.cpu_p_im_l);
-        cpu.set_af_y(snapshot->header.cpu_a_af_l);
-        cpu.set_af_x(snapshot->header.cpu_a_af_h);
-        cpu.set_bc_y(snapshot->header.cpu_a_bc_l);
-        cpu.set_bc_x(snapshot->header.cpu_a_bc_h);
-        cpu.set_de_y(snapshot->header.cpu_a_de_l);
-        cpu.set_de_x(snapshot->header.cpu_a_de_h);
-        cpu.set_hl_y(snapshot->header.cpu_a_hl_l);
-        cpu.set_hl_x(snapshot->header.cpu_a_hl_h);
+        cpu.set_af_l(header.cpu_p_af_l);
+        cpu.set_af_h(header.cpu_p_af_h);
+        cpu.set_bc_l(header.cpu_p_bc_l);
+        cpu.set_bc_h(header.cpu_p_bc_h);
+        cpu.set_de_l(header.cpu_p_de_l);
+        cpu.set_de_h(header.cpu_p_de_h);
+        cpu.set_hl_l(header.cpu_p_hl_l);
+        cpu.set_hl_h(header.cpu_p_hl_h);
+        cpu.set_ir_l(header.cpu_p_ir_l);
+        cpu.set_ir_h(header.cpu_p_ir_h);
+        cpu.set_iff1(header.cpu_p_iff1);
+        cpu.set_iff2(header.cpu_p_iff2);
+        cpu.set_ix_l(header.cpu_p_ix_l);
+        cpu.set_ix_h(header.cpu_p_ix_h);
+        cpu.set_iy_l(header.cpu_p_iy_l);
+        cpu.set_iy_h(header.cpu_p_iy_h);
+        cpu.set_sp_l(header.cpu_p_sp_l);
+        cpu.set_sp_h(header.cpu_p_sp_h);
+        cpu.set_pc_l(header.cpu_p_pc_l);
+        cpu.set_pc_h(header.cpu_p_pc_h);
+        cpu.set_im_l(header.cpu_p_im_l);
+        cpu.set_af_y(header.cpu_a_af_l);
+        cpu.set_af_x(header.cpu_a_af_h);
+        cpu.set_bc_y(header.cpu_a_bc_l);
+        cpu.set_bc_x(header.cpu_a_bc_h);
+        cpu.set_de_y(header.cpu_a_de_l);
+        cpu.set_de_x(header.cpu_a_de_h);
+        cpu.set_hl_y(header.cpu_a_hl_l);
+        cpu.set_hl_x(header.cpu_a_hl_h);
     };
 
     auto load_vga = [&]() -> void
     {
         auto& vga(*_vga);
 
-        vga->pen       = snapshot->header.vga_ink_ix;
-        vga->ink[0x00] = snapshot->header.vga_ink_00;
-        vga->ink[0x01] = snapshot->header.vga_ink_01;
-        vga->ink[0x02] = snapshot->header.vga_ink_02;
-        vga->ink[0x03] = snapshot->header.vga_ink_03;
-        vga->ink[0x04] = snapshot->header.vga_ink_04;
-        vga->ink[0x05] = snapshot->header.vga_ink_05;
-        vga->ink[0x06] = snapshot->header.vga_ink_06;
-        vga->ink[0x07] = snapshot->header.vga_ink_07;
-        vga->ink[0x08] = snapshot->header.vga_ink_08;
-        vga->ink[0x09] = snapshot->header.vga_ink_09;
-        vga->ink[0x0a] = snapshot->header.vga_ink_10;
-        vga->ink[0x0b] = snapshot->header.vga_ink_11;
-        vga->ink[0x0c] = snapshot->header.vga_ink_12;
-        vga->ink[0x0d] = snapshot->header.vga_ink_13;
-        vga->ink[0x0e] = snapshot->header.vga_ink_14;
-        vga->ink[0x0f] = snapshot->header.vga_ink_15;
-        vga->ink[0x10] = snapshot->header.vga_ink_16;
-        vga->rmr       = snapshot->header.vga_config;
+        vga->pen       = header.vga_ink_ix;
+        vga->ink[0x00] = header.vga_ink_00;
+        vga->ink[0x01] = header.vga_ink_01;
+        vga->ink[0x02] = header.vga_ink_02;
+        vga->ink[0x03] = header.vga_ink_03;
+        vga->ink[0x04] = header.vga_ink_04;
+        vga->ink[0x05] = header.vga_ink_05;
+        vga->ink[0x06] = header.vga_ink_06;
+        vga->ink[0x07] = header.vga_ink_07;
+        vga->ink[0x08] = header.vga_ink_08;
+        vga->ink[0x09] = header.vga_ink_09;
+        vga->ink[0x0a] = header.vga_ink_10;
+        vga->ink[0x0b] = header.vga_ink_11;
+        vga->ink[0x0c] = header.vga_ink_12;
+        vga->ink[0x0d] = header.vga_ink_13;
+        vga->ink[0x0e] = header.vga_ink_14;
+        vga->ink[0x0f] = header.vga_ink_15;
+        vga->ink[0x10] = header.vga_ink_16;
+        vga->rmr       = header.vga_config;
+        vga.invalidate();
     };
 
     auto load_vdc = [&]() -> void
     {
-        set_vdc(0x00, snapshot->header.vdc_reg_00);
-        set_vdc(0x01, snapshot->header.vdc_reg_01);
-        set_vdc(0x02, snapshot->header.vdc_reg_02);
-        set_vdc(0x03, snapshot->header.vdc_reg_03);
-        set_vdc(0x04, snapshot->header.vdc_reg_04);
-        set_vdc(0x05, snapshot->header.vdc_reg_05);
-        set_vdc(0x06, snapshot->header.vdc_reg_06);
-        set_vdc(0x07, snapshot->header.vdc_reg_07);
-        set_vdc(0x08, snapshot->header.vdc_reg_08);
-        set_vdc(0x09, snapshot->header.vdc_reg_09);
-        set_vdc(0x0a, snapshot->header.vdc_reg_10);
-        set_vdc(0x0b, snapshot->header.vdc_reg_11);
-        set_vdc(0x0c, snapshot->header.vdc_reg_12);
-        set_vdc(0x0d, snapshot->header.vdc_reg_13);
-        set_vdc(0x0e, snapshot->header.vdc_reg_14);
-        set_vdc(0x0f, snapshot->header.vdc_reg_15);
-        set_vdc(0x10, snapshot->header.vdc_reg_16);
-        set_vdc(0x11, snapshot->header.vdc_reg_17);
-        set_vdc(0xff, snapshot->header.vdc_reg_ix);
+        set_vdc(0x00, header.vdc_reg_00);
+        set_vdc(0x01, header.vdc_reg_01);
+        set_vdc(0x02, header.vdc_reg_02);
+        set_vdc(0x03, header.vdc_reg_03);
+        set_vdc(0x04, header.vdc_reg_04);
+        set_vdc(0x05, header.vdc_reg_05);
+        set_vdc(0x06, header.vdc_reg_06);
+        set_vdc(0x07, header.vdc_reg_07);
+        set_vdc(0x08, header.vdc_reg_08);
+        set_vdc(0x09, header.vdc_reg_09);
+        set_vdc(0x0a, header.vdc_reg_10);
+        set_vdc(0x0b, header.vdc_reg_11);
+        set_vdc(0x0c, header.vdc_reg_12);
+        set_vdc(0x0d, header.vdc_reg_13);
+        set_vdc(0x0e, header.vdc_reg_14);
+        set_vdc(0x0f, header.vdc_reg_15);
+        set_vdc(0x10, header.vdc_reg_16);
+        set_vdc(0x11, header.vdc_reg_17);
+        set_vdc(0xff, header.vdc_reg_ix);
     };
 
     auto load_ppi = [&]() -> void
     {
         auto& ppi(*_ppi);
 
-        ppi.wr_port_a(snapshot->header.ppi_port_a);
-        ppi.wr_port_b(snapshot->header.ppi_port_b);
-        ppi.wr_port_c(snapshot->header.ppi_port_c);
-        ppi.wr_ctrl_p(snapshot->header.ppi_ctrl_p);
+        ppi.wr_port_a(header.ppi_port_a);
+        ppi.wr_port_b(header.ppi_port_b);
+        ppi.wr_port_c(header.ppi_port_c);
+        ppi.wr_ctrl_p(header.ppi_ctrl_p);
     };
 
     auto load_psg = [&]() -> void
     {
-        set_psg(0x00, snapshot->header.psg_reg_00);
-        set_psg(0x01, snapshot->header.psg_reg_01);
-        set_psg(0x02, snapshot->header.psg_reg_02);
-        set_psg(0x03, snapshot->header.psg_reg_03);
-        set_psg(0x04, snapshot->header.psg_reg_04);
-        set_psg(0x05, snapshot->header.psg_reg_05);
-        set_psg(0x06, snapshot->header.psg_reg_06);
-        set_psg(0x07, snapshot->header.psg_reg_07);
-        set_psg(0x08, snapshot->header.psg_reg_08);
-        set_psg(0x09, snapshot->header.psg_reg_09);
-        set_psg(0x0a, snapshot->header.psg_reg_10);
-        set_psg(0x0b, snapshot->header.psg_reg_11);
-        set_psg(0x0c, snapshot->header.psg_reg_12);
-        set_psg(0x0d, snapshot->header.psg_reg_13);
-        set_psg(0x0e, snapshot->header.psg_reg_14);
-        set_psg(0x0f, snapshot->header.psg_reg_15);
-        set_psg(0xff, snapshot->header.psg_reg_ix);
+        set_psg(0x00, header.psg_reg_00);
+        set_psg(0x01, header.psg_reg_01);
+        set_psg(0x02, header.psg_reg_02);
+        set_psg(0x03, header.psg_reg_03);
+        set_psg(0x04, header.psg_reg_04);
+        set_psg(0x05, header.psg_reg_05);
+        set_psg(0x06, header.psg_reg_06);
+        set_psg(0x07, header.psg_reg_07);
+        set_psg(0x08, header.psg_reg_08);
+        set_psg(0x09, header.psg_reg_09);
+        set_psg(0x0a, header.psg_reg_10);
+        set_psg(0x0b, header.psg_reg_11);
+        set_psg(0x0c, header.psg_reg_12);
+        set_psg(0x0d, header.psg_reg_13);
+        set_psg(0x0e, header.psg_reg_14);
+        set_psg(0x0f, header.psg_reg_15);
+        set_psg(0xff, header.psg_reg_ix);
     };
 
     auto load_ram = [&]() -> void
     {
-        _state.ram_conf = snapshot->header.ram_select;
+        _state.ram_conf = header.ram_select;
     };
 
     auto load_rom = [&]() -> void
     {
-        _state.rom_conf = snapshot->header.rom_select;
+        _state.rom_conf = header.rom_select;
     };
 
     auto load_mem = [&]() -> void
     {
-        size_t ram_size = 0;
-        ram_size |= ((static_cast<uint32_t>(snapshot->header.ram_size_h)) << 18);
-        ram_size |= ((static_cast<uint32_t>(snapshot->header.ram_size_l)) << 10);
+        size_t ram_size = snapshot.ram_size();
         if(ram_size > static_cast<uint32_t>(_setup.memory_size)) {
             ram_size = static_cast<uint32_t>(_setup.memory_size);
         }
-        uint32_t bank_index = 0;
-        uint32_t bank_count = countof(_ram);
-        for(auto& memory : snapshot->memory) {
-            constexpr size_t memory_size = sizeof(memory.data);
-            if((ram_size != 0) && (bank_index < bank_count)) {
-                auto* bank = _ram[bank_index];
-                if(bank != nullptr) {
-                    bank->store(memory.data, memory_size);
-                }
-                ram_size -= memory_size;
-            }
-            else {
-                break;
-            }
-            ++bank_index;
+        if(ram_size > (countof(_ram) * mem::BANK_SIZE)) {
+            ram_size = (countof(_ram) * mem::BANK_SIZE);
         }
+        snapshot.load(_arena.bank(ArenaTraits::RAM_BASE), ram_size);
         update_pal();
     };
 
+    auto load_ext = [&]() -> void
+    {
+        auto& vga(*_vga);
+        auto& vdc(*_vdc);
+
+        if(header.version < 3) {
+            return;
+        }
+        vdc->core.hcc          = header.vdc_hcc;
+        vdc->core.vcc          = header.vdc_vcc;
+        vdc->core.slc          = header.vdc_slc;
+        vdc->core.vac          = header.vdc_vac;
+        vdc->core.hsc          = header.vdc_hsc;
+        vdc->core.vsc          = header.vdc_vsc;
+        vdc->core.vsync_signal = ((header.vdc_flags_l & 0x01) != 0 ? 1 : 0);
+        vdc->core.hsync_signal = ((header.vdc_flags_l & 0x02) != 0 ? 1 : 0);
+        vga->r02               = header.vga_vsync_delay;
+        vga->r52               = header.vga_int_counter;
+        _state.vdc_vsync       = vdc->core.vsync_signal;
+        _state.vdc_hsync       = vdc->core.hsync_signal;
+    };
+
     auto load_all = [&]() -> void
     {
         reset();
@@ -1790,6 +2190,7 @@ auto Mainboard::load_cpc(sna::Snapshot& snapshot) -> void
         load_ram();
         load_rom();
         load_mem();
+        load_ext();
     };
 
     return load_all();
@@ -1930,22 +2331,44 @@ auto Mainboard::save_cpc(sna::Snapshot& snapshot) -> void
         size_t ram_size = static_cast<uint32_t>(_setup.memory_size);
         snapshot->header.ram_size_h = (ram_size >> 18);
         snapshot->header.ram_size_l = (ram_size >> 10);
-        uint32_t bank_index = 0;
-        uint32_t bank_count = countof(_ram);
-        for(auto& memory : snapshot->memory) {
-            constexpr size_t memory_size = sizeof(memory.data);
-            if((ram_size != 0) && (bank_index < bank_count)) {
-                auto* bank = _ram[bank_index];
-                if(bank != nullptr) {
-                    bank->fetch(memory.data, memory_size);
-                }
-                ram_size -= memory_size;
-            }
-            else {
-                break;
-            }
-            ++bank_index;
+        if(ram_size > (countof(_ram) * mem::BANK_SIZE)) {
+            ram_size = (countof(_ram) * mem::BANK_SIZE);
         }
+        static_cast<void>(::memcpy(snapshot->memory, _arena.bank(ArenaTraits::RAM_BASE), ram_size));
+    };
+
+    auto save_ext = [&]() -> void
+    {
+        auto& vga(*_vga);
+        auto& vdc(*_vdc);
+
+        auto cpc_type = [&]() -> uint8_t
+        {
+            switch(_setup.machine_type) {
+                case XCPC_MACHINE_TYPE_CPC464:
+                    return 0;
+                case XCPC_MACHINE_TYPE_CPC664:
+                    return 1;
+                default:
+                    break;
+            }
+            return 2;
+        };
+
+        snapshot->header.version         = 3;
+        snapshot->header.cpc_type        = cpc_type();
+        snapshot->header.vdc_type        = 0;
+        snapshot->header.vdc_hcc         = vdc->core.hcc;
+        snapshot->header.vdc_vcc         = vdc->core.vcc;
+        snapshot->header.vdc_slc         = vdc->core.slc;
+        snapshot->header.vdc_vac         = vdc->core.vac;
+        snapshot->header.vdc_hsc         = vdc->core.hsc;
+        snapshot->header.vdc_vsc         = vdc->core.vsc;
+        snapshot->header.vdc_flags_l     = ((vdc->core.vsync_signal != 0 ? 0x01 : 0x00)
+                                         |  (vdc->core.hsync_signal != 0 ? 0x02 : 0x00));
+        snapshot->header.vdc_flags_h     = 0;
+        snapshot->header.vga_vsync_delay = vga->r02;
+        snapshot->header.vga_int_counter = vga->r52;
     };
 
     auto save_all = [&]() -> void
@@ -1958,6 +2381,7 @@ auto Mainboard::save_cpc(sna::Snapshot& snapshot) -> void
         save_ram();
         save_rom();
         save_mem();
+        save_ext();
     };
 
     return save_all();
@@ -1980,10 +2404,11 @@ auto Mainboard::update_vga() -> void
             ++index;
         }
     }
-    /* copy palette1 to gate-array */ {
+    /* copy palette1 to gate-array, unless the renderer draws its own scanlines */ {
+        const bool   scanlines = ((_setup.crt_emulation != false) && (dpy.has_scanlines() == false));
         unsigned int index = 0;
         for(auto& pixel : vga->colormap.pixel1) {
-            if(_setup.crt_emulation != false) {
+            if(scanlines != false) {
                 pixel = dpy->palette1[index];
             }
             else {
@@ -1996,6 +2421,17 @@ auto Mainboard::update_vga() -> void
 
 auto Mainboard::update_pal() -> void
 {
+    auto map_rom = [&](mem::Instance& rom) -> uint8_t*
+    {
+        try {
+            return rom.map();
+        }
+        catch(const std::exception& e) {
+            ::xcpc_log_error("error while loading rom: %s", e.what());
+        }
+        return rom->data;
+    };
+
     if(_setup.memory_size >= XCPC_MEMORY_SIZE_128K) {
         switch(_state.ram_conf & 0x3f) {
             case 0x00:
@@ -2075,15 +2511,15 @@ auto Mainboard::update_pal() -> void
     }
     if(((*_vga)->rmr & 0x04) == 0) {
         if(_rom[0] != nullptr) {
-            _state.pal_rd[0] = (*_rom[0])->data;
+            _state.pal_rd[0] = map_rom(*_rom[0]);
         }
     }
     if(((*_vga)->rmr & 0x08) == 0) {
         if(_rom[1] != nullptr) {
-            _state.pal_rd[3] = (*_rom[1])->data;
+            _state.pal_rd[3] = map_rom(*_rom[1]);
         }
         if(_exp[_state.rom_conf] != nullptr) {
-            _state.pal_rd[3] = (*_exp[_state.rom_conf])->data;
+            _state.pal_rd[3] = map_rom(*_exp[_state.rom_conf]);
         }
     }
 }
@@ -2109,8 +2545,15 @@ auto Mainboard::update_stats() -> void
         const float stats_frames  = static_cast<float>(_stats.frame_drawn * 1000000UL);
         const float stats_elapsed = static_cast<float>(elapsed_us);
         const float stats_fps     = ::rintf(stats_frames / stats_elapsed);
-        const int rc = ::snprintf(_stats.buffer, sizeof(_stats.buffer), "%d fps", static_cast<int>(stats_fps));
-        static_cast<void>(rc);
+        const float stats_upscale = (_dpy != nullptr ? _dpy->collect_upscale_cost() : 0.0f);
+        if(stats_upscale > 0.0f) {
+            const int rc = ::snprintf(_stats.buffer, sizeof(_stats.buffer), "%d fps, upscaler %.2f ms", static_cast<int>(stats_fps), stats_upscale);
+            static_cast<void>(rc);
+        }
+        else {
+            const int rc = ::snprintf(_stats.buffer, sizeof(_stats.buffer), "%d fps", static_cast<int>(stats_fps));
+            static_cast<void>(rc);
+        }
     }
     /* set the new reference */ {
         _clock.proftime = _clock.currtime;
@@ -2119,11 +2562,118 @@ auto Mainboard::update_stats() -> void
     }
 }
 
+auto Mainboard::update_tape() -> void
+{
+    auto& cpu(*_cpu);
+    const uint32_t now     = cpu->t_states;
+    const uint32_t elapsed = (now - _state.cas_ticks);
+
+    _state.cas_ticks = now;
+    if((_tape == nullptr) || (_state.cas_motor == 0)) {
+        return;
+    }
+    try {
+        _state.cas_rd_data = _tape->advance(elapsed);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("error while reading tape: %s", e.what());
+        _tape = (delete _tape, nullptr);
+        _state.cas_rd_data = 0;
+    }
+}
+
+auto Mainboard::hash_frame() -> uint32_t
+{
+    auto& vdc(*_vdc);
+    auto& vga(*_vga);
+    const uint16_t*       scanline = &vga->scanline[0];
+    const uint16_t* const lastline = &vga->scanline[countof(vga->scanline)];
+    const uint8_t* const ram[4] = {
+        (*_ram[0])->data,
+        (*_ram[1])->data,
+        (*_ram[2])->data,
+        (*_ram[3])->data,
+    };
+    const HorzProps h = {
+        /* cw  : pixels */ (16),
+        /* ht  : chars  */ (1 + (vdc->regs.named.horizontal_total     < 63 ? vdc->regs.named.horizontal_total     : 63)),
+        /* hd  : chars  */ (0 + (vdc->regs.named.horizontal_displayed < 52 ? vdc->regs.named.horizontal_displayed : 52)),
+        /* hsp : chars  */ (0 + (vdc->regs.named.horizontal_sync_position)),
+        /* hsw : pixels */ (0 + ((vdc->regs.named.sync_width >> 0) & 0x0f)),
+    };
+    const VertProps v = {
+        /* ch  : pixels */ (1 + (vdc->regs.named.maximum_scanline_address)),
+        /* vt  : chars  */ (1 + (vdc->regs.named.vertical_total     < 40 ? vdc->regs.named.vertical_total     : 40)),
+        /* vd  : chars  */ (0 + (vdc->regs.named.vertical_displayed < 40 ? vdc->regs.named.vertical_displayed : 40)),
+        /* vsp : chars  */ (0 + (vdc->regs.named.vertical_sync_position)),
+        /* vsw : pixels */ (0 + ((vdc->regs.named.sync_width >> 4) & 0x0f)),
+    };
+    const Borders b = {
+        /* top : pixels */ ((v.vt - v.vsp) * v.ch) + vdc->regs.named.vertical_total_adjust,
+        /* bot : pixels */ ((v.vsp - v.vd) * v.ch),
+        /* lft : pixels */ ((h.ht - h.hsp) * h.cw),
+        /* rgt : pixels */ ((h.hsp - h.hd) * h.cw),
+    };
+    unsigned int address = ((vdc->regs.named.start_address_high << 8) | (vdc->regs.named.start_address_low  << 0));
+    uint32_t     hash    = 0;
+    uint8_t      bytes[128];
+
+    auto hash_bytes = [&](const uint8_t* data, const size_t size) -> void
+    {
+        hash = FrameHash::crc32c(hash, data, size);
+    };
+
+    auto hash_palette = [&]() -> void
+    {
+        if(scanline < lastline) {
+            const vga::Palette& palette(vga->palette[*scanline++]);
+            hash_bytes(&palette.mode, sizeof(palette.mode));
+            hash_bytes(palette.ink, sizeof(palette.ink));
+        }
+    };
+
+    /* crtc registers */ {
+        hash_bytes(vdc->regs.array.data, sizeof(vdc->regs.array.data));
+    }
+    /* vertical top border */ {
+        for(int row = 0; row < b.top; ++row) {
+            hash_palette();
+        }
+    }
+    /* vertical active display, the video ram is fetched exactly as the renderers do */ {
+        const int cols = (h.hd < h.hsp ? h.hd : h.hsp);
+        for(int row = 0; row < v.vd; ++row) {
+            for(int ras = 0; ras < v.ch; ++ras) {
+                uint8_t* bytes_iter = bytes;
+                for(int col = 0; col < cols; ++col) {
+                    const uint16_t addr = ((address & 0x3000) << 2) | ((ras & 0x0007) << 11) | (((address + col) & 0x03ff) << 1);
+                    const uint16_t bank = ((addr >> 14) & 0x0003);
+                    const uint16_t disp = ((addr >>  0) & 0x3fff);
+                    *bytes_iter++ = ram[bank][disp | 0];
+                    *bytes_iter++ = ram[bank][disp | 1];
+                }
+                hash_palette();
+                hash_bytes(bytes, (bytes_iter - bytes));
+            }
+            address += h.hd;
+        }
+    }
+    /* vertical bottom border */ {
+        for(int row = 0; row < b.bot; ++row) {
+            hash_palette();
+        }
+    }
+    return hash;
+}
+
 auto Mainboard::render_08bpp() -> void
 {
     auto& vdc(*_vdc);
     auto& vga(*_vga);
-    auto* scanline = &vga->scanline[0];
+    const uint16_t*       scanline = &vga->scanline[0];
+    const vga::Palette*   palette  = &vga->palette[*scanline];
+    const uint32_t* const colors0  = vga->colormap.pixel0;
+    const uint32_t* const colors1  = vga->colormap.pixel1;
     const uint8_t* const mode0 = vga->mode0;
     const uint8_t* const mode1 = vga->mode1;
     const uint8_t* const mode2 = vga->mode2;
@@ -2170,12 +2720,13 @@ auto Mainboard::render_08bpp() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_BYTE_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_BYTE_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel1;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors1[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -2197,6 +2748,7 @@ auto Mainboard::render_08bpp() -> void
         for(int row = 0; row < rows; ++row) {
             for(int ras = 0; ras < rass; ++ras) {
                 if(remaining_lines >= 2) {
+                    palette   = &vga->palette[*scanline];
                     curr_line = data_iter;
                     data_iter = XCPC_BYTE_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                     next_line = data_iter;
@@ -2207,15 +2759,15 @@ auto Mainboard::render_08bpp() -> void
                     break;
                 }
                 /* horizontal left border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel1;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors1[palette->ink[16]];
                     for(int col = 0; col < lfts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
                     }
                 }
                 /* horizontal active display */ {
-                    switch(scanline->mode) {
+                    switch(palette->mode) {
                         case 0x00: /* mode 0 */
                             {
                                 for(int col = 0; col < cols; ++col) {
@@ -2228,15 +2780,15 @@ auto Mainboard::render_08bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -2245,15 +2797,15 @@ auto Mainboard::render_08bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -2274,29 +2826,29 @@ auto Mainboard::render_08bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -2305,29 +2857,29 @@ auto Mainboard::render_08bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -2348,57 +2900,57 @@ auto Mainboard::render_08bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -2407,57 +2959,57 @@ auto Mainboard::render_08bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -2467,13 +3019,13 @@ auto Mainboard::render_08bpp() -> void
                             }
                             break;
                         default:
-                            ::xcpc_log_alert("mode %d is not supported", scanline->mode);
+                            ::xcpc_log_alert("mode %d is not supported", palette->mode);
                             break;
                     }
                 }
                 /* horizontal right border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel1;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors1[palette->ink[16]];
                     for(int col = 0; col < rgts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
@@ -2489,12 +3041,13 @@ auto Mainboard::render_08bpp() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_BYTE_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_BYTE_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel1;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors1[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -2516,7 +3069,10 @@ auto Mainboard::render_16bpp() -> void
 {
     auto& vdc(*_vdc);
     auto& vga(*_vga);
-    auto* scanline = &vga->scanline[0];
+    const uint16_t*       scanline = &vga->scanline[0];
+    const vga::Palette*   palette  = &vga->palette[*scanline];
+    const uint32_t* const colors0  = vga->colormap.pixel0;
+    const uint32_t* const colors1  = vga->colormap.pixel1;
     const uint8_t* const mode0 = vga->mode0;
     const uint8_t* const mode1 = vga->mode1;
     const uint8_t* const mode2 = vga->mode2;
@@ -2563,12 +3119,13 @@ auto Mainboard::render_16bpp() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_WORD_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_WORD_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel1;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors1[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -2590,6 +3147,7 @@ auto Mainboard::render_16bpp() -> void
         for(int row = 0; row < rows; ++row) {
             for(int ras = 0; ras < rass; ++ras) {
                 if(remaining_lines >= 2) {
+                    palette   = &vga->palette[*scanline];
                     curr_line = data_iter;
                     data_iter = XCPC_WORD_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                     next_line = data_iter;
@@ -2600,15 +3158,15 @@ auto Mainboard::render_16bpp() -> void
                     break;
                 }
                 /* horizontal left border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel1;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors1[palette->ink[16]];
                     for(int col = 0; col < lfts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
                     }
                 }
                 /* horizontal active display */ {
-                    switch(scanline->mode) {
+                    switch(palette->mode) {
                         case 0x00: /* mode 0 */
                             {
                                 for(int col = 0; col < cols; ++col) {
@@ -2621,15 +3179,15 @@ auto Mainboard::render_16bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -2638,15 +3196,15 @@ auto Mainboard::render_16bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -2667,29 +3225,29 @@ auto Mainboard::render_16bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -2698,29 +3256,29 @@ auto Mainboard::render_16bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -2741,57 +3299,57 @@ auto Mainboard::render_16bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -2800,57 +3358,57 @@ auto Mainboard::render_16bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -2860,13 +3418,13 @@ auto Mainboard::render_16bpp() -> void
                             }
                             break;
                         default:
-                            ::xcpc_log_alert("mode %d is not supported", scanline->mode);
+                            ::xcpc_log_alert("mode %d is not supported", palette->mode);
                             break;
                     }
                 }
                 /* horizontal right border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel1;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors1[palette->ink[16]];
                     for(int col = 0; col < rgts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
@@ -2882,12 +3440,13 @@ auto Mainboard::render_16bpp() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_WORD_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_WORD_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel1;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors1[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -2909,7 +3468,10 @@ auto Mainboard::render_32bpp() -> void
 {
     auto& vdc(*_vdc);
     auto& vga(*_vga);
-    auto* scanline = &vga->scanline[0];
+    const uint16_t*       scanline = &vga->scanline[0];
+    const vga::Palette*   palette  = &vga->palette[*scanline];
+    const uint32_t* const colors0  = vga->colormap.pixel0;
+    const uint32_t* const colors1  = vga->colormap.pixel1;
     const uint8_t* const mode0 = vga->mode0;
     const uint8_t* const mode1 = vga->mode1;
     const uint8_t* const mode2 = vga->mode2;
@@ -2956,12 +3518,13 @@ auto Mainboard::render_32bpp() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel1;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors1[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -2983,6 +3546,7 @@ auto Mainboard::render_32bpp() -> void
         for(int row = 0; row < rows; ++row) {
             for(int ras = 0; ras < rass; ++ras) {
                 if(remaining_lines >= 2) {
+                    palette   = &vga->palette[*scanline];
                     curr_line = data_iter;
                     data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                     next_line = data_iter;
@@ -2993,15 +3557,15 @@ auto Mainboard::render_32bpp() -> void
                     break;
                 }
                 /* horizontal left border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel1;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors1[palette->ink[16]];
                     for(int col = 0; col < lfts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
                     }
                 }
                 /* horizontal active display */ {
-                    switch(scanline->mode) {
+                    switch(palette->mode) {
                         case 0x00: /* mode 0 */
                             {
                                 for(int col = 0; col < cols; ++col) {
@@ -3014,15 +3578,15 @@ auto Mainboard::render_32bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -3031,15 +3595,15 @@ auto Mainboard::render_32bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors1[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -3060,29 +3624,29 @@ auto Mainboard::render_32bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -3091,29 +3655,29 @@ auto Mainboard::render_32bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors1[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -3134,57 +3698,57 @@ auto Mainboard::render_32bpp() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -3193,57 +3757,57 @@ auto Mainboard::render_32bpp() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel1;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors1[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -3253,13 +3817,13 @@ auto Mainboard::render_32bpp() -> void
                             }
                             break;
                         default:
-                            ::xcpc_log_alert("mode %d is not supported", scanline->mode);
+                            ::xcpc_log_alert("mode %d is not supported", palette->mode);
                             break;
                     }
                 }
                 /* horizontal right border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel1;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors1[palette->ink[16]];
                     for(int col = 0; col < rgts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
@@ -3275,12 +3839,13 @@ auto Mainboard::render_32bpp() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel1;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors1[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -3302,7 +3867,9 @@ auto Mainboard::render_rgba() -> void
 {
     auto& vdc(*_vdc);
     auto& vga(*_vga);
-    auto* scanline = &vga->scanline[0];
+    const uint16_t*       scanline = &vga->scanline[0];
+    const vga::Palette*   palette  = &vga->palette[*scanline];
+    const uint32_t* const colors0  = vga->colormap.pixel0;
     const uint8_t* const mode0 = vga->mode0;
     const uint8_t* const mode1 = vga->mode1;
     const uint8_t* const mode2 = vga->mode2;
@@ -3349,12 +3916,13 @@ auto Mainboard::render_rgba() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel0;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors0[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -3376,6 +3944,7 @@ auto Mainboard::render_rgba() -> void
         for(int row = 0; row < rows; ++row) {
             for(int ras = 0; ras < rass; ++ras) {
                 if(remaining_lines >= 2) {
+                    palette   = &vga->palette[*scanline];
                     curr_line = data_iter;
                     data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                     next_line = data_iter;
@@ -3386,15 +3955,15 @@ auto Mainboard::render_rgba() -> void
                     break;
                 }
                 /* horizontal left border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel0;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors0[palette->ink[16]];
                     for(int col = 0; col < lfts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
                     }
                 }
                 /* horizontal active display */ {
-                    switch(scanline->mode) {
+                    switch(palette->mode) {
                         case 0x00: /* mode 0 */
                             {
                                 for(int col = 0; col < cols; ++col) {
@@ -3407,15 +3976,15 @@ auto Mainboard::render_rgba() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors0[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors0[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -3424,15 +3993,15 @@ auto Mainboard::render_rgba() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode0[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors0[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x0f].pixel0;
-                                            pixel1 = scanline->color[byte & 0x0f].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x0f]];
+                                            pixel1 = colors0[palette->ink[byte & 0x0f]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 4;
@@ -3453,29 +4022,29 @@ auto Mainboard::render_rgba() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -3484,29 +4053,29 @@ auto Mainboard::render_rgba() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode1[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x03].pixel0;
-                                            pixel1 = scanline->color[byte & 0x03].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x03]];
+                                            pixel1 = colors0[palette->ink[byte & 0x03]];
                                             *curr_line++ = pixel0; *curr_line++ = pixel0;
                                             *next_line++ = pixel1; *next_line++ = pixel1;
                                             byte >>= 2;
@@ -3527,57 +4096,57 @@ auto Mainboard::render_rgba() -> void
                                     /* process 1st byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 0]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -3586,57 +4155,57 @@ auto Mainboard::render_rgba() -> void
                                     /* process 2nd byte */ {
                                         uint8_t byte = mode2[ram[bank][disp | 1]];
                                         /* render pixel 0 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 1 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 2 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 3 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 4 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 5 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 6 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
                                         }
                                         /* render pixel 7 */ {
-                                            pixel0 = scanline->color[byte & 0x01].pixel0;
-                                            pixel1 = scanline->color[byte & 0x01].pixel0;
+                                            pixel0 = colors0[palette->ink[byte & 0x01]];
+                                            pixel1 = colors0[palette->ink[byte & 0x01]];
                                             *curr_line++ = pixel0;
                                             *next_line++ = pixel1;
                                             byte >>= 1;
@@ -3646,13 +4215,13 @@ auto Mainboard::render_rgba() -> void
                             }
                             break;
                         default:
-                            ::xcpc_log_alert("mode %d is not supported", scanline->mode);
+                            ::xcpc_log_alert("mode %d is not supported", palette->mode);
                             break;
                     }
                 }
                 /* horizontal right border */ {
-                    pixel0 = scanline->color[16].pixel0;
-                    pixel1 = scanline->color[16].pixel0;
+                    pixel0 = colors0[palette->ink[16]];
+                    pixel1 = colors0[palette->ink[16]];
                     for(int col = 0; col < rgts; ++col) {
                         *curr_line++ = pixel0;
                         *next_line++ = pixel1;
@@ -3668,12 +4237,13 @@ auto Mainboard::render_rgba() -> void
         const int cols = h.ht * h.cw;
         for(int row = 0; row < rows; ++row) {
             if(remaining_lines >= 2) {
+                palette   = &vga->palette[*scanline];
                 curr_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
                 next_line = data_iter;
                 data_iter = XCPC_LONG_PTR(XCPC_BYTE_PTR(data_iter) + bytes_per_line);
-                pixel0 = scanline->color[16].pixel0;
-                pixel1 = scanline->color[16].pixel0;
+                pixel0 = colors0[palette->ink[16]];
+                pixel1 = colors0[palette->ink[16]];
                 remaining_lines -= 2;
             }
             else {
@@ -3855,6 +4425,9 @@ auto Mainboard::cpu_mreq_wr(cpu::Instance& instance, uint16_t addr, uint8_t data
         const uint16_t bank   = ((addr >> 14) & 0x0003);
         const uint16_t offset = ((addr >>  0) & 0x3fff);
         _state.pal_wr[bank][offset] = data;
+        if(DirtyTraits::enabled != false) {
+            DirtyTraits::mark(_dirty, &_state.pal_wr[bank][offset]);
+        }
     }
     return data;
 }
@@ -4283,6 +4856,7 @@ auto Mainboard::ppi_port_b_rd(ppi::Instance& instance, uint8_t data) -> uint8_t
 {
     auto process = [&]() -> uint8_t
     {
+        update_tape();
         return static_cast<uint8_t>((_state.cas_rd_data & 0x01) << 7)
              | static_cast<uint8_t>((_state.prt_busy    & 0x01) << 6)
              | static_cast<uint8_t>((_state.exp_busy    & 0x01) << 5)
@@ -4360,6 +4934,14 @@ auto Mainboard::ppi_port_c_wr(ppi::Instance& instance, uint8_t data) -> uint8_t
 
     auto process = [&]() -> uint8_t
     {
+        /* bring the tape up to date before the motor changes */ {
+            update_tape();
+        }
+        /* restart a stopped tape when the motor is switched on */ {
+            if((_tape != nullptr) && (_state.cas_motor == 0) && ((data & 0x10) != 0)) {
+                _tape->play();
+            }
+        }
         /* update state */ {
             _state.psg_bdir    = ((data & 0x80) >> 7);
             _state.psg_bc1     = ((data & 0x40) >> 6);
@@ -18,6 +18,8 @@
 #define __XCPC_CPC_MAINBOARD_H__
 
 #include <xcpc/amstrad/cpc/cpc-settings.h>
+#include <xcpc/amstrad/cpc/cpc-framehash.h>
+#include <xcpc/amstrad/cpc/cpc-snapshot.h>
 #include <xcpc/amstrad/dpy/dpy-core.h>
 #include <xcpc/amstrad/kbd/kbd-core.h>
 #include <xcpc/amstrad/cpu/cpu-core.h>
@@ -85,6 +87,8 @@ public: // public interface
     virtual auto clock() -> void override final;
 
 public: // public interface
+    auto fork(const unsigned int count) -> std::vector<std::unique_ptr<Mainboard>>;
+
     auto load_snapshot(const std::string& filename) -> void;
 
     auto save_snapshot(const std::string& filename) -> void;
@@ -101,6 +105,20 @@ public: // public interface
 
     auto remove_disk_from_drive1() -> void;
 
+    auto insert_tape(const std::string& filename) -> void;
+
+    auto remove_tape() -> void;
+
+    auto rewind_tape() -> void;
+
+    auto start_capture(const std::string& filename) -> void;
+
+    auto stop_capture() -> void;
+
+    auto start_frame_hashing(const std::string& output, const std::string& golden) -> void;
+
+    auto stop_frame_hashing() -> void;
+
     auto set_parameterb(const std::string& parameter, bool value) -> void;
 
     auto set_parameteri(const std::string& parameter, int value) -> void;
@@ -137,12 +155,16 @@ public: // public interface
 
     auto get_drive1_filename() const -> std::string;
 
+    auto get_tape_filename() const -> std::string;
+
     auto get_system_info() const -> std::string;
 
     auto get_statistics() const -> std::string;
 
     auto get_volume() const -> float;
 
+    auto get_snapshot_progress() const -> SnapshotProgress;
+
 public: // backend interface
     auto on_reset(Event& event) -> unsigned long;
 
@@ -167,9 +189,17 @@ public: // backend interface
     auto on_motion_notify(Event& event) -> unsigned long;
 
 public: // public types
-    static constexpr uint32_t FLAG_RESET  = 0x01;
-    static constexpr uint32_t FLAG_PAUSE  = 0x02;
-    static constexpr uint32_t SND_BUFSIZE = 16384;
+    static constexpr uint32_t FLAG_RESET   = 0x01;
+    static constexpr uint32_t FLAG_PAUSE   = 0x02;
+    static constexpr uint32_t SND_BUFSIZE  = 16384;
+    static constexpr uint32_t RAM_BANKS    = 8;
+    static constexpr uint32_t ROM_BANKS    = 2;
+    static constexpr uint32_t EXP_BANKS    = 256;
+    static constexpr uint32_t DIRTY_SIZE   = 256;
+    static constexpr uint32_t DIRTY_PAGES  = ((RAM_BANKS * mem::BANK_SIZE) / DIRTY_SIZE);
+    static constexpr uint32_t TURBO_FRAMES = 8;
+
+    using DirtyPageFunc = std::function<void(uint32_t bank, uint32_t offset, const uint8_t* data, uint32_t size)>;
 
     struct Setup
     {
@@ -183,6 +213,8 @@ public: // public types
         uint32_t     speedup;
         bool         xshm;
         bool         crt_emulation;
+        bool         crt_filter;
+        bool         turbo_disk;
     };
 
     struct Stats
@@ -217,6 +249,7 @@ public: // public types
         uint32_t psg_ticks;   /* psg ticks                 */
         uint32_t snd_clock;   /* snd clock                 */
         uint32_t snd_ticks;   /* snd ticks                 */
+        uint32_t cas_ticks;   /* cas ticks (cpu t-states)  */
         uint8_t  vdc_hsync;   /* display hsync signal      */
         uint8_t  vdc_vsync;   /* display vsync signal      */
         uint8_t  lnk_lk1;     /* manufacturer id bit1      */
@@ -261,17 +294,34 @@ public: // public types
         uint32_t frame_time;
     };
 
+    struct Dirty
+    {
+        const uint8_t* ram_base;
+        uint64_t       bitmap[DIRTY_PAGES / 64];
+    };
+
+public: // dirty pages interface
+    auto has_dirty_tracking() const -> bool;
+
+    auto mark_dirty_pages() -> void;
+
+    auto clear_dirty_pages() -> void;
+
+    auto for_each_dirty_page(const DirtyPageFunc& function) const -> void;
+
 private: // private interface
     auto configure(const Settings& settings) -> void;
     auto load_lower_rom(const std::string& filename) -> void;
     auto load_upper_rom(const std::string& filename) -> void;
     auto load_expansion(const std::string& filename, const int index) -> void;
-    auto load_cpc(sna::Snapshot& snapshot) -> void;
+    auto load_cpc(sna::SnapshotFile& snapshot) -> void;
     auto save_cpc(sna::Snapshot& snapshot) -> void;
 
     auto update_vga() -> void;
     auto update_pal() -> void;
     auto update_stats() -> void;
+    auto update_tape() -> void;
+    auto hash_frame() -> uint32_t;
     auto render_08bpp() -> void;
     auto render_16bpp() -> void;
     auto render_32bpp() -> void;
@@ -322,6 +372,9 @@ private: // private data
     State          _state;
     Audio          _audio;
     Video          _video;
+    Dirty          _dirty;
+    FrameHash      _framehash;
+    SnapshotSaver  _saver;
     dpy::Instance* _dpy;
     kbd::Instance* _kbd;
     cpu::Instance* _cpu;
@@ -330,9 +383,11 @@ private: // private data
     ppi::Instance* _ppi;
     psg::Instance* _psg;
     fdc::Instance* _fdc;
-    mem::Instance* _ram[8];
-    mem::Instance* _rom[2];
-    mem::Instance* _exp[256];
+    cdt::Tape*     _tape;
+    mem::Arena     _arena;
+    mem::Instance* _ram[RAM_BANKS];
+    mem::Instance* _rom[ROM_BANKS];
+    mem::Instance* _exp[EXP_BANKS];
 };
 
 }
@@ -68,17 +68,26 @@ enum OptionEnum
     OPT_ROM015           = 23,
     OPT_DRIVE0           = 24,
     OPT_DRIVE1           = 25,
-    OPT_SNAPSHOT         = 26,
-    OPT_SPEEDUP          = 27,
-    OPT_XSHM             = 28,
-    OPT_NO_XSHM          = 29,
-    OPT_CRT_EMULATION    = 30,
-    OPT_NO_CRT_EMULATION = 31,
-    OPT_HELP             = 32,
-    OPT_VERSION          = 33,
-    OPT_QUIET            = 34,
-    OPT_TRACE            = 35,
-    OPT_DEBUG            = 36,
+    OPT_TAPE             = 26,
+    OPT_SNAPSHOT         = 27,
+    OPT_SPEEDUP          = 28,
+    OPT_CAPTURE          = 29,
+    OPT_HASH_OUT         = 30,
+    OPT_HASH_REF         = 31,
+    OPT_STARTUP_PROFILE  = 32,
+    OPT_XSHM             = 33,
+    OPT_NO_XSHM          = 34,
+    OPT_CRT_EMULATION    = 35,
+    OPT_NO_CRT_EMULATION = 36,
+    OPT_CRT_FILTER       = 37,
+    OPT_NO_CRT_FILTER    = 38,
+    OPT_TURBO_DISK       = 39,
+    OPT_NO_TURBO_DISK    = 40,
+    OPT_HELP             = 41,
+    OPT_VERSION          = 42,
+    OPT_QUIET            = 43,
+    OPT_TRACE            = 44,
+    OPT_DEBUG            = 45,
 };
 
 }
@@ -140,12 +149,21 @@ const OptionType options[] = {
     { "--rom015={filename}"  , "16Kb expansion rom #16"                                        },
     { "--drive0={filename}"  , "drive0 disk image"                                             },
     { "--drive1={filename}"  , "drive1 disk image"                                             },
+    { "--tape={filename}"    , "cassette tape image (.cdt/.tzx)"                               },
     { "--snapshot={filename}", "initial snapshot"                                              },
     { "--speedup={factor}"   , "speeds up emulation by an integer factor"                      },
+    { "--capture={filename}" , "capture the frames to a .y4m or raw rgb file, or to |command"  },
+    { "--hash-out={filename}", "write the per-frame hashes to a file"                          },
+    { "--hash-ref={filename}", "compare the per-frame hashes against a golden list"            },
+    { "--startup-profile"    , "print a per-phase startup timing breakdown"                    },
     { "--xshm"               , "use the XShm extension"                                        },
     { "--no-xshm"            , "don't use the XShm extension"                                  },
     { "--crt-emulation"      , "simulate crt monitor"                                          },
     { "--no-crt-emulation"   , "don't simulate crt monitor"                                    },
+    { "--crt-filter"         , "apply the crt effects in software with the x11 renderer"       },
+    { "--no-crt-filter"      , "don't apply the crt effects with the x11 renderer"             },
+    { "--turbo-disk"         , "run at full speed while the disk drive motor is on"            },
+    { "--no-turbo-disk"      , "run at normal speed while the disk drive motor is on"          },
     { "--help"               , "display this help and exit"                                    },
     { "--version"            , "display the version and exit"                                  },
     { "--quiet"              , "set the loglevel to quiet mode"                                },
@@ -190,10 +208,17 @@ Settings::Settings()
     , opt_rom015(not_set)
     , opt_drive0(not_set)
     , opt_drive1(not_set)
+    , opt_tape(not_set)
     , opt_snapshot(not_set)
     , opt_speedup(not_set)
+    , opt_capture(not_set)
+    , opt_hash_out(not_set)
+    , opt_hash_ref(not_set)
+    , opt_startup_profile(false)
     , opt_xshm(true)
     , opt_crt_emulation(true)
+    , opt_crt_filter(false)
+    , opt_turbo_disk(false)
     , opt_help(false)
     , opt_version(false)
     , opt_loglevel(Utils::get_loglevel())
@@ -249,6 +274,11 @@ void Settings::parse(int& argc, char**& argv)
         }
     };
 
+    auto do_profile = [&]() -> void
+    {
+        StartupProfile::enable(opt_startup_profile);
+    };
+
     auto do_dump_all = [&]() -> void
     {
         ::xcpc_log_debug("xcpc.settings.program       = %s", opt_program.c_str() );
@@ -278,10 +308,17 @@ void Settings::parse(int& argc, char**& argv)
         ::xcpc_log_debug("xcpc.settings.rom015        = %s", opt_rom015.c_str()  );
         ::xcpc_log_debug("xcpc.settings.drive0        = %s", opt_drive0.c_str()  );
         ::xcpc_log_debug("xcpc.settings.drive1        = %s", opt_drive1.c_str()  );
+        ::xcpc_log_debug("xcpc.settings.tape          = %s", opt_tape.c_str()    );
         ::xcpc_log_debug("xcpc.settings.snapshot      = %s", opt_snapshot.c_str());
         ::xcpc_log_debug("xcpc.settings.speedup       = %s", opt_speedup.c_str() );
+        ::xcpc_log_debug("xcpc.settings.capture       = %s", opt_capture.c_str() );
+        ::xcpc_log_debug("xcpc.settings.hash_out      = %s", opt_hash_out.c_str());
+        ::xcpc_log_debug("xcpc.settings.hash_ref      = %s", opt_hash_ref.c_str());
+        ::xcpc_log_debug("xcpc.settings.profile       = %d", opt_startup_profile );
         ::xcpc_log_debug("xcpc.settings.xshm          = %d", opt_xshm            );
         ::xcpc_log_debug("xcpc.settings.crt_emulation = %d", opt_crt_emulation   );
+        ::xcpc_log_debug("xcpc.settings.crt_filter    = %d", opt_crt_filter      );
+        ::xcpc_log_debug("xcpc.settings.turbo_disk    = %d", opt_turbo_disk      );
         ::xcpc_log_debug("xcpc.settings.help          = %d", opt_help            );
         ::xcpc_log_debug("xcpc.settings.version       = %d", opt_version         );
         ::xcpc_log_debug("xcpc.settings.loglevel      = %d", opt_loglevel        );
@@ -325,12 +362,21 @@ void Settings::parse(int& argc, char**& argv)
             else if(is_option(OPT_ROM015          , argument)) { opt_rom015        = value_of(argument);  }
             else if(is_option(OPT_DRIVE0          , argument)) { opt_drive0        = value_of(argument);  }
             else if(is_option(OPT_DRIVE1          , argument)) { opt_drive1        = value_of(argument);  }
+            else if(is_option(OPT_TAPE            , argument)) { opt_tape          = value_of(argument);  }
             else if(is_option(OPT_SNAPSHOT        , argument)) { opt_snapshot      = value_of(argument);  }
             else if(is_option(OPT_SPEEDUP         , argument)) { opt_speedup       = value_of(argument);  }
+            else if(is_option(OPT_CAPTURE         , argument)) { opt_capture       = value_of(argument);  }
+            else if(is_option(OPT_HASH_OUT        , argument)) { opt_hash_out      = value_of(argument);  }
+            else if(is_option(OPT_HASH_REF        , argument)) { opt_hash_ref      = value_of(argument);  }
+            else if(is_option(OPT_STARTUP_PROFILE , argument)) { opt_startup_profile = true;              }
             else if(is_option(OPT_XSHM            , argument)) { opt_xshm          = true;                }
             else if(is_option(OPT_NO_XSHM         , argument)) { opt_xshm          = false;               }
             else if(is_option(OPT_CRT_EMULATION   , argument)) { opt_crt_emulation = true;                }
             else if(is_option(OPT_NO_CRT_EMULATION, argument)) { opt_crt_emulation = false;               }
+            else if(is_option(OPT_CRT_FILTER      , argument)) { opt_crt_filter    = true;                }
+            else if(is_option(OPT_NO_CRT_FILTER   , argument)) { opt_crt_filter    = false;               }
+            else if(is_option(OPT_TURBO_DISK      , argument)) { opt_turbo_disk    = true;                }
+            else if(is_option(OPT_NO_TURBO_DISK   , argument)) { opt_turbo_disk    = false;               }
             else if(is_option(OPT_HELP            , argument)) { opt_help          = true;                }
             else if(is_option(OPT_VERSION         , argument)) { opt_version       = true;                }
             else if(is_option(OPT_QUIET           , argument)) { opt_loglevel      = XCPC_LOGLEVEL_QUIET; }
@@ -342,6 +388,7 @@ void Settings::parse(int& argc, char**& argv)
             ++index;
         }
         do_loglevel();
+        do_profile();
         do_dump_all();
         if(opt_help != false) {
             usage();
@@ -416,19 +463,28 @@ void Settings::usage()
     print_opt(OPT_ROM015          );
     print_opt(OPT_DRIVE0          );
     print_opt(OPT_DRIVE1          );
+    print_opt(OPT_TAPE            );
     print_opt(OPT_SNAPSHOT        );
     print_str(""                  );
     print_str("Misc. options:"    );
     print_opt(OPT_SPEEDUP         );
+    print_opt(OPT_CAPTURE         );
+    print_opt(OPT_HASH_OUT        );
+    print_opt(OPT_HASH_REF        );
     print_opt(OPT_XSHM            );
     print_opt(OPT_NO_XSHM         );
     print_opt(OPT_CRT_EMULATION   );
     print_opt(OPT_NO_CRT_EMULATION);
+    print_opt(OPT_CRT_FILTER      );
+    print_opt(OPT_NO_CRT_FILTER   );
+    print_opt(OPT_TURBO_DISK      );
+    print_opt(OPT_NO_TURBO_DISK   );
     print_str(""                  );
     print_str("Debug options:"    );
     print_opt(OPT_QUIET           );
     print_opt(OPT_TRACE           );
     print_opt(OPT_DEBUG           );
+    print_opt(OPT_STARTUP_PROFILE );
     print_str(""                  );
 }
 
@@ -30,6 +30,7 @@ class Mainboard;
 class Settings;
 
 using Utils                = xcpc::Utils;
+using StartupProfile       = xcpc::StartupProfile;
 using Event                = xcpc::Event;
 using Backend              = xcpc::Backend;
 using CompanyName          = xcpc::CompanyName;
@@ -116,10 +117,17 @@ public: // public data
     std::string opt_rom015;
     std::string opt_drive0;
     std::string opt_drive1;
+    std::string opt_tape;
     std::string opt_snapshot;
     std::string opt_speedup;
+    std::string opt_capture;
+    std::string opt_hash_out;
+    std::string opt_hash_ref;
+    bool        opt_startup_profile;
     bool        opt_xshm;
     bool        opt_crt_emulation;
+    bool        opt_crt_filter;
+    bool        opt_turbo_disk;
     bool        opt_help;
     bool        opt_version;
     int         opt_loglevel;
@@ -0,0 +1,204 @@
+/*
+ * cpc-snapshot.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <xcpc/libxcpc-priv.h>
+#include "cpc-snapshot.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::SnapshotTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct SnapshotTraits
+{
+    static auto temporary(const std::string& filename) -> std::string
+    {
+        return filename + ".part";
+    }
+
+    static auto sync(const std::string& filename) -> void
+    {
+#ifdef HAVE_UNISTD_H
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd >= 0) {
+            static_cast<void>(::fsync(fd));
+            static_cast<void>(::close(fd));
+        }
+#endif
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// cpc::SnapshotSaver
+// ---------------------------------------------------------------------------
+
+namespace cpc {
+
+SnapshotSaver::SnapshotSaver()
+    : _mutex()
+    , _not_empty()
+    , _not_full()
+    , _thread()
+    , _jobs()
+    , _head(0)
+    , _count(0)
+    , _running(false)
+    , _stopping(false)
+    , _progress()
+{
+}
+
+SnapshotSaver::~SnapshotSaver()
+{
+    stop();
+}
+
+auto SnapshotSaver::submit(const std::string& filename, const CaptureFunc& capture) -> void
+{
+    if(_running == false) {
+        start();
+    }
+
+    xcpc::MutexLock lock(_mutex);
+
+    while(_count == QUEUE_SIZE) {
+        _not_full.wait(lock);
+    }
+    /* the slot is not visible to the writer until it is counted */ {
+        Job& job(_jobs[(_head + _count) % QUEUE_SIZE]);
+        capture(*job.snapshot);
+        job.filename = filename;
+        ++_count;
+        ++_progress.pending;
+        _not_empty.notify_one();
+    }
+}
+
+auto SnapshotSaver::stop() -> void
+{
+    if(_running == false) {
+        return;
+    }
+    /* let the writer drain the queue */ {
+        xcpc::MutexLock lock(_mutex);
+        _stopping = true;
+        _not_empty.notify_all();
+    }
+    if(_thread.joinable()) {
+        _thread.join();
+    }
+    _jobs.clear();
+    _running = false;
+}
+
+auto SnapshotSaver::get_progress() const -> SnapshotProgress
+{
+    xcpc::MutexLock lock(_mutex);
+
+    return _progress;
+}
+
+auto SnapshotSaver::start() -> void
+{
+    /* preallocate the snapshot buffers */ {
+        _jobs.resize(QUEUE_SIZE);
+        for(auto& job : _jobs) {
+            if(job.snapshot == nullptr) {
+                job.snapshot.reset(new sna::Snapshot());
+            }
+        }
+        _head     = 0;
+        _count    = 0;
+        _running  = true;
+        _stopping = false;
+    }
+    /* start the writer */ {
+        _thread = Thread(&SnapshotSaver::loop, this);
+    }
+}
+
+auto SnapshotSaver::loop() -> void
+{
+    xcpc::MutexLock lock(_mutex);
+
+    while(true) {
+        while((_count == 0) && (_stopping == false)) {
+            _not_empty.wait(lock);
+        }
+        if(_count == 0) {
+            break;
+        }
+        Job&        job(_jobs[_head]);
+        std::string error;
+        lock.unlock();
+        const bool written = write(job, error);
+        lock.lock();
+        _head = ((_head + 1) % QUEUE_SIZE);
+        --_count;
+        --_progress.pending;
+        _progress.filename = job.filename;
+        _progress.error    = error;
+        if(written != false) {
+            ++_progress.saved;
+        }
+        else {
+            ++_progress.failed;
+        }
+        _not_full.notify_one();
+    }
+}
+
+auto SnapshotSaver::write(Job& job, std::string& error) -> bool
+{
+    const std::string temporary(SnapshotTraits::temporary(job.filename));
+
+    try {
+        job.snapshot->save(temporary);
+        SnapshotTraits::sync(temporary);
+        if(::rename(temporary.c_str(), job.filename.c_str()) != 0) {
+            throw std::runtime_error(std::string("unable to rename snapshot") + ' ' + '<' + temporary + '>');
+        }
+    }
+    catch(const std::exception& e) {
+        static_cast<void>(::remove(temporary.c_str()));
+        error = e.what();
+        return false;
+    }
+    return true;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,108 @@
+/*
+ * cpc-snapshot.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_CPC_SNAPSHOT_H__
+#define __XCPC_CPC_SNAPSHOT_H__
+
+#include <xcpc/formats/sna/sna-format.h>
+
+// ---------------------------------------------------------------------------
+// cpc::SnapshotProgress
+// ---------------------------------------------------------------------------
+
+namespace cpc {
+
+struct SnapshotProgress
+{
+    unsigned long pending = 0UL;
+    unsigned long saved   = 0UL;
+    unsigned long failed  = 0UL;
+    std::string   filename;
+    std::string   error;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// cpc::SnapshotSaver
+// ---------------------------------------------------------------------------
+
+namespace cpc {
+
+class SnapshotSaver
+{
+public: // public types
+    using CaptureFunc = std::function<void(sna::Snapshot&)>;
+
+public: // public interface
+    SnapshotSaver();
+
+    SnapshotSaver(SnapshotSaver&&) = delete;
+
+    SnapshotSaver(const SnapshotSaver&) = delete;
+
+    SnapshotSaver& operator=(SnapshotSaver&&) = delete;
+
+    SnapshotSaver& operator=(const SnapshotSaver&) = delete;
+
+    virtual ~SnapshotSaver();
+
+    auto submit(const std::string& filename, const CaptureFunc& capture) -> void;
+
+    auto stop() -> void;
+
+    auto get_progress() const -> SnapshotProgress;
+
+private: // private types
+    struct Job
+    {
+        std::unique_ptr<sna::Snapshot> snapshot;
+        std::string                    filename;
+    };
+
+    using Thread    = std::thread;
+    using Condition = std::condition_variable;
+    using Jobs      = std::vector<Job>;
+
+    static constexpr int QUEUE_SIZE = 2;
+
+private: // private interface
+    auto start() -> void;
+
+    auto loop() -> void;
+
+    auto write(Job& job, std::string& error) -> bool;
+
+private: // private data
+    mutable xcpc::Mutex _mutex;
+    Condition           _not_empty;
+    Condition           _not_full;
+    Thread              _thread;
+    Jobs                _jobs;
+    int                 _head;
+    int                 _count;
+    bool                _running;
+    bool                _stopping;
+    SnapshotProgress    _progress;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_CPC_SNAPSHOT_H__ */
@@ -0,0 +1,360 @@
+/*
+ * dpy-capture.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <csignal>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <xcpc/libxcpc-priv.h>
+#include "dpy-capture.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::CaptureTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct CaptureTraits
+{
+    struct Channel
+    {
+        uint32_t mask  = 0;
+        int      shift = 0;
+        int      bits  = 0;
+    };
+
+    static inline auto channel(const uint32_t mask) -> Channel
+    {
+        Channel channel;
+
+        channel.mask = mask;
+        if(mask != 0) {
+            while(((mask >> channel.shift) & 1) == 0) {
+                ++channel.shift;
+            }
+            while(((mask >> (channel.shift + channel.bits)) & 1) != 0) {
+                ++channel.bits;
+            }
+        }
+        return channel;
+    }
+
+    static inline auto extract(const uint32_t pixel, const Channel& channel) -> int
+    {
+        const uint32_t value = ((pixel & channel.mask) >> channel.shift);
+
+        if(channel.bits >= 8) {
+            return static_cast<int>(value >> (channel.bits - 8));
+        }
+        if(channel.bits >= 4) {
+            return static_cast<int>((value << (8 - channel.bits)) | (value >> ((2 * channel.bits) - 8)));
+        }
+        return 0;
+    }
+
+    static inline auto fetch(const uint8_t* data, const int bpp, const int index) -> uint32_t
+    {
+        if(bpp == 16) {
+            return reinterpret_cast<const uint16_t*>(data)[index];
+        }
+        return reinterpret_cast<const uint32_t*>(data)[index];
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// dpy::Capture
+// ---------------------------------------------------------------------------
+
+namespace dpy {
+
+Capture::Capture()
+    : _mutex()
+    , _not_empty()
+    , _not_full()
+    , _thread()
+    , _frames()
+    , _buffer()
+    , _stream(nullptr)
+    , _piped(false)
+    , _format(FORMAT_Y4M)
+    , _policy(POLICY_DROP)
+    , _frame_rate(50)
+    , _width(0)
+    , _height(0)
+    , _head(0)
+    , _count(0)
+    , _running(false)
+    , _stopping(false)
+    , _written(0UL)
+    , _dropped(0UL)
+{
+}
+
+Capture::~Capture()
+{
+    stop();
+}
+
+auto Capture::start(const std::string& filename, int format, int policy, int frame_rate) -> void
+{
+    stop();
+
+    /* open the output stream, a leading '|' denotes a command to pipe into */ {
+        if((filename.size() > 1) && (filename[0] == '|')) {
+            _stream = ::popen(filename.c_str() + 1, "w");
+            _piped  = true;
+        }
+        else {
+            _stream = ::fopen(filename.c_str(), "wb");
+            _piped  = false;
+        }
+        if(_stream == nullptr) {
+            throw std::runtime_error(std::string("unable to open capture") + ' ' + '<' + filename + '>');
+        }
+    }
+    /* initialize the queue */ {
+        _frames.assign(QUEUE_SIZE, Frame());
+        _format     = (format == FORMAT_RGB ? FORMAT_RGB : FORMAT_Y4M);
+        _policy     = (policy == POLICY_BLOCK ? POLICY_BLOCK : POLICY_DROP);
+        _frame_rate = (frame_rate > 0 ? frame_rate : 50);
+        _width      = 0;
+        _height     = 0;
+        _head       = 0;
+        _count      = 0;
+        _running    = true;
+        _stopping   = false;
+        _written    = 0UL;
+        _dropped    = 0UL;
+    }
+    /* start the writer thread */ {
+        _thread = Thread(&Capture::loop, this);
+    }
+    ::xcpc_log_debug("capture started <%s>", filename.c_str());
+}
+
+auto Capture::stop() -> void
+{
+    if(_running == false) {
+        return;
+    }
+    /* let the writer drain the queue */ {
+        xcpc::MutexLock lock(_mutex);
+        _stopping = true;
+        _not_empty.notify_all();
+        _not_full.notify_all();
+    }
+    if(_thread.joinable()) {
+        _thread.join();
+    }
+    close();
+    _frames.clear();
+    _buffer.clear();
+    _running = false;
+    ::xcpc_log_debug("capture stopped (%lu frames written, %lu frames dropped)", _written, _dropped);
+}
+
+auto Capture::push(const Image& image) -> bool
+{
+    const int bytes_per_pixel = (image.bpp / 8);
+
+    if((_running == false) || (image.data == nullptr) || (image.w <= 0) || (image.h <= 0)) {
+        return false;
+    }
+    if((image.bpp != 16) && (image.bpp != 32)) {
+        return false;
+    }
+
+    xcpc::MutexLock lock(_mutex);
+
+    if(_stopping != false) {
+        return false;
+    }
+    if(_width == 0) {
+        _width  = image.w;
+        _height = image.h;
+    }
+    if((image.w != _width) || (image.h != _height)) {
+        ++_dropped;
+        return false;
+    }
+    while(_count == QUEUE_SIZE) {
+        if((_policy == POLICY_DROP) || (_stopping != false)) {
+            ++_dropped;
+            return false;
+        }
+        _not_full.wait(lock);
+    }
+    /* the slot is not visible to the writer until it is counted */ {
+        Frame& frame(_frames[(_head + _count) % QUEUE_SIZE]);
+        const int row_bytes = (image.w * bytes_per_pixel);
+        frame.data.resize(row_bytes * image.h);
+        frame.bpp        = image.bpp;
+        frame.w          = image.w;
+        frame.h          = image.h;
+        frame.red_mask   = image.red_mask;
+        frame.green_mask = image.green_mask;
+        frame.blue_mask  = image.blue_mask;
+        const uint8_t* src = image.data + (image.y * image.bpl) + (image.x * bytes_per_pixel);
+        uint8_t*       dst = frame.data.data();
+        for(int row = 0; row < image.h; ++row) {
+            std::memcpy(dst, src, row_bytes);
+            src += image.bpl;
+            dst += row_bytes;
+        }
+        ++_count;
+        _not_empty.notify_one();
+    }
+    return true;
+}
+
+auto Capture::loop() -> void
+{
+    /* a vanishing consumer must fail the writes instead of killing the process */ {
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGPIPE);
+        static_cast<void>(::pthread_sigmask(SIG_BLOCK, &signals, nullptr));
+    }
+
+    xcpc::MutexLock lock(_mutex);
+    bool            header = false;
+
+    while(true) {
+        while((_count == 0) && (_stopping == false)) {
+            _not_empty.wait(lock);
+        }
+        if(_count == 0) {
+            break;
+        }
+        const Frame& frame(_frames[_head]);
+        lock.unlock();
+        bool written = true;
+        if(header == false) {
+            written = header = write_header(frame);
+        }
+        if(written != false) {
+            written = write_frame(frame);
+        }
+        lock.lock();
+        _head = ((_head + 1) % QUEUE_SIZE);
+        --_count;
+        _not_full.notify_one();
+        if(written != false) {
+            ++_written;
+        }
+        else {
+            ::xcpc_log_error("capture has failed, dropping the remaining frames");
+            _dropped += (_count + 1);
+            _count    = 0;
+            _stopping = true;
+            _not_full.notify_all();
+            break;
+        }
+    }
+}
+
+auto Capture::write_header(const Frame& frame) -> bool
+{
+    if(_format == FORMAT_Y4M) {
+        const int rc = ::fprintf(_stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", frame.w, frame.h, _frame_rate);
+        return rc > 0;
+    }
+    return true;
+}
+
+auto Capture::write_frame(const Frame& frame) -> bool
+{
+    const CaptureTraits::Channel r_channel = CaptureTraits::channel(frame.red_mask);
+    const CaptureTraits::Channel g_channel = CaptureTraits::channel(frame.green_mask);
+    const CaptureTraits::Channel b_channel = CaptureTraits::channel(frame.blue_mask);
+    const int                    pixels    = (frame.w * frame.h);
+    const uint8_t* const         data      = frame.data.data();
+
+    auto write_y4m = [&]() -> bool
+    {
+        static const char marker[] = "FRAME\n";
+
+        _buffer.resize(pixels * 3);
+        uint8_t* y_plane = _buffer.data();
+        uint8_t* u_plane = y_plane + pixels;
+        uint8_t* v_plane = u_plane + pixels;
+        for(int index = 0; index < pixels; ++index) {
+            const uint32_t pixel = CaptureTraits::fetch(data, frame.bpp, index);
+            const int r = CaptureTraits::extract(pixel, r_channel);
+            const int g = CaptureTraits::extract(pixel, g_channel);
+            const int b = CaptureTraits::extract(pixel, b_channel);
+            /* ITU-R BT.601, studio swing */ {
+                *y_plane++ = static_cast<uint8_t>(((( 66 * r) + (129 * g) + ( 25 * b) + 128) >> 8) +  16);
+                *u_plane++ = static_cast<uint8_t>((((-38 * r) - ( 74 * g) + (112 * b) + 128) >> 8) + 128);
+                *v_plane++ = static_cast<uint8_t>((((112 * r) - ( 94 * g) - ( 18 * b) + 128) >> 8) + 128);
+            }
+        }
+        if(::fwrite(marker, 1, (sizeof(marker) - 1), _stream) != (sizeof(marker) - 1)) {
+            return false;
+        }
+        return ::fwrite(_buffer.data(), 1, _buffer.size(), _stream) == _buffer.size();
+    };
+
+    auto write_rgb = [&]() -> bool
+    {
+        _buffer.resize(pixels * 3);
+        uint8_t* rgb = _buffer.data();
+        for(int index = 0; index < pixels; ++index) {
+            const uint32_t pixel = CaptureTraits::fetch(data, frame.bpp, index);
+            *rgb++ = static_cast<uint8_t>(CaptureTraits::extract(pixel, r_channel));
+            *rgb++ = static_cast<uint8_t>(CaptureTraits::extract(pixel, g_channel));
+            *rgb++ = static_cast<uint8_t>(CaptureTraits::extract(pixel, b_channel));
+        }
+        return ::fwrite(_buffer.data(), 1, _buffer.size(), _stream) == _buffer.size();
+    };
+
+    if(_format == FORMAT_RGB) {
+        return write_rgb();
+    }
+    return write_y4m();
+}
+
+auto Capture::close() -> void
+{
+    if(_stream != nullptr) {
+        if(_piped != false) {
+            _stream = (::pclose(_stream), nullptr);
+        }
+        else {
+            _stream = (::fclose(_stream), nullptr);
+        }
+    }
+    _piped = false;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,135 @@
+/*
+ * dpy-capture.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_DPY_CAPTURE_H__
+#define __XCPC_DPY_CAPTURE_H__
+
+// ---------------------------------------------------------------------------
+// dpy::Capture
+// ---------------------------------------------------------------------------
+
+namespace dpy {
+
+class Capture
+{
+public: // public types
+    enum Format
+    {
+        FORMAT_Y4M = 0,
+        FORMAT_RGB = 1,
+    };
+
+    enum Policy
+    {
+        POLICY_DROP  = 0,
+        POLICY_BLOCK = 1,
+    };
+
+    struct Image
+    {
+        const uint8_t* data       = nullptr;
+        int            bpp        = 0;
+        int            bpl        = 0;
+        int            x          = 0;
+        int            y          = 0;
+        int            w          = 0;
+        int            h          = 0;
+        uint32_t       red_mask   = 0;
+        uint32_t       green_mask = 0;
+        uint32_t       blue_mask  = 0;
+    };
+
+public: // public interface
+    Capture();
+
+    Capture(Capture&&) = delete;
+
+    Capture(const Capture&) = delete;
+
+    Capture& operator=(Capture&&) = delete;
+
+    Capture& operator=(const Capture&) = delete;
+
+    virtual ~Capture();
+
+    auto start(const std::string& filename, int format, int policy, int frame_rate) -> void;
+
+    auto stop() -> void;
+
+    auto push(const Image& image) -> bool;
+
+    auto is_running() const -> bool
+    {
+        return _running;
+    }
+
+private: // private types
+    struct Frame
+    {
+        std::vector<uint8_t> data;
+        int                  bpp        = 0;
+        int                  w          = 0;
+        int                  h          = 0;
+        uint32_t             red_mask   = 0;
+        uint32_t             green_mask = 0;
+        uint32_t             blue_mask  = 0;
+    };
+
+    using Thread    = std::thread;
+    using Condition = std::condition_variable;
+    using Frames    = std::vector<Frame>;
+    using Buffer    = std::vector<uint8_t>;
+
+    static constexpr int QUEUE_SIZE = 8;
+
+private: // private interface
+    auto loop() -> void;
+
+    auto write_header(const Frame& frame) -> bool;
+
+    auto write_frame(const Frame& frame) -> bool;
+
+    auto close() -> void;
+
+private: // private data
+    xcpc::Mutex   _mutex;
+    Condition     _not_empty;
+    Condition     _not_full;
+    Thread        _thread;
+    Frames        _frames;
+    Buffer        _buffer;
+    FILE*         _stream;
+    bool          _piped;
+    int           _format;
+    int           _policy;
+    int           _frame_rate;
+    int           _width;
+    int           _height;
+    int           _head;
+    int           _count;
+    bool          _running;
+    bool          _stopping;
+    unsigned long _written;
+    unsigned long _dropped;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_DPY_CAPTURE_H__ */
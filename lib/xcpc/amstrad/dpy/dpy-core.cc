@@ -330,6 +330,7 @@ Instance::Instance(Interface& interface)
     : _interface(interface)
     , _state()
     , _renderer()
+    , _capture()
 {
     StateTraits::construct(_state);
 
@@ -338,6 +339,7 @@ Instance::Instance(Interface& interface)
 
 Instance::~Instance()
 {
+    stop_capture();
     unrealize();
 
     StateTraits::destruct(_state);
@@ -402,11 +404,40 @@ auto Instance::expose(const XExposeEvent& event) -> void
 
 auto Instance::render() -> void
 {
+    auto do_capture = [&]() -> void
+    {
+        auto& renderer(*_renderer);
+        Capture::Image image;
+        image.data       = renderer->image_data;
+        image.bpp        = renderer->image_bpp;
+        image.bpl        = renderer->image_bpl;
+        image.x          = renderer->visible_x;
+        image.y          = renderer->visible_y;
+        image.w          = renderer->visible_w;
+        image.h          = renderer->visible_h;
+        image.red_mask   = renderer->red_mask;
+        image.green_mask = renderer->green_mask;
+        image.blue_mask  = renderer->blue_mask;
+        static_cast<void>(_capture.push(image));
+    };
+
     if(bool(_renderer) != false) {
+        auto& renderer(*_renderer);
+        renderer->image_readback = _capture.is_running();
+        if((renderer->image_readback != false) && (renderer->image_write_only == false)) {
+            do_capture();
+        }
         _renderer->render();
     }
 }
 
+auto Instance::notify(const XEvent& event) -> void
+{
+    if(bool(_renderer) != false) {
+        _renderer->notify(event);
+    }
+}
+
 auto Instance::set_parameterb(const std::string& parameter, bool value) -> void
 {
     if(bool(_renderer) != false) {
@@ -468,6 +499,41 @@ auto Instance::get_image_data() -> uint8_t*
     return nullptr;
 }
 
+auto Instance::start_capture(const std::string& filename, int format, int policy) -> void
+{
+    const int frame_rate = (_state.refresh_rate == XCPC_REFRESH_RATE_60HZ ? 60 : 50);
+
+    _capture.start(filename, format, policy, frame_rate);
+}
+
+auto Instance::stop_capture() -> void
+{
+    _capture.stop();
+}
+
+auto Instance::collect_upscale_cost() -> float
+{
+    float cost = 0.0f;
+
+    if(bool(_renderer) != false) {
+        auto& renderer(*_renderer);
+        if(renderer->upscale_frames != 0) {
+            cost = static_cast<float>(renderer->upscale_us) / static_cast<float>(renderer->upscale_frames * 1000);
+        }
+        renderer->upscale_us     = 0;
+        renderer->upscale_frames = 0;
+    }
+    return cost;
+}
+
+auto Instance::has_scanlines() const -> bool
+{
+    if(bool(_renderer) != false) {
+        return (*_renderer)->image_scanlines;
+    }
+    return false;
+}
+
 }
 
 // ---------------------------------------------------------------------------
@@ -481,6 +547,22 @@ Renderer::Renderer()
 {
 }
 
+auto Renderer::get_required_image_width() const -> int
+{
+    /* the mainboard rasterizes full CRTC lines (up to 64 chars of 16 pixels) */
+    return DISPLAY_WIDTH;
+}
+
+auto Renderer::get_required_image_height() const -> int
+{
+    const int required_height = (_state.visible_y + _state.visible_h);
+
+    if((_state.visible_h <= 0) || (required_height > DISPLAY_HEIGHT)) {
+        return DISPLAY_HEIGHT;
+    }
+    return required_height;
+}
+
 }
 
 // ---------------------------------------------------------------------------
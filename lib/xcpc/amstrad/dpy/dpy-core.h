@@ -17,6 +17,8 @@
 #ifndef __XCPC_DPY_CORE_H__
 #define __XCPC_DPY_CORE_H__
 
+#include <xcpc/amstrad/dpy/dpy-capture.h>
+
 // ---------------------------------------------------------------------------
 // forward declarations
 // ---------------------------------------------------------------------------
@@ -100,6 +102,8 @@ public: // public interface
 
     auto render() -> void;
 
+    auto notify(const XEvent& event) -> void;
+
     auto set_parameterb(const std::string& parameter, bool value) -> void;
 
     auto set_parameteri(const std::string& parameter, int value) -> void;
@@ -116,6 +120,14 @@ public: // public interface
 
     auto get_image_data() -> uint8_t*;
 
+    auto start_capture(const std::string& filename, int format, int policy) -> void;
+
+    auto stop_capture() -> void;
+
+    auto collect_upscale_cost() -> float;
+
+    auto has_scanlines() const -> bool;
+
     auto operator->() -> State*
     {
         return &_state;
@@ -129,6 +141,7 @@ protected: // protected data
     Interface&  _interface;
     State       _state;
     RendererPtr _renderer;
+    Capture     _capture;
 };
 
 }
@@ -184,6 +197,8 @@ public: // public interface
 
     virtual auto render() -> void = 0;
 
+    virtual auto notify(const XEvent& event) -> void = 0;
+
     virtual auto set_visible_area(int x, int y, int w, int h) -> void = 0;
 
     virtual auto alloc_color(uint16_t r, uint16_t g, uint16_t b) -> uint32_t = 0;
@@ -209,12 +224,20 @@ public: // public interface
         int      image_bpp;
         int      image_bpl;
         uint8_t* image_data;
+        uint32_t red_mask;
+        uint32_t green_mask;
+        uint32_t blue_mask;
         int      visible_x;
         int      visible_y;
         int      visible_w;
         int      visible_h;
         int      viewport_w;
         int      viewport_h;
+        uint64_t upscale_us;
+        uint64_t upscale_frames;
+        bool     image_readback;   /* set by the display when the CPU reads the frames */
+        bool     image_write_only; /* set by the renderer when image_data is write-only */
+        bool     image_scanlines;  /* set by the renderer when it draws the scanlines itself */
     };
 
     auto operator->() -> State*
@@ -222,6 +245,11 @@ public: // public interface
         return &_state;
     }
 
+protected: // protected interface
+    auto get_required_image_width() const -> int;
+
+    auto get_required_image_height() const -> int;
+
 protected: // protected data
     State _state;
 };
@@ -0,0 +1,526 @@
+/*
+ * dpy-upscaler.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <xcpc/libxcpc-priv.h>
+#include "dpy-upscaler.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::UpscalerTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct UpscalerTraits
+{
+    using Clock = std::chrono::steady_clock;
+
+    static inline auto blend(const uint32_t a, const uint32_t b) -> uint32_t
+    {
+        return (a & b) + (((a ^ b) & 0xfefefefeu) >> 1);
+    }
+
+    static inline auto distance(const uint32_t a, const uint32_t b) -> int
+    {
+        /* the weighting is symmetric so that RGBA and BGRA layouts behave alike */
+        const int d0 = static_cast<int>((a >>  0) & 0xff) - static_cast<int>((b >>  0) & 0xff);
+        const int d1 = static_cast<int>((a >>  8) & 0xff) - static_cast<int>((b >>  8) & 0xff);
+        const int d2 = static_cast<int>((a >> 16) & 0xff) - static_cast<int>((b >> 16) & 0xff);
+
+        return (d0 < 0 ? -d0 : d0) + (2 * (d1 < 0 ? -d1 : d1)) + (d2 < 0 ? -d2 : d2);
+    }
+
+    /* one xBR edge test, written for the bottom-right corner and rotated by the (X, Y) basis */
+    template <int XX, int XY, int YX, int YY>
+    static inline auto xbr_corner(const uint32_t* const* rows, const int col) -> uint32_t
+    {
+        auto px = [&](const int dx, const int dy) -> uint32_t
+        {
+            return rows[((dx * XY) + (dy * YY)) + 2][col + ((dx * XX) + (dy * YX))];
+        };
+        const uint32_t e = px(0, 0);
+        const uint32_t f = px(1, 0);
+        const uint32_t h = px(0, 1);
+
+        if((e == f) || (e == h)) {
+            return e;
+        }
+        const uint32_t i    = px(1, 1);
+        const int      d_ei = distance(e, px( 1, -1))
+                            + distance(e, px(-1,  1))
+                            + distance(i, px( 2,  0))
+                            + distance(i, px( 0,  2))
+                            + distance(h, f) * 4;
+        const int      d_hf = distance(h, px(-1,  0))
+                            + distance(h, px( 1,  2))
+                            + distance(f, px( 2,  1))
+                            + distance(f, px( 0, -1))
+                            + distance(e, i) * 4;
+        if(d_ei < d_hf) {
+            return blend(e, (distance(e, f) <= distance(e, h) ? f : h));
+        }
+        return e;
+    }
+
+#if defined(__SSE2__)
+    static inline auto select(const __m128i mask, const __m128i a, const __m128i b) -> __m128i
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    static inline auto load(const uint32_t* data) -> __m128i
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    }
+
+    static inline auto store(uint32_t* data, const __m128i value) -> void
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+    }
+#endif
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// dpy::Upscaler::Plane
+// ---------------------------------------------------------------------------
+
+namespace dpy {
+
+auto Upscaler::Plane::resize(int width, int height) -> void
+{
+    if((width != w) || (height != h)) {
+        w      = width;
+        h      = height;
+        stride = (width + (2 * BORDER));
+        data.assign((stride * (height + (2 * BORDER))), 0);
+    }
+}
+
+auto Upscaler::Plane::pad_columns(int first, int last) -> void
+{
+    for(int y = first; y < last; ++y) {
+        uint32_t* line = row(y);
+        for(int x = 1; x <= BORDER; ++x) {
+            line[-x]          = line[0];
+            line[(w - 1) + x] = line[w - 1];
+        }
+    }
+}
+
+auto Upscaler::Plane::pad_rows() -> void
+{
+    const uint32_t* head = (row(0)     - BORDER);
+    const uint32_t* tail = (row(h - 1) - BORDER);
+
+    for(int y = 1; y <= BORDER; ++y) {
+        std::memcpy((row(0 - y)       - BORDER), head, stride * sizeof(uint32_t));
+        std::memcpy((row((h - 1) + y) - BORDER), tail, stride * sizeof(uint32_t));
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// dpy::Upscaler
+// ---------------------------------------------------------------------------
+
+namespace dpy {
+
+Upscaler::Upscaler(Workers& workers)
+    : _workers(workers)
+    , _mode(MODE_NONE)
+    , _elapsed_us(0UL)
+    , _source()
+    , _middle()
+{
+}
+
+Upscaler::~Upscaler()
+{
+    reset();
+}
+
+auto Upscaler::set_mode(int mode) -> bool
+{
+    if((mode < MODE_NONE) || (mode > MODE_XBR2X)) {
+        mode = MODE_NONE;
+    }
+    if(mode != _mode) {
+        _mode = mode;
+        reset();
+        return true;
+    }
+    return false;
+}
+
+auto Upscaler::get_factor() const -> int
+{
+    switch(_mode) {
+        case MODE_SCALE2X:
+            return 2;
+        case MODE_SCALE3X:
+            return 3;
+        case MODE_SCALE4X:
+            return 4;
+        case MODE_XBR2X:
+            return 2;
+        default:
+            break;
+    }
+    return 2;
+}
+
+auto Upscaler::process(const uint8_t* src_data, int src_bpl, int src_w, int src_h, uint8_t* dst_data, int dst_bpl) -> bool
+{
+    const UpscalerTraits::Clock::time_point started = UpscalerTraits::Clock::now();
+    const int       width      = src_w;
+    const int       height     = (src_h / 2);
+    uint32_t* const dst        = reinterpret_cast<uint32_t*>(dst_data);
+    const int       dst_stride = (dst_bpl / 4);
+    const int       out_stride = (dst_stride * 2);
+
+    auto do_gather_rows = [&](int first, int last) -> void
+    {
+        gather_rows(src_data, src_bpl, first, last);
+    };
+
+    auto do_scale2x_rows = [&](int first, int last) -> void
+    {
+        scale2x_rows(_source, first, last, dst, out_stride);
+    };
+
+    auto do_scale3x_rows = [&](int first, int last) -> void
+    {
+        scale3x_rows(_source, first, last, dst, out_stride);
+    };
+
+    auto do_scale4x_rows_pass1 = [&](int first, int last) -> void
+    {
+        scale2x_rows(_source, first, last, _middle.row(0), _middle.stride);
+        _middle.pad_columns((first * 2), (last * 2));
+    };
+
+    auto do_scale4x_rows_pass2 = [&](int first, int last) -> void
+    {
+        scale2x_rows(_middle, first, last, dst, out_stride);
+    };
+
+    auto do_xbr2x_rows = [&](int first, int last) -> void
+    {
+        xbr2x_rows(_source, first, last, dst, out_stride);
+    };
+
+    auto do_double_rows = [&](int first, int last) -> void
+    {
+        double_rows(dst, dst_stride, first, last);
+    };
+
+    if((_mode == MODE_NONE) || (src_data == nullptr) || (dst_data == nullptr) || (width <= 0) || (height <= 0)) {
+        return false;
+    }
+    /* sample the emulated pixel grid */ {
+        _source.resize(width, height);
+        _workers.run(height, do_gather_rows);
+        _source.pad_rows();
+    }
+    /* upscale the pixel grid */ {
+        switch(_mode) {
+            case MODE_SCALE2X:
+                _workers.run(height, do_scale2x_rows);
+                break;
+            case MODE_SCALE3X:
+                _workers.run(height, do_scale3x_rows);
+                break;
+            case MODE_SCALE4X:
+                _middle.resize((width * 2), (height * 2));
+                _workers.run(height, do_scale4x_rows_pass1);
+                _middle.pad_rows();
+                _workers.run((height * 2), do_scale4x_rows_pass2);
+                break;
+            case MODE_XBR2X:
+                _workers.run(height, do_xbr2x_rows);
+                break;
+            default:
+                break;
+        }
+    }
+    /* restore the doubled raster lines */ {
+        _workers.run((height * get_factor()), do_double_rows);
+    }
+    /* measure the cost of the stage */ {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(UpscalerTraits::Clock::now() - started);
+        _elapsed_us = static_cast<unsigned long>(elapsed.count());
+    }
+    return true;
+}
+
+auto Upscaler::reset() -> void
+{
+    _elapsed_us = 0UL;
+    _source     = Plane();
+    _middle     = Plane();
+}
+
+auto Upscaler::gather_rows(const uint8_t* src_data, int src_bpl, int first, int last) -> void
+{
+    const int w = _source.w;
+
+    /* the mainboard doubles every raster line, keep every column for mode 2 */ {
+        for(int y = first; y < last; ++y) {
+            const uint32_t* src = reinterpret_cast<const uint32_t*>(src_data + ((y * 2) * src_bpl));
+            std::memcpy(_source.row(y), src, w * sizeof(uint32_t));
+        }
+    }
+    _source.pad_columns(first, last);
+}
+
+auto Upscaler::scale2x_rows(const Plane& src, int first, int last, uint32_t* dst_data, int dst_stride) -> void
+{
+    const int w = src.w;
+
+    for(int y = first; y < last; ++y) {
+        const uint32_t* prev = src.row(y - 1);
+        const uint32_t* curr = src.row(y + 0);
+        const uint32_t* next = src.row(y + 1);
+        uint32_t*       dst0 = dst_data + (((y * 2) + 0) * dst_stride);
+        uint32_t*       dst1 = dst_data + (((y * 2) + 1) * dst_stride);
+        int             x    = 0;
+#if defined(__SSE2__)
+        /* compare the neighbours of four pixels at a time */ {
+            for(; (x + 4) <= w; x += 4) {
+                const __m128i b  = UpscalerTraits::load(prev + x);
+                const __m128i d  = UpscalerTraits::load(curr + x - 1);
+                const __m128i e  = UpscalerTraits::load(curr + x);
+                const __m128i f  = UpscalerTraits::load(curr + x + 1);
+                const __m128i h  = UpscalerTraits::load(next + x);
+                const __m128i on = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi32(b, h), _mm_cmpeq_epi32(d, f)), _mm_set1_epi32(-1));
+                const __m128i e0 = UpscalerTraits::select(_mm_and_si128(on, _mm_cmpeq_epi32(d, b)), d, e);
+                const __m128i e1 = UpscalerTraits::select(_mm_and_si128(on, _mm_cmpeq_epi32(b, f)), f, e);
+                const __m128i e2 = UpscalerTraits::select(_mm_and_si128(on, _mm_cmpeq_epi32(d, h)), d, e);
+                const __m128i e3 = UpscalerTraits::select(_mm_and_si128(on, _mm_cmpeq_epi32(h, f)), f, e);
+                UpscalerTraits::store((dst0 + (x * 2) + 0), _mm_unpacklo_epi32(e0, e1));
+                UpscalerTraits::store((dst0 + (x * 2) + 4), _mm_unpackhi_epi32(e0, e1));
+                UpscalerTraits::store((dst1 + (x * 2) + 0), _mm_unpacklo_epi32(e2, e3));
+                UpscalerTraits::store((dst1 + (x * 2) + 4), _mm_unpackhi_epi32(e2, e3));
+            }
+        }
+#endif
+        /* process the remaining pixels */ {
+            for(; x < w; ++x) {
+                const uint32_t b = prev[x];
+                const uint32_t d = curr[x - 1];
+                const uint32_t e = curr[x];
+                const uint32_t f = curr[x + 1];
+                const uint32_t h = next[x];
+                if((b != h) && (d != f)) {
+                    dst0[(x * 2) + 0] = (d == b ? d : e);
+                    dst0[(x * 2) + 1] = (b == f ? f : e);
+                    dst1[(x * 2) + 0] = (d == h ? d : e);
+                    dst1[(x * 2) + 1] = (h == f ? f : e);
+                }
+                else {
+                    dst0[(x * 2) + 0] = e;
+                    dst0[(x * 2) + 1] = e;
+                    dst1[(x * 2) + 0] = e;
+                    dst1[(x * 2) + 1] = e;
+                }
+            }
+        }
+    }
+}
+
+auto Upscaler::scale3x_rows(const Plane& src, int first, int last, uint32_t* dst_data, int dst_stride) -> void
+{
+    const int w = src.w;
+
+    for(int y = first; y < last; ++y) {
+        const uint32_t* prev = src.row(y - 1);
+        const uint32_t* curr = src.row(y + 0);
+        const uint32_t* next = src.row(y + 1);
+        uint32_t*       dst0 = dst_data + (((y * 3) + 0) * dst_stride);
+        uint32_t*       dst1 = dst_data + (((y * 3) + 1) * dst_stride);
+        uint32_t*       dst2 = dst_data + (((y * 3) + 2) * dst_stride);
+        int             x    = 0;
+#if defined(__SSE2__)
+        /* compare the neighbours of four pixels at a time */ {
+            alignas(16) uint32_t out[9][4];
+            for(; (x + 4) <= w; x += 4) {
+                const __m128i a  = UpscalerTraits::load(prev + x - 1);
+                const __m128i b  = UpscalerTraits::load(prev + x);
+                const __m128i c  = UpscalerTraits::load(prev + x + 1);
+                const __m128i d  = UpscalerTraits::load(curr + x - 1);
+                const __m128i e  = UpscalerTraits::load(curr + x);
+                const __m128i f  = UpscalerTraits::load(curr + x + 1);
+                const __m128i g  = UpscalerTraits::load(next + x - 1);
+                const __m128i h  = UpscalerTraits::load(next + x);
+                const __m128i i  = UpscalerTraits::load(next + x + 1);
+                const __m128i on = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi32(b, h), _mm_cmpeq_epi32(d, f)), _mm_set1_epi32(-1));
+                const __m128i db = _mm_and_si128(on, _mm_cmpeq_epi32(d, b));
+                const __m128i bf = _mm_and_si128(on, _mm_cmpeq_epi32(b, f));
+                const __m128i dh = _mm_and_si128(on, _mm_cmpeq_epi32(d, h));
+                const __m128i hf = _mm_and_si128(on, _mm_cmpeq_epi32(h, f));
+                const __m128i ea = _mm_cmpeq_epi32(e, a);
+                const __m128i ec = _mm_cmpeq_epi32(e, c);
+                const __m128i eg = _mm_cmpeq_epi32(e, g);
+                const __m128i ei = _mm_cmpeq_epi32(e, i);
+                const __m128i m1 = _mm_or_si128(_mm_andnot_si128(ec, db), _mm_andnot_si128(ea, bf));
+                const __m128i m3 = _mm_or_si128(_mm_andnot_si128(eg, db), _mm_andnot_si128(ea, dh));
+                const __m128i m5 = _mm_or_si128(_mm_andnot_si128(ei, bf), _mm_andnot_si128(ec, hf));
+                const __m128i m7 = _mm_or_si128(_mm_andnot_si128(ei, dh), _mm_andnot_si128(eg, hf));
+                UpscalerTraits::store(out[0], UpscalerTraits::select(db, d, e));
+                UpscalerTraits::store(out[1], UpscalerTraits::select(m1, b, e));
+                UpscalerTraits::store(out[2], UpscalerTraits::select(bf, f, e));
+                UpscalerTraits::store(out[3], UpscalerTraits::select(m3, d, e));
+                UpscalerTraits::store(out[4], e);
+                UpscalerTraits::store(out[5], UpscalerTraits::select(m5, f, e));
+                UpscalerTraits::store(out[6], UpscalerTraits::select(dh, d, e));
+                UpscalerTraits::store(out[7], UpscalerTraits::select(m7, h, e));
+                UpscalerTraits::store(out[8], UpscalerTraits::select(hf, f, e));
+                for(int lane = 0; lane < 4; ++lane) {
+                    const int col = ((x + lane) * 3);
+                    dst0[col + 0] = out[0][lane];
+                    dst0[col + 1] = out[1][lane];
+                    dst0[col + 2] = out[2][lane];
+                    dst1[col + 0] = out[3][lane];
+                    dst1[col + 1] = out[4][lane];
+                    dst1[col + 2] = out[5][lane];
+                    dst2[col + 0] = out[6][lane];
+                    dst2[col + 1] = out[7][lane];
+                    dst2[col + 2] = out[8][lane];
+                }
+            }
+        }
+#endif
+        /* process the remaining pixels */ {
+            for(; x < w; ++x) {
+                const uint32_t a   = prev[x - 1];
+                const uint32_t b   = prev[x];
+                const uint32_t c   = prev[x + 1];
+                const uint32_t d   = curr[x - 1];
+                const uint32_t e   = curr[x];
+                const uint32_t f   = curr[x + 1];
+                const uint32_t g   = next[x - 1];
+                const uint32_t h   = next[x];
+                const uint32_t i   = next[x + 1];
+                const int      col = (x * 3);
+                if((b != h) && (d != f)) {
+                    dst0[col + 0] = (d == b ? d : e);
+                    dst0[col + 1] = (((d == b) && (e != c)) || ((b == f) && (e != a)) ? b : e);
+                    dst0[col + 2] = (b == f ? f : e);
+                    dst1[col + 0] = (((d == b) && (e != g)) || ((d == h) && (e != a)) ? d : e);
+                    dst1[col + 1] = e;
+                    dst1[col + 2] = (((b == f) && (e != i)) || ((h == f) && (e != c)) ? f : e);
+                    dst2[col + 0] = (d == h ? d : e);
+                    dst2[col + 1] = (((d == h) && (e != i)) || ((h == f) && (e != g)) ? h : e);
+                    dst2[col + 2] = (h == f ? f : e);
+                }
+                else {
+                    dst0[col + 0] = dst0[col + 1] = dst0[col + 2] = e;
+                    dst1[col + 0] = dst1[col + 1] = dst1[col + 2] = e;
+                    dst2[col + 0] = dst2[col + 1] = dst2[col + 2] = e;
+                }
+            }
+        }
+    }
+}
+
+auto Upscaler::xbr2x_rows(const Plane& src, int first, int last, uint32_t* dst_data, int dst_stride) -> void
+{
+    const int w = src.w;
+    const uint32_t* rows[5];
+
+    auto xbr2x_pixel = [&](uint32_t* dst0, uint32_t* dst1, const int col) -> void
+    {
+        dst0[(col * 2) + 0] = UpscalerTraits::xbr_corner<-1,  0,  0, -1>(rows, col);
+        dst0[(col * 2) + 1] = UpscalerTraits::xbr_corner< 0, -1,  1,  0>(rows, col);
+        dst1[(col * 2) + 0] = UpscalerTraits::xbr_corner< 0,  1, -1,  0>(rows, col);
+        dst1[(col * 2) + 1] = UpscalerTraits::xbr_corner< 1,  0,  0,  1>(rows, col);
+    };
+
+    for(int y = first; y < last; ++y) {
+        uint32_t* dst0 = dst_data + (((y * 2) + 0) * dst_stride);
+        uint32_t* dst1 = dst_data + (((y * 2) + 1) * dst_stride);
+        int       x    = 0;
+        for(int dy = -2; dy <= 2; ++dy) {
+            rows[dy + 2] = src.row(y + dy);
+        }
+#if defined(__SSE2__)
+        /* skip flat areas four pixels at a time */ {
+            for(; (x + 4) <= w; x += 4) {
+                const __m128i b  = UpscalerTraits::load(rows[1] + x);
+                const __m128i d  = UpscalerTraits::load(rows[2] + x - 1);
+                const __m128i e  = UpscalerTraits::load(rows[2] + x);
+                const __m128i f  = UpscalerTraits::load(rows[2] + x + 1);
+                const __m128i h  = UpscalerTraits::load(rows[3] + x);
+                const __m128i eq = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi32(e, b), _mm_cmpeq_epi32(e, d)), _mm_and_si128(_mm_cmpeq_epi32(e, f), _mm_cmpeq_epi32(e, h)));
+                if(_mm_movemask_epi8(eq) == 0xffff) {
+                    UpscalerTraits::store((dst0 + (x * 2) + 0), _mm_unpacklo_epi32(e, e));
+                    UpscalerTraits::store((dst0 + (x * 2) + 4), _mm_unpackhi_epi32(e, e));
+                    UpscalerTraits::store((dst1 + (x * 2) + 0), _mm_unpacklo_epi32(e, e));
+                    UpscalerTraits::store((dst1 + (x * 2) + 4), _mm_unpackhi_epi32(e, e));
+                }
+                else {
+                    xbr2x_pixel(dst0, dst1, (x + 0));
+                    xbr2x_pixel(dst0, dst1, (x + 1));
+                    xbr2x_pixel(dst0, dst1, (x + 2));
+                    xbr2x_pixel(dst0, dst1, (x + 3));
+                }
+            }
+        }
+#endif
+        /* process the remaining pixels */ {
+            for(; x < w; ++x) {
+                xbr2x_pixel(dst0, dst1, x);
+            }
+        }
+    }
+}
+
+auto Upscaler::double_rows(uint32_t* dst_data, int dst_stride, int first, int last) -> void
+{
+    const int w = (_source.w * get_factor());
+
+    for(int y = first; y < last; ++y) {
+        const uint32_t* src = dst_data + (((y * 2) + 0) * dst_stride);
+        uint32_t*       dst = dst_data + (((y * 2) + 1) * dst_stride);
+        std::memcpy(dst, src, w * sizeof(uint32_t));
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,138 @@
+/*
+ * dpy-upscaler.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_DPY_UPSCALER_H__
+#define __XCPC_DPY_UPSCALER_H__
+
+#include <xcpc/amstrad/dpy/dpy-workers.h>
+
+// ---------------------------------------------------------------------------
+// dpy::Upscaler
+// ---------------------------------------------------------------------------
+
+namespace dpy {
+
+class Upscaler
+{
+public: // public types
+    enum Mode
+    {
+        MODE_NONE    = 0,
+        MODE_SCALE2X = 1,
+        MODE_SCALE3X = 2,
+        MODE_SCALE4X = 3,
+        MODE_XBR2X   = 4,
+    };
+
+public: // public interface
+    Upscaler(Workers& workers);
+
+    Upscaler(Upscaler&&) = delete;
+
+    Upscaler(const Upscaler&) = delete;
+
+    Upscaler& operator=(Upscaler&&) = delete;
+
+    Upscaler& operator=(const Upscaler&) = delete;
+
+    virtual ~Upscaler();
+
+    auto set_mode(int mode) -> bool;
+
+    auto process(const uint8_t* src_data, int src_bpl, int src_w, int src_h, uint8_t* dst_data, int dst_bpl) -> bool;
+
+    auto reset() -> void;
+
+    auto get_mode() const -> int
+    {
+        return _mode;
+    }
+
+    auto is_enabled() const -> bool
+    {
+        return _mode != MODE_NONE;
+    }
+
+    auto get_factor() const -> int;
+
+    auto get_output_width(int src_w) const -> int
+    {
+        return src_w * get_factor();
+    }
+
+    auto get_output_height(int src_h) const -> int
+    {
+        return ((src_h / 2) * get_factor()) * 2;
+    }
+
+    auto get_elapsed_us() const -> unsigned long
+    {
+        return _elapsed_us;
+    }
+
+public: // public types
+    struct Plane
+    {
+        static constexpr int BORDER = 2;
+
+        int                   w      = 0;
+        int                   h      = 0;
+        int                   stride = 0;
+        std::vector<uint32_t> data;
+
+        auto resize(int width, int height) -> void;
+
+        auto pad_columns(int first, int last) -> void;
+
+        auto pad_rows() -> void;
+
+        auto row(int y) -> uint32_t*
+        {
+            return &data[((y + BORDER) * stride) + BORDER];
+        }
+
+        auto row(int y) const -> const uint32_t*
+        {
+            return &data[((y + BORDER) * stride) + BORDER];
+        }
+    };
+
+private: // private interface
+    auto gather_rows(const uint8_t* src_data, int src_bpl, int first, int last) -> void;
+
+    auto scale2x_rows(const Plane& src, int first, int last, uint32_t* dst_data, int dst_stride) -> void;
+
+    auto scale3x_rows(const Plane& src, int first, int last, uint32_t* dst_data, int dst_stride) -> void;
+
+    auto xbr2x_rows(const Plane& src, int first, int last, uint32_t* dst_data, int dst_stride) -> void;
+
+    auto double_rows(uint32_t* dst_data, int dst_stride, int first, int last) -> void;
+
+private: // private data
+    Workers&      _workers;
+    int           _mode;
+    unsigned long _elapsed_us;
+    Plane         _source;
+    Plane         _middle;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_DPY_UPSCALER_H__ */
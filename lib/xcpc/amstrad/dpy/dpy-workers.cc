@@ -0,0 +1,167 @@
+/*
+ * dpy-workers.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <xcpc/libxcpc-priv.h>
+#include "dpy-workers.h"
+
+// ---------------------------------------------------------------------------
+// dpy::Workers
+// ---------------------------------------------------------------------------
+
+namespace dpy {
+
+Workers::Workers()
+    : _mutex()
+    , _wakeup()
+    , _finish()
+    , _threads()
+    , _function(nullptr)
+    , _concurrency(1)
+    , _count(0)
+    , _bands(0)
+    , _next_band(0)
+    , _done_bands(0)
+    , _generation(0)
+    , _running(false)
+{
+    const int concurrency = static_cast<int>(std::thread::hardware_concurrency());
+
+    if(concurrency > MAXIMUM_CONCURRENCY) {
+        _concurrency = MAXIMUM_CONCURRENCY;
+    }
+    else if(concurrency > 1) {
+        _concurrency = concurrency;
+    }
+}
+
+Workers::~Workers()
+{
+    stop();
+}
+
+auto Workers::run(int count, const Function& function) -> void
+{
+    xcpc::MutexLock lock(_mutex);
+
+    auto run_inline = [&]() -> void
+    {
+        lock.unlock();
+        function(0, count);
+    };
+
+    auto run_parallel = [&]() -> void
+    {
+        _function   = &function;
+        _count      = count;
+        _bands      = (count < _concurrency ? count : _concurrency);
+        _next_band  = 0;
+        _done_bands = 0;
+        ++_generation;
+        _wakeup.notify_all();
+        work(lock);
+        while(_done_bands < _bands) {
+            _finish.wait(lock);
+        }
+        _function = nullptr;
+    };
+
+    if(count <= 0) {
+        return;
+    }
+    if((_concurrency <= 1) || (count < 2)) {
+        return run_inline();
+    }
+    if(_running == false) {
+        lock.unlock();
+        start();
+        lock.lock();
+    }
+    return run_parallel();
+}
+
+auto Workers::start() -> void
+{
+    _running = true;
+    for(int index = 1; index < _concurrency; ++index) {
+        _threads.emplace_back(&Workers::loop, this);
+    }
+}
+
+auto Workers::stop() -> void
+{
+    /* wake up the threads */ {
+        xcpc::MutexLock lock(_mutex);
+        _running = false;
+        _wakeup.notify_all();
+    }
+    for(auto& thread : _threads) {
+        thread.join();
+    }
+    _threads.clear();
+}
+
+auto Workers::loop() -> void
+{
+    xcpc::MutexLock lock(_mutex);
+    unsigned int    generation = _generation;
+
+    while(true) {
+        while((_running != false) && (_generation == generation)) {
+            _wakeup.wait(lock);
+        }
+        if(_running == false) {
+            break;
+        }
+        generation = _generation;
+        work(lock);
+    }
+}
+
+auto Workers::work(xcpc::MutexLock& lock) -> void
+{
+    while(_next_band < _bands) {
+        const int band  = _next_band++;
+        const int first = ((_count * (band + 0)) / _bands);
+        const int last  = ((_count * (band + 1)) / _bands);
+        const Function& function(*_function);
+        lock.unlock();
+        function(first, last);
+        lock.lock();
+        if(++_done_bands == _bands) {
+            _finish.notify_all();
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+/*
+ * dpy-workers.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_DPY_WORKERS_H__
+#define __XCPC_DPY_WORKERS_H__
+
+// ---------------------------------------------------------------------------
+// dpy::Workers
+// ---------------------------------------------------------------------------
+
+namespace dpy {
+
+class Workers
+{
+public: // public types
+    using Function = std::function<void(int first, int last)>;
+
+public: // public interface
+    Workers();
+
+    Workers(Workers&&) = delete;
+
+    Workers(const Workers&) = delete;
+
+    Workers& operator=(Workers&&) = delete;
+
+    Workers& operator=(const Workers&) = delete;
+
+    virtual ~Workers();
+
+    auto run(int count, const Function& function) -> void;
+
+    auto get_concurrency() const -> int
+    {
+        return _concurrency;
+    }
+
+private: // private interface
+    auto start() -> void;
+
+    auto stop() -> void;
+
+    auto loop() -> void;
+
+    auto work(xcpc::MutexLock& lock) -> void;
+
+private: // private types
+    using Thread    = std::thread;
+    using Threads   = std::vector<Thread>;
+    using Condition = std::condition_variable;
+
+    static constexpr int MAXIMUM_CONCURRENCY = 4;
+
+private: // private data
+    xcpc::Mutex     _mutex;
+    Condition       _wakeup;
+    Condition       _finish;
+    Threads         _threads;
+    const Function* _function;
+    int             _concurrency;
+    int             _count;
+    int             _bands;
+    int             _next_band;
+    int             _done_bands;
+    unsigned int    _generation;
+    bool            _running;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_DPY_WORKERS_H__ */
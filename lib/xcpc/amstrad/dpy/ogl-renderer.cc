@@ -109,16 +109,24 @@ const char* const RendererTraits::fragment_shader_std_src = R"(\
 in  vec2 v_texcoord;
 out vec4 v_fragment;
 uniform sampler2D u_texture;
+uniform sampler2D u_previous;
+uniform float u_blending;
 uniform vec2 u_texture_size;
 uniform vec2 u_visible_position;
 uniform vec2 u_visible_size;
 
+/* blend the current frame with the previous one */
+vec4 sample_frame(vec2 tc)
+{
+    return mix(texture(u_texture, tc), texture(u_previous, tc), u_blending);
+}
+
 void main()
 {
     vec2 visible_tc;
     visible_tc.x = (u_visible_position.x + v_texcoord.x * u_visible_size.x) / u_texture_size.x;
     visible_tc.y = (u_visible_position.y + v_texcoord.y * u_visible_size.y) / u_texture_size.y;
-    v_fragment = texture(u_texture, visible_tc);
+    v_fragment = sample_frame(visible_tc);
 }
 )";
 
@@ -127,6 +135,8 @@ const char* const RendererTraits::fragment_shader_crt_src = R"(\
 in  vec2 v_texcoord;
 out vec4 v_fragment;
 uniform sampler2D u_texture;
+uniform sampler2D u_previous;
+uniform float u_blending;
 uniform vec2 u_texture_size;
 uniform vec2 u_visible_position;
 uniform vec2 u_visible_size;
@@ -139,6 +149,12 @@ uniform float u_dotmask;
 uniform float u_vignetting;
 uniform float u_brightness;
 
+/* blend the current frame with the previous one */
+vec4 sample_frame(vec2 tc)
+{
+    return mix(texture(u_texture, tc), texture(u_previous, tc), u_blending);
+}
+
 /* barrel distortion for CRT screen */
 vec2 crt_curvature(vec2 uv)
 {
@@ -176,11 +192,11 @@ void main()
     /* sample texture with subtle horizontal phosphor spread */
     float dx = u_hsampling / u_texture_size.x;
     float dy = u_vsampling / u_texture_size.y;
-    vec4 color = texture(u_texture, visible_tc) * 0.50
-               + texture(u_texture, visible_tc + vec2(dx, 0.0)) * 0.15
-               + texture(u_texture, visible_tc - vec2(dx, 0.0)) * 0.15
-               + texture(u_texture, visible_tc + vec2(0.0, dy)) * 0.10
-               + texture(u_texture, visible_tc - vec2(0.0, dy)) * 0.10
+    vec4 color = sample_frame(visible_tc) * 0.50
+               + sample_frame(visible_tc + vec2(dx, 0.0)) * 0.15
+               + sample_frame(visible_tc - vec2(dx, 0.0)) * 0.15
+               + sample_frame(visible_tc + vec2(0.0, dy)) * 0.10
+               + sample_frame(visible_tc - vec2(0.0, dy)) * 0.10
                ;
 
     /* apply CRT scanlines */
@@ -218,10 +234,18 @@ namespace ogl {
 Renderer::Renderer()
     : dpy::Renderer()
     , _parameters()
+    , _upload()
+    , _output()
+    , _streaming()
     , _program()
     , _texture()
+    , _previous()
     , _vao()
     , _vbo()
+    , _pbo()
+    , _workers()
+    , _upscaler(_workers)
+    , _upscaled()
 {
 }
 
@@ -293,11 +317,29 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
         }
     };
 
+    auto gl_set_u_previous = [&]() -> void
+    {
+        const GLint u_previous = _program.get_uniform_location("u_previous");
+        const GLint v_previous = 1;
+        if(u_previous >= 0) {
+            _program.set_uniform_1i(u_previous, v_previous);
+        }
+    };
+
+    auto gl_set_u_blending = [&]() -> void
+    {
+        const GLint   u_blending = _program.get_uniform_location("u_blending");
+        const GLfloat v_blending = (_parameters.frame_blending != false ? 0.5f : 0.0f);
+        if(u_blending >= 0) {
+            _program.set_uniform_1f(u_blending, v_blending);
+        }
+    };
+
     auto gl_set_u_texture_size = [&]() -> void
     {
         const GLint   u_texture_size   = _program.get_uniform_location("u_texture_size");
-        const GLfloat v_texture_size_w = _state.image_width;
-        const GLfloat v_texture_size_h = _state.image_height;
+        const GLfloat v_texture_size_w = _upload.w;
+        const GLfloat v_texture_size_h = _upload.h;
         if(u_texture_size >= 0) {
             _program.set_uniform_2f(u_texture_size, v_texture_size_w, v_texture_size_h);
         }
@@ -306,8 +348,8 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
     auto gl_set_u_visible_position = [&]() -> void
     {
         const GLint   u_visible_position   = _program.get_uniform_location("u_visible_position");
-        const GLfloat u_visible_position_x = _state.visible_x;
-        const GLfloat u_visible_position_y = _state.visible_y;
+        const GLfloat u_visible_position_x = 0.0f;
+        const GLfloat u_visible_position_y = 0.0f;
         if(u_visible_position >= 0) {
             _program.set_uniform_2f(u_visible_position, u_visible_position_x, u_visible_position_y);
         }
@@ -316,8 +358,8 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
     auto gl_set_u_visible_size = [&]() -> void
     {
         const GLint   u_visible_size   = _program.get_uniform_location("u_visible_size");
-        const GLfloat u_visible_size_w = _state.visible_w;
-        const GLfloat u_visible_size_h = _state.visible_h;
+        const GLfloat u_visible_size_w = _upload.w;
+        const GLfloat u_visible_size_h = _upload.h;
         if(u_visible_size >= 0) {
             _program.set_uniform_2f(u_visible_size, u_visible_size_w, u_visible_size_h);
         }
@@ -413,6 +455,8 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
             _parameters.dirty_uniforms = false;
             if(_program != false) {
                 gl_set_u_texture();
+                gl_set_u_previous();
+                gl_set_u_blending();
                 gl_set_u_texture_size();
                 gl_set_u_visible_position();
                 gl_set_u_visible_size();
@@ -435,11 +479,16 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
 
     auto gl_draw_geometry = [&]() -> void
     {
-        _texture.bind_texture(GL_TEXTURE_2D);
+        _previous.active_texture(GL_TEXTURE1);
+        _previous.bind_texture(GL_TEXTURE_2D);
         _texture.active_texture(GL_TEXTURE0);
+        _texture.bind_texture(GL_TEXTURE_2D);
         _vao.bind_vertex_array();
         _vao.draw_vertex_array(GL_TRIANGLE_STRIP, 0, 4);
         _vao.unbind_vertex_array();
+        _previous.active_texture(GL_TEXTURE1);
+        _previous.unbind_texture(GL_TEXTURE_2D);
+        _texture.active_texture(GL_TEXTURE0);
         _texture.unbind_texture(GL_TEXTURE_2D);
     };
 
@@ -461,9 +510,29 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
 
 auto Renderer::render() -> void
 {
+    const bool readback = ((_state.image_readback != false) || (_upscaler.is_enabled() != false));
+
+    if(readback != _streaming.readback) {
+        _parameters.dirty_texture = true;
+    }
+    if(_parameters.dirty_texture != false) {
+        _parameters.dirty_texture = false;
+        if(_texture != false) {
+            delete_texture();
+            delete_image();
+            create_image();
+            create_texture();
+            _parameters.dirty_uniforms = true;
+        }
+        return;
+    }
     ogl_update_texture();
 }
 
+auto Renderer::notify(const XEvent& event) -> void
+{
+}
+
 auto Renderer::set_visible_area(int x, int y, int w, int h) -> void
 {
     const int old_visible_x = _state.visible_x;
@@ -481,6 +550,7 @@ auto Renderer::set_visible_area(int x, int y, int w, int h) -> void
     || (new_visible_h != old_visible_h)) {
         _parameters.dirty_program  |= false;
         _parameters.dirty_uniforms |= true;
+        _parameters.dirty_texture  |= true;
     }
 }
 
@@ -509,11 +579,29 @@ auto Renderer::set_parameterb(const std::string& parameter, bool value) -> void
             _parameters.dirty_program  |= true;
             _parameters.dirty_uniforms |= true;
         }
+        return;
+    }
+    if(parameter == "video.ogl.frame_blending") {
+        const bool old_frame_blending = _parameters.frame_blending;
+        const bool new_frame_blending = _parameters.frame_blending = value;
+        if(new_frame_blending != old_frame_blending) {
+            _parameters.dirty_program  |= false;
+            _parameters.dirty_uniforms |= true;
+        }
+        return;
     }
 }
 
 auto Renderer::set_parameteri(const std::string& parameter, int value) -> void
 {
+    if((parameter == "video.upscaler") || (parameter == "video.ogl.upscaler")) {
+        if(_upscaler.set_mode(value) != false) {
+            _parameters.dirty_program  |= false;
+            _parameters.dirty_uniforms |= true;
+            _parameters.dirty_texture  |= true;
+        }
+        return;
+    }
 }
 
 auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
@@ -529,7 +617,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         return value;
     };
 
-    if(parameter == "video.ogl.u_hsampling") {
+    if((parameter == "video.u_hsampling") || (parameter == "video.ogl.u_hsampling")) {
         const float old_hsampling = _parameters.u_hsampling;
         const float new_hsampling = _parameters.u_hsampling = clampf(value, 0.0f, 5.0f);
         if(new_hsampling != old_hsampling) {
@@ -538,7 +626,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         }
         return;
     }
-    if(parameter == "video.ogl.u_vsampling") {
+    if((parameter == "video.u_vsampling") || (parameter == "video.ogl.u_vsampling")) {
         const float old_vsampling = _parameters.u_vsampling;
         const float new_vsampling = _parameters.u_vsampling = clampf(value, 0.0f, 5.0f);
         if(new_vsampling != old_vsampling) {
@@ -547,7 +635,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         }
         return;
     }
-    if(parameter == "video.ogl.u_curvature") {
+    if((parameter == "video.u_curvature") || (parameter == "video.ogl.u_curvature")) {
         const float old_curvature = _parameters.u_curvature;
         const float new_curvature = _parameters.u_curvature = clampf(value, 0.0f, 1.0f);
         if(new_curvature != old_curvature) {
@@ -556,7 +644,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         }
         return;
     }
-    if(parameter == "video.ogl.u_corner") {
+    if((parameter == "video.u_corner") || (parameter == "video.ogl.u_corner")) {
         const float old_corner = _parameters.u_corner;
         const float new_corner = _parameters.u_corner = clampf(value, 0.0f, 1.0f);
         if(new_corner != old_corner) {
@@ -565,7 +653,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         }
         return;
     }
-    if(parameter == "video.ogl.u_dotline") {
+    if((parameter == "video.u_dotline") || (parameter == "video.ogl.u_dotline")) {
         const float old_dotline = _parameters.u_dotline;
         const float new_dotline = _parameters.u_dotline = clampf(value, 0.0f, 1.0f);
         if(new_dotline != old_dotline) {
@@ -574,7 +662,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         }
         return;
     }
-    if(parameter == "video.ogl.u_dotmask") {
+    if((parameter == "video.u_dotmask") || (parameter == "video.ogl.u_dotmask")) {
         const float old_dotmask = _parameters.u_dotmask;
         const float new_dotmask = _parameters.u_dotmask = clampf(value, 0.0f, 1.0f);
         if(new_dotmask != old_dotmask) {
@@ -583,7 +671,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         }
         return;
     }
-    if(parameter == "video.ogl.u_vignetting") {
+    if((parameter == "video.u_vignetting") || (parameter == "video.ogl.u_vignetting")) {
         const float old_vignetting = _parameters.u_vignetting;
         const float new_vignetting = _parameters.u_vignetting = clampf(value, 0.0f, 2.0f);
         if(new_vignetting != old_vignetting) {
@@ -592,7 +680,7 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
         }
         return;
     }
-    if(parameter == "video.ogl.u_brightness") {
+    if((parameter == "video.u_brightness") || (parameter == "video.ogl.u_brightness")) {
         const float old_brightness = _parameters.u_brightness;
         const float new_brightness = _parameters.u_brightness = clampf(value, 0.0f, 2.0f);
         if(new_brightness != old_brightness) {
@@ -606,12 +694,23 @@ auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
 auto Renderer::create_image() -> void
 {
     if(_state.image_data == nullptr) {
-        _state.image_width  = DISPLAY_WIDTH;
-        _state.image_height = DISPLAY_HEIGHT;
+        _state.image_width  = get_required_image_width();
+        _state.image_height = get_required_image_height();
         _state.image_bpp    = 32;
         _state.image_bpl    = _state.image_width * 4;
-        _state.image_data   = new uint8_t[_state.image_height * _state.image_bpl];
+        _state.image_data   = nullptr;
+        _state.red_mask     = (alloc_color(0xffff, 0x0000, 0x0000) & ~alloc_color(0x0000, 0x0000, 0x0000));
+        _state.green_mask   = (alloc_color(0x0000, 0xffff, 0x0000) & ~alloc_color(0x0000, 0x0000, 0x0000));
+        _state.blue_mask    = (alloc_color(0x0000, 0x0000, 0xffff) & ~alloc_color(0x0000, 0x0000, 0x0000));
+        _streaming.readback = ((_state.image_readback != false) || (_upscaler.is_enabled() != false));
+        if(_streaming.readback == false) {
+            ogl_create_pixel_buffers();
+        }
     }
+    if(_state.image_data == nullptr) {
+        _state.image_data = new uint8_t[_state.image_height * _state.image_bpl];
+    }
+    _state.image_write_only = _streaming.enabled;
 }
 
 auto Renderer::delete_image() -> void
@@ -621,7 +720,16 @@ auto Renderer::delete_image() -> void
         _state.image_height = 0;
         _state.image_bpp    = 0;
         _state.image_bpl    = 0;
-        _state.image_data   = (delete[] _state.image_data, nullptr);
+        _state.red_mask     = 0;
+        _state.green_mask   = 0;
+        _state.blue_mask    = 0;
+        if(_streaming.enabled != false) {
+            _state.image_data = (ogl_delete_pixel_buffers(), nullptr);
+        }
+        else {
+            _state.image_data = (delete[] _state.image_data, nullptr);
+        }
+        _state.image_write_only = false;
     }
 }
 
@@ -639,6 +747,32 @@ auto Renderer::delete_program() -> void
 
 auto Renderer::create_texture() -> void
 {
+    const int visible_x2 = (_state.visible_x + _state.visible_w);
+    const int visible_y2 = (_state.visible_y + _state.visible_h);
+
+    if((_state.visible_w > 0) && (_state.visible_h > 0)
+    && (visible_x2 <= _state.image_width) && (visible_y2 <= _state.image_height)) {
+        _upload.x = _state.visible_x;
+        _upload.y = _state.visible_y;
+        _upload.w = _state.visible_w;
+        _upload.h = _state.visible_h;
+    }
+    else {
+        _upload.x = 0;
+        _upload.y = 0;
+        _upload.w = _state.image_width;
+        _upload.h = _state.image_height;
+    }
+    if(_upscaler.is_enabled() != false) {
+        _output.w = _upscaler.get_output_width(_upload.w);
+        _output.h = _upscaler.get_output_height(_upload.h);
+        _upscaled.resize(_output.w * _output.h);
+    }
+    else {
+        _output.w = _upload.w;
+        _output.h = _upload.h;
+        _upscaled.clear();
+    }
     ogl_create_texture();
     ogl_upload_texture();
 }
@@ -646,6 +780,7 @@ auto Renderer::create_texture() -> void
 auto Renderer::delete_texture() -> void
 {
     ogl_delete_texture();
+    _upscaler.reset();
 }
 
 auto Renderer::create_geometry() -> void
@@ -701,35 +836,198 @@ auto Renderer::ogl_delete_program() -> void
 auto Renderer::ogl_create_texture() -> void
 {
     _texture.create_texture();
+    _previous.create_texture();
 }
 
 auto Renderer::ogl_delete_texture() -> void
 {
+    _previous.delete_texture();
     _texture.delete_texture();
 }
 
 auto Renderer::ogl_upload_texture() -> void
 {
-    constexpr GLint filter = GL_LINEAR;
+    constexpr GLint             filter = GL_LINEAR;
+    const std::vector<uint32_t> blank((_output.w * _output.h), 0xff000000u);
 
-    if(_texture != false) {
-        _texture.bind_texture(GL_TEXTURE_2D);
-        _texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
-        _texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
-        _texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        _texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        _texture.tex_image_2d(GL_TEXTURE_2D, 0, GL_RGBA, _state.image_width, _state.image_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, _state.image_data);
-        _texture.unbind_texture(GL_TEXTURE_2D);
+    auto upload = [&](Texture& texture) -> void
+    {
+        if(texture != false) {
+            texture.bind_texture(GL_TEXTURE_2D);
+            texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+            texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+            texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            texture.tex_parameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            texture.tex_image_2d(GL_TEXTURE_2D, 0, GL_RGBA, _output.w, _output.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, blank.data());
+            texture.unbind_texture(GL_TEXTURE_2D);
+        }
+    };
+
+    /* start from a black frame so that frame blending never mixes undefined texels */ {
+        upload(_texture);
+        upload(_previous);
     }
 }
 
 auto Renderer::ogl_update_texture() -> void
 {
-    if(_texture != false) {
+    const uintptr_t offset = ((_upload.y * _state.image_bpl) + (_upload.x * 4));
+
+    auto update_from_pixel_buffer = [&]() -> void
+    {
+        auto& pbo(_pbo[_streaming.index]);
+
+        if(_streaming.persistent == false) {
+            pbo.unmap_buffer();
+        }
+        pbo.bind_pixel_buffer();
         _texture.bind_texture(GL_TEXTURE_2D);
-        _texture.tex_sub_image_2d(GL_TEXTURE_2D, 0, 0, 0, _state.image_width, _state.image_height, GL_RGBA, GL_UNSIGNED_BYTE, _state.image_data);
+        ::glPixelStorei(GL_UNPACK_ROW_LENGTH, _state.image_width);
+        _texture.tex_sub_image_2d(GL_TEXTURE_2D, 0, 0, 0, _upload.w, _upload.h, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<void*>(offset));
+        ::glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
         _texture.active_texture(GL_TEXTURE0);
         _texture.unbind_texture(GL_TEXTURE_2D);
+        pbo.unbind_pixel_buffer();
+        pbo.insert_fence();
+        ogl_swap_pixel_buffers();
+    };
+
+    auto update_from_client_memory = [&]() -> void
+    {
+        _texture.bind_texture(GL_TEXTURE_2D);
+        ::glPixelStorei(GL_UNPACK_ROW_LENGTH, _state.image_width);
+        _texture.tex_sub_image_2d(GL_TEXTURE_2D, 0, 0, 0, _upload.w, _upload.h, GL_RGBA, GL_UNSIGNED_BYTE, _state.image_data + offset);
+        ::glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        _texture.active_texture(GL_TEXTURE0);
+        _texture.unbind_texture(GL_TEXTURE_2D);
+    };
+
+    auto update_from_upscaled_memory = [&]() -> void
+    {
+        uint8_t* upscaled = reinterpret_cast<uint8_t*>(_upscaled.data());
+        if(_upscaler.process((_state.image_data + offset), _state.image_bpl, _upload.w, _upload.h, upscaled, (_output.w * 4)) != false) {
+            _state.upscale_us     += _upscaler.get_elapsed_us();
+            _state.upscale_frames += 1;
+        }
+        _texture.bind_texture(GL_TEXTURE_2D);
+        _texture.tex_sub_image_2d(GL_TEXTURE_2D, 0, 0, 0, _output.w, _output.h, GL_RGBA, GL_UNSIGNED_BYTE, upscaled);
+        _texture.active_texture(GL_TEXTURE0);
+        _texture.unbind_texture(GL_TEXTURE_2D);
+    };
+
+    auto keep_previous_frame = [&]() -> void
+    {
+        if(_parameters.frame_blending != false) {
+            _texture.swap(_previous);
+        }
+    };
+
+    if(_texture != false) {
+        keep_previous_frame();
+        if(_streaming.enabled != false) {
+            update_from_pixel_buffer();
+        }
+        else if(_upscaler.is_enabled() != false) {
+            update_from_upscaled_memory();
+        }
+        else {
+            update_from_client_memory();
+        }
+    }
+}
+
+auto Renderer::ogl_create_pixel_buffers() -> void
+{
+    const GLsizeiptr size = _state.image_height * _state.image_bpl;
+
+    auto has_buffer_storage = [&]() -> bool
+    {
+        if(::epoxy_gl_version() >= 44) {
+            return true;
+        }
+        if(::epoxy_has_gl_extension("GL_ARB_buffer_storage")) {
+            return true;
+        }
+        return false;
+    };
+
+    auto create_persistent_buffer = [&](PixelBuffer& pbo) -> bool
+    {
+        constexpr GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+        pbo.create_pixel_buffer();
+        pbo.bind_pixel_buffer();
+        pbo.buffer_storage(size, nullptr, flags);
+        pbo.unbind_pixel_buffer();
+
+        return pbo.map_buffer_range(0, size, flags) != nullptr;
+    };
+
+    auto create_streaming_buffer = [&](PixelBuffer& pbo) -> bool
+    {
+        pbo.create_pixel_buffer();
+        pbo.bind_pixel_buffer();
+        pbo.upload_data(size, nullptr, GL_STREAM_DRAW);
+        pbo.unbind_pixel_buffer();
+
+        return pbo != false;
+    };
+
+    auto create_buffers = [&](const bool persistent) -> bool
+    {
+        for(auto& pbo : _pbo) {
+            const bool created = (persistent != false ? create_persistent_buffer(pbo) : create_streaming_buffer(pbo));
+            if(created == false) {
+                for(auto& other : _pbo) {
+                    other.delete_pixel_buffer();
+                }
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if(_streaming.enabled == false) {
+        _streaming.index = 0;
+        if((has_buffer_storage() != false) && (create_buffers(true) != false)) {
+            _streaming.enabled    = true;
+            _streaming.persistent = true;
+        }
+        else if(create_buffers(false) != false) {
+            _streaming.enabled    = true;
+            _streaming.persistent = false;
+        }
+        if(_streaming.enabled != false) {
+            _streaming.index = (PIXEL_BUFFER_COUNT - 1);
+            ogl_swap_pixel_buffers();
+        }
+    }
+}
+
+auto Renderer::ogl_delete_pixel_buffers() -> void
+{
+    if(_streaming.enabled != false) {
+        for(auto& pbo : _pbo) {
+            pbo.delete_pixel_buffer();
+        }
+        _streaming.enabled    = false;
+        _streaming.persistent = false;
+        _streaming.index      = 0;
+    }
+}
+
+auto Renderer::ogl_swap_pixel_buffers() -> void
+{
+    constexpr GLbitfield flags = (GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    if(_streaming.enabled != false) {
+        _streaming.index = ((_streaming.index + 1) % PIXEL_BUFFER_COUNT);
+        auto& pbo(_pbo[_streaming.index]);
+        pbo.wait_fence();
+        if(_streaming.persistent == false) {
+            pbo.map_buffer_range(0, _state.image_height * _state.image_bpl, flags);
+        }
+        _state.image_data = pbo.get_data();
     }
 }
 
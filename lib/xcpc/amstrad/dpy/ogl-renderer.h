@@ -19,6 +19,7 @@
 
 #include <xcpc/amstrad/dpy/dpy-core.h>
 #include <xcpc/amstrad/dpy/ogl-wrapper.h>
+#include <xcpc/amstrad/dpy/dpy-upscaler.h>
 
 // ---------------------------------------------------------------------------
 // ogl::Renderer
@@ -52,6 +53,8 @@ public: // public interface
 
     virtual auto render() -> void override final;
 
+    virtual auto notify(const XEvent& event) -> void override final;
+
     virtual auto set_visible_area(int x, int y, int w, int h) -> void override final;
 
     virtual auto alloc_color(uint16_t r, uint16_t g, uint16_t b) -> uint32_t override final;
@@ -109,6 +112,12 @@ private: // private interface
 
     auto ogl_update_texture() -> void;
 
+    auto ogl_create_pixel_buffers() -> void;
+
+    auto ogl_delete_pixel_buffers() -> void;
+
+    auto ogl_swap_pixel_buffers() -> void;
+
     auto ogl_create_vertex_array() -> void;
 
     auto ogl_delete_vertex_array() -> void;
@@ -133,8 +142,10 @@ private: // private types
     struct Parameters
     {
         bool  crt_emulation  = false;
+        bool  frame_blending = false;
         bool  dirty_program  = false;
         bool  dirty_uniforms = false;
+        bool  dirty_texture  = false;
         float u_hsampling    = 0.75f;
         float u_vsampling    = 0.25f;
         float u_curvature    = 0.10f;
@@ -145,12 +156,48 @@ private: // private types
         float u_brightness   = 1.30f;
     };
 
+    struct Upload
+    {
+        int x = 0;
+        int y = 0;
+        int w = 0;
+        int h = 0;
+    };
+
+    struct Output
+    {
+        int w = 0;
+        int h = 0;
+    };
+
+    struct Streaming
+    {
+        bool enabled    = false;
+        bool persistent = false;
+        bool readback   = false;
+        int  index      = 0;
+    };
+
+    static constexpr int PIXEL_BUFFER_COUNT = 3;
+
+    using Workers  = dpy::Workers;
+    using Upscaler = dpy::Upscaler;
+    using Upscaled = std::vector<uint32_t>;
+
 private: // private data
     Parameters   _parameters;
+    Upload       _upload;
+    Output       _output;
+    Streaming    _streaming;
     Program      _program;
-    Texture      _texture; 
+    Texture      _texture;
+    Texture      _previous;
     VertexArray  _vao;
     VertexBuffer _vbo;
+    PixelBuffer  _pbo[PIXEL_BUFFER_COUNT];
+    Workers      _workers;
+    Upscaler     _upscaler;
+    Upscaled     _upscaled;
 };
 
 }
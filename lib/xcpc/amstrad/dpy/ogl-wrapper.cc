@@ -429,6 +429,122 @@ auto VertexBuffer::vertex_attrib_pointer(GLuint index, GLint size, GLenum type,
 
 }
 
+// ---------------------------------------------------------------------------
+// ogl::PixelBuffer
+// ---------------------------------------------------------------------------
+
+namespace ogl {
+
+PixelBuffer::PixelBuffer(GLuint handle)
+    : Handle(handle)
+    , _fence(nullptr)
+    , _data(nullptr)
+{
+}
+
+PixelBuffer::~PixelBuffer()
+{
+    delete_pixel_buffer();
+}
+
+auto PixelBuffer::create_pixel_buffer() -> void
+{
+    if(_handle == 0u) {
+        ::glGenBuffers(1, &_handle);
+    }
+}
+
+auto PixelBuffer::delete_pixel_buffer() -> void
+{
+    if(_handle != 0u) {
+        delete_fence();
+        unmap_buffer();
+        _handle = (::glDeleteBuffers(1, &_handle), 0u);
+    }
+}
+
+auto PixelBuffer::bind_pixel_buffer() -> void
+{
+    if(_handle != 0u) {
+        ::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _handle);
+    }
+}
+
+auto PixelBuffer::unbind_pixel_buffer() -> void
+{
+    if(_handle != 0u) {
+        ::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0u);
+    }
+}
+
+auto PixelBuffer::upload_data(GLsizeiptr size, const void* data, GLenum usage) -> void
+{
+    if(_handle != 0u) {
+        ::glBufferData(GL_PIXEL_UNPACK_BUFFER, size, data, usage);
+    }
+}
+
+auto PixelBuffer::buffer_storage(GLsizeiptr size, const void* data, GLbitfield flags) -> void
+{
+    if(_handle != 0u) {
+        ::glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, data, flags);
+    }
+}
+
+auto PixelBuffer::map_buffer_range(GLintptr offset, GLsizeiptr length, GLbitfield access) -> void*
+{
+    if((_handle != 0u) && (_data == nullptr)) {
+        ::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _handle);
+        _data = static_cast<uint8_t*>(::glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, length, access));
+        ::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0u);
+    }
+    return _data;
+}
+
+auto PixelBuffer::unmap_buffer() -> void
+{
+    if((_handle != 0u) && (_data != nullptr)) {
+        ::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _handle);
+        ::glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        ::glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0u);
+        _data = nullptr;
+    }
+}
+
+auto PixelBuffer::insert_fence() -> void
+{
+    if(_handle != 0u) {
+        delete_fence();
+        _fence = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+auto PixelBuffer::wait_fence() -> void
+{
+    constexpr GLuint64 timeout = 1000000ULL; /* 1ms in nanoseconds */
+
+    if(_fence != nullptr) {
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        for(;;) {
+            const GLenum status = ::glClientWaitSync(_fence, flags, timeout);
+            if((status == GL_ALREADY_SIGNALED) || (status == GL_CONDITION_SATISFIED) || (status == GL_WAIT_FAILED)) {
+                break;
+            }
+            flags = 0;
+        }
+        delete_fence();
+    }
+}
+
+auto PixelBuffer::delete_fence() -> void
+{
+    if(_fence != nullptr) {
+        _fence = (::glDeleteSync(_fence), nullptr);
+    }
+}
+
+}
+
 // ---------------------------------------------------------------------------
 // End-Of-File
 // ---------------------------------------------------------------------------
@@ -77,6 +77,14 @@ public: // public interface
         return (_handle = 0u, shader);
     }
 
+    auto swap(Handle& other) -> void
+    {
+        const GLuint handle = _handle;
+
+        _handle = other._handle;
+        other._handle = handle;
+    }
+
 protected: // protected data
     GLuint _handle;
 };
@@ -286,6 +294,62 @@ public: // public interface
 
 }
 
+// ---------------------------------------------------------------------------
+// ogl::PixelBuffer
+// ---------------------------------------------------------------------------
+
+namespace ogl {
+
+class PixelBuffer final
+    : public Handle
+{
+public: // public interface
+    PixelBuffer(GLuint handle = 0u);
+
+    PixelBuffer(PixelBuffer&&) = delete;
+
+    PixelBuffer(const PixelBuffer&) = delete;
+
+    PixelBuffer& operator=(PixelBuffer&&) = delete;
+
+    PixelBuffer& operator=(const PixelBuffer&) = delete;
+
+    virtual ~PixelBuffer();
+
+    auto create_pixel_buffer() -> void;
+
+    auto delete_pixel_buffer() -> void;
+
+    auto bind_pixel_buffer() -> void;
+
+    auto unbind_pixel_buffer() -> void;
+
+    auto upload_data(GLsizeiptr size, const void* data, GLenum usage) -> void;
+
+    auto buffer_storage(GLsizeiptr size, const void* data, GLbitfield flags) -> void;
+
+    auto map_buffer_range(GLintptr offset, GLsizeiptr length, GLbitfield access) -> void*;
+
+    auto unmap_buffer() -> void;
+
+    auto insert_fence() -> void;
+
+    auto wait_fence() -> void;
+
+    auto delete_fence() -> void;
+
+    auto get_data() const -> uint8_t*
+    {
+        return _data;
+    }
+
+private: // private data
+    GLsync   _fence;
+    uint8_t* _data;
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // End-Of-File
 // ---------------------------------------------------------------------------
@@ -0,0 +1,406 @@
+/*
+ * x11-filter.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cstdarg>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <xcpc/libxcpc-priv.h>
+#include "x11-filter.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::FilterTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct FilterTraits
+{
+    static inline auto clampf(float value, const float min, const float max) -> float
+    {
+        if(value < min) {
+            value = min;
+        }
+        if(value > max) {
+            value = max;
+        }
+        return value;
+    }
+
+    static inline auto smoothstep(const float edge0, const float edge1, const float value) -> float
+    {
+        if(edge0 >= edge1) {
+            return (value < edge0 ? 0.0f : 1.0f);
+        }
+        const float t = clampf(((value - edge0) / (edge1 - edge0)), 0.0f, 1.0f);
+
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    static inline auto fixed(const float value) -> uint16_t
+    {
+        return static_cast<uint16_t>(clampf(((value * 256.0f) + 0.5f), 0.0f, 65535.0f));
+    }
+
+    static inline auto mask_shift(const unsigned long mask) -> int
+    {
+        int shift = 0;
+        if(mask != 0UL) {
+            while(((mask >> shift) & 1UL) == 0UL) {
+                ++shift;
+            }
+        }
+        return shift;
+    }
+
+    static inline auto channel(const uint32_t pixel, const int shift) -> uint32_t
+    {
+        return ((pixel >> shift) & 0xff);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// x11::CrtFilter
+// ---------------------------------------------------------------------------
+
+namespace x11 {
+
+CrtFilter::CrtFilter(dpy::Workers& workers)
+    : _workers(workers)
+    , _settings()
+    , _geometry()
+    , _weights()
+    , _data(nullptr)
+    , _dirty(true)
+    , _source()
+    , _remap()
+    , _gains()
+    , _factors()
+{
+}
+
+CrtFilter::~CrtFilter()
+{
+    reset();
+}
+
+auto CrtFilter::configure(const Settings& settings) -> void
+{
+    if((settings.u_hsampling  != _settings.u_hsampling )
+    || (settings.u_vsampling  != _settings.u_vsampling )
+    || (settings.u_curvature  != _settings.u_curvature )
+    || (settings.u_corner     != _settings.u_corner    )
+    || (settings.u_dotline    != _settings.u_dotline   )
+    || (settings.u_dotmask    != _settings.u_dotmask   )
+    || (settings.u_vignetting != _settings.u_vignetting)
+    || (settings.u_brightness != _settings.u_brightness)) {
+        _settings = settings;
+        _dirty    = true;
+    }
+}
+
+auto CrtFilter::process(XImage* image, int x, int y, int w, int h) -> bool
+{
+    auto do_copy_rows = [&](int first, int last) -> void
+    {
+        copy_rows(first, last);
+    };
+
+    auto do_filter_rows = [&](int first, int last) -> void
+    {
+        filter_rows(first, last);
+    };
+
+    if(setup(image, x, y, w, h) == false) {
+        return false;
+    }
+    _workers.run(_geometry.h, do_copy_rows);
+    _workers.run(_geometry.h, do_filter_rows);
+    _data = nullptr;
+
+    return true;
+}
+
+auto CrtFilter::reset() -> void
+{
+    _geometry = Geometry();
+    _data     = nullptr;
+    _dirty    = true;
+    _source.clear();
+    _remap.clear();
+    _gains.clear();
+    _factors.clear();
+}
+
+auto CrtFilter::setup(XImage* image, int x, int y, int w, int h) -> bool
+{
+    if((image == nullptr) || (image->bits_per_pixel != 32) || (w <= 0) || (h <= 0)) {
+        return false;
+    }
+    if(((x + w) > image->width) || ((y + h) > image->height) || (x < 0) || (y < 0)) {
+        return false;
+    }
+    if((image->red_mask   >> FilterTraits::mask_shift(image->red_mask  )) != 0xff
+    || (image->green_mask >> FilterTraits::mask_shift(image->green_mask)) != 0xff
+    || (image->blue_mask  >> FilterTraits::mask_shift(image->blue_mask )) != 0xff) {
+        return false;
+    }
+    if((_geometry.x          != x)
+    || (_geometry.y          != y)
+    || (_geometry.w          != w)
+    || (_geometry.h          != h)
+    || (_geometry.bpl        != image->bytes_per_line)
+    || (_geometry.red_mask   != image->red_mask  )
+    || (_geometry.green_mask != image->green_mask)
+    || (_geometry.blue_mask  != image->blue_mask )) {
+        _geometry.x           = x;
+        _geometry.y           = y;
+        _geometry.w           = w;
+        _geometry.h           = h;
+        _geometry.bpl         = image->bytes_per_line;
+        _geometry.red_mask    = image->red_mask;
+        _geometry.green_mask  = image->green_mask;
+        _geometry.blue_mask   = image->blue_mask;
+        _geometry.red_shift   = FilterTraits::mask_shift(image->red_mask);
+        _geometry.green_shift = FilterTraits::mask_shift(image->green_mask);
+        _geometry.blue_shift  = FilterTraits::mask_shift(image->blue_mask);
+        _dirty = true;
+    }
+    if(_dirty != false) {
+        setup_tables();
+        _dirty = false;
+    }
+    _data = reinterpret_cast<uint8_t*>(image->data);
+
+    return true;
+}
+
+auto CrtFilter::setup_tables() -> void
+{
+    const int   w = _geometry.w;
+    const int   h = _geometry.h;
+    const float curvature  = _settings.u_curvature;
+    const float corner     = _settings.u_corner;
+    const float vignetting = _settings.u_vignetting;
+    const float brightness = _settings.u_brightness;
+
+    auto setup_weights = [&]() -> void
+    {
+        const float horizontal = 0.15f * FilterTraits::clampf(_settings.u_hsampling, 0.0f, 1.0f);
+        const float vertical   = 0.10f * FilterTraits::clampf(_settings.u_vsampling, 0.0f, 1.0f);
+        _weights.horizontal = FilterTraits::fixed(horizontal);
+        _weights.vertical   = FilterTraits::fixed(vertical);
+        _weights.center     = 256 - (2 * _weights.horizontal) - (2 * _weights.vertical);
+    };
+
+    auto setup_factors = [&]() -> void
+    {
+        const uint16_t full = FilterTraits::fixed(1.0f);
+        const uint16_t mask = FilterTraits::fixed(1.0f - FilterTraits::clampf(_settings.u_dotmask, 0.0f, 1.0f));
+        const float    line = (1.0f - FilterTraits::clampf(_settings.u_dotline, 0.0f, 1.0f));
+        int lanes[4];
+        for(int lane = 0; lane < 4; ++lane) {
+            uint32_t probe = 0;
+            reinterpret_cast<uint8_t*>(&probe)[lane] = 0xff;
+            if((probe & _geometry.red_mask) != 0) {
+                lanes[lane] = 0;
+            }
+            else if((probe & _geometry.green_mask) != 0) {
+                lanes[lane] = 1;
+            }
+            else if((probe & _geometry.blue_mask) != 0) {
+                lanes[lane] = 2;
+            }
+            else {
+                lanes[lane] = -1;
+            }
+        }
+        _factors.resize(2 * w * 4);
+        for(int parity = 0; parity < 2; ++parity) {
+            uint16_t* factors = &_factors[parity * w * 4];
+            for(int col = 0; col < w; ++col) {
+                for(int lane = 0; lane < 4; ++lane) {
+                    uint16_t factor = full;
+                    if(lanes[lane] >= 0) {
+                        factor = (lanes[lane] == (col % 3) ? full : mask);
+                        if(parity != 0) {
+                            factor = FilterTraits::fixed((static_cast<float>(factor) / 256.0f) * line);
+                        }
+                    }
+                    *factors++ = factor;
+                }
+            }
+        }
+    };
+
+    auto setup_rows = [&](int first, int last) -> void
+    {
+        for(int row = first; row < last; ++row) {
+            Remap*    remap = &_remap[row * w];
+            uint16_t* gains = &_gains[row * w];
+            for(int col = 0; col < w; ++col) {
+                float u = ((static_cast<float>(col) + 0.5f) / static_cast<float>(w));
+                float v = ((static_cast<float>(row) + 0.5f) / static_cast<float>(h));
+                /* apply CRT screen curvature */ {
+                    const float cx = (u - 0.5f);
+                    const float cy = (v - 0.5f);
+                    const float r2 = (cx * cx) + (cy * cy);
+                    u += (cx * curvature * r2);
+                    v += (cy * curvature * r2);
+                }
+                /* compute source pixel, the scanlines are left to the blend pass */ {
+                    const int sx = static_cast<int>(FilterTraits::clampf(u * static_cast<float>(w), 0.0f, static_cast<float>(w - 1)));
+                    const int sy = static_cast<int>(FilterTraits::clampf(v * static_cast<float>(h), 0.0f, static_cast<float>(h - 1)));
+                    remap->sx = static_cast<uint16_t>(sx);
+                    remap->sy = static_cast<uint16_t>(sy);
+                }
+                /* compute gain (corners, vignetting and brightness) */ {
+                    const float sx = FilterTraits::smoothstep(0.0f, corner, u) * (1.0f - FilterTraits::smoothstep(1.0f - corner, 1.0f, u));
+                    const float sy = FilterTraits::smoothstep(0.0f, corner, v) * (1.0f - FilterTraits::smoothstep(1.0f - corner, 1.0f, v));
+                    if((sx * sy) < 0.001f) {
+                        *gains = 0;
+                    }
+                    else {
+                        const float vx  = u * (1.0f - u);
+                        const float vy  = v * (1.0f - v);
+                        const float vig = FilterTraits::clampf(std::pow(vx * vy * 15.0f, 0.25f), 0.0f, 1.0f);
+                        *gains = FilterTraits::fixed((1.0f + ((vig - 1.0f) * vignetting)) * brightness);
+                    }
+                }
+                ++remap;
+                ++gains;
+            }
+        }
+    };
+
+    _source.resize(w * h);
+    _remap.resize(w * h);
+    _gains.resize(w * h);
+    setup_weights();
+    setup_factors();
+    _workers.run(h, setup_rows);
+}
+
+auto CrtFilter::copy_rows(int first, int last) -> void
+{
+    const int w = _geometry.w;
+
+    for(int row = first; row < last; ++row) {
+        const uint8_t* src = _data + ((_geometry.y + row) * _geometry.bpl) + (_geometry.x * 4);
+        uint32_t*      dst = &_source[row * w];
+        std::memcpy(dst, src, w * 4);
+    }
+}
+
+auto CrtFilter::filter_rows(int first, int last) -> void
+{
+    const int      w      = _geometry.w;
+    const int      h      = _geometry.h;
+    const int      rs     = _geometry.red_shift;
+    const int      gs     = _geometry.green_shift;
+    const int      bs     = _geometry.blue_shift;
+    const uint32_t wc     = _weights.center;
+    const uint32_t wh     = _weights.horizontal;
+    const uint32_t wv     = _weights.vertical;
+    const uint32_t* const source = _source.data();
+
+    auto sample = [&](const uint32_t c, const uint32_t l, const uint32_t r, const uint32_t u, const uint32_t d, const int shift, const uint32_t gain) -> uint32_t
+    {
+        const uint32_t value = ( (wc * FilterTraits::channel(c, shift))
+                               + (wh * (FilterTraits::channel(l, shift) + FilterTraits::channel(r, shift)))
+                               + (wv * (FilterTraits::channel(u, shift) + FilterTraits::channel(d, shift))) ) >> 8;
+        const uint32_t level = ((value * gain) >> 8);
+
+        return (level < 255 ? level : 255) << shift;
+    };
+
+    for(int row = first; row < last; ++row) {
+        uint8_t*        data  = _data + ((_geometry.y + row) * _geometry.bpl) + (_geometry.x * 4);
+        uint32_t*       dst   = reinterpret_cast<uint32_t*>(data);
+        const Remap*    remap = &_remap[row * w];
+        const uint16_t* gains = &_gains[row * w];
+        for(int col = 0; col < w; ++col) {
+            const uint32_t gain = *gains++;
+            const int      sx   = remap->sx;
+            const int      sy   = remap->sy;
+            ++remap;
+            if(gain == 0) {
+                *dst++ = 0;
+                continue;
+            }
+            const uint32_t* line = &source[sy * w];
+            const uint32_t  c = line[sx];
+            const uint32_t  l = line[sx > 0 ? sx - 1 : sx];
+            const uint32_t  r = line[sx < (w - 1) ? sx + 1 : sx];
+            const uint32_t  u = source[((sy >= 1) ? sy - 1 : sy) * w + sx];
+            const uint32_t  d = source[((sy + 1) < h ? sy + 1 : sy) * w + sx];
+            *dst++ = sample(c, l, r, u, d, rs, gain)
+                   | sample(c, l, r, u, d, gs, gain)
+                   | sample(c, l, r, u, d, bs, gain)
+                   ;
+        }
+        blend_row(data, (_geometry.y + row));
+    }
+}
+
+auto CrtFilter::blend_row(uint8_t* data, int row) -> void
+{
+    const int       bytes   = (_geometry.w * 4);
+    const uint16_t* factors = &_factors[(row & 1) * bytes];
+    int             index   = 0;
+
+#if defined(__SSE2__)
+    /* apply the phosphor mask and the scanlines four pixels at a time */ {
+        const __m128i zero = _mm_setzero_si128();
+        for(; (index + 16) <= bytes; index += 16) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+            const __m128i factor_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(factors + index + 0));
+            const __m128i factor_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(factors + index + 8));
+            const __m128i result_lo = _mm_mulhi_epu16(_mm_unpacklo_epi8(zero, pixels), factor_lo);
+            const __m128i result_hi = _mm_mulhi_epu16(_mm_unpackhi_epi8(zero, pixels), factor_hi);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + index), _mm_packus_epi16(result_lo, result_hi));
+        }
+    }
+#endif
+    /* apply the phosphor mask and the scanlines on the remaining bytes */ {
+        for(; index < bytes; ++index) {
+            const uint32_t value = ((static_cast<uint32_t>(data[index]) * factors[index]) >> 8);
+            data[index] = static_cast<uint8_t>(value < 255 ? value : 255);
+        }
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
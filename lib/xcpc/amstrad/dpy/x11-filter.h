@@ -0,0 +1,121 @@
+/*
+ * x11-filter.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_X11_FILTER_H__
+#define __XCPC_X11_FILTER_H__
+
+#include <xcpc/amstrad/dpy/dpy-workers.h>
+
+// ---------------------------------------------------------------------------
+// x11::CrtFilter
+// ---------------------------------------------------------------------------
+
+namespace x11 {
+
+class CrtFilter
+{
+public: // public types
+    struct Settings
+    {
+        float u_hsampling  = 0.75f;
+        float u_vsampling  = 0.25f;
+        float u_curvature  = 0.10f;
+        float u_corner     = 0.15f;
+        float u_dotline    = 0.30f;
+        float u_dotmask    = 0.10f;
+        float u_vignetting = 1.00f;
+        float u_brightness = 1.30f;
+    };
+
+public: // public interface
+    CrtFilter(dpy::Workers& workers);
+
+    CrtFilter(CrtFilter&&) = delete;
+
+    CrtFilter(const CrtFilter&) = delete;
+
+    CrtFilter& operator=(CrtFilter&&) = delete;
+
+    CrtFilter& operator=(const CrtFilter&) = delete;
+
+    virtual ~CrtFilter();
+
+    auto configure(const Settings& settings) -> void;
+
+    auto process(XImage* image, int x, int y, int w, int h) -> bool;
+
+    auto reset() -> void;
+
+private: // private interface
+    auto setup(XImage* image, int x, int y, int w, int h) -> bool;
+
+    auto setup_tables() -> void;
+
+    auto copy_rows(int first, int last) -> void;
+
+    auto filter_rows(int first, int last) -> void;
+
+    auto blend_row(uint8_t* data, int row) -> void;
+
+private: // private types
+    struct Geometry
+    {
+        int           x           = 0;
+        int           y           = 0;
+        int           w           = 0;
+        int           h           = 0;
+        int           bpl         = 0;
+        unsigned long red_mask    = 0;
+        unsigned long green_mask  = 0;
+        unsigned long blue_mask   = 0;
+        int           red_shift   = 0;
+        int           green_shift = 0;
+        int           blue_shift  = 0;
+    };
+
+    struct Remap
+    {
+        uint16_t sx;
+        uint16_t sy;
+    };
+
+    struct Weights
+    {
+        uint32_t center     = 256;
+        uint32_t horizontal = 0;
+        uint32_t vertical   = 0;
+    };
+
+private: // private data
+    dpy::Workers&         _workers;
+    Settings              _settings;
+    Geometry              _geometry;
+    Weights               _weights;
+    uint8_t*              _data;
+    bool                  _dirty;
+    std::vector<uint32_t> _source;
+    std::vector<Remap>    _remap;
+    std::vector<uint16_t> _gains;
+    std::vector<uint16_t> _factors;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_X11_FILTER_H__ */
@@ -90,8 +90,17 @@ Renderer::Renderer(Display* display, Window window, bool try_xshm)
     , _gc(nullptr)
     , _image(nullptr)
     , _depth(0)
+    , _buffers()
+    , _back(0)
+    , _front(0)
+    , _output()
+    , _workers()
+    , _filter(_workers)
+    , _upscaler(_workers)
+    , _source()
 {
     _parameters.crt_emulation = false;
+    _parameters.crt_filter    = false;
     _parameters.try_xshm      = try_xshm;
     _parameters.has_xshm      = false;
     _parameters.use_xshm      = false;
@@ -130,64 +139,24 @@ auto Renderer::realize() -> void
         }
     };
 
-    auto do_realize_std_image = [&]() -> void
+    auto do_realize_image = [&]() -> void
     {
-        if(_image == nullptr) {
-            _image = XcpcCreateStdImage ( _display
-                                        , _visual
-                                        , _depth
-                                        , ZPixmap
-                                        , DISPLAY_WIDTH
-                                        , DISPLAY_HEIGHT );
-        }
-    };
-
-    auto do_realize_shm_image = [&]() -> void
-    {
-        if(_image != nullptr) {
-            return;
-        }
-        if(_parameters.try_xshm != false) {
-            _parameters.has_xshm = (XcpcQueryShmExtension(_display) != False ? true : false);
-        }
-        if(_parameters.has_xshm != false) {
-            _image = XcpcCreateShmImage ( _display
-                                        , _visual
-                                        , _depth
-                                        , ZPixmap
-                                        , DISPLAY_WIDTH
-                                        , DISPLAY_HEIGHT );
-        }
-        if(_image != nullptr) {
-            _parameters.use_xshm = XcpcAttachShmImage(_display, _image);
-            if(_parameters.use_xshm == false) {
-                _image = (XcpcDestroyShmImage(_image), nullptr);
-            }
-        }
+        create_image();
     };
 
     auto do_realize_state = [&]() -> void
     {
-        if(_image != nullptr) {
-            _state.image_x      = 0;
-            _state.image_y      = 0;
-            _state.image_width  = _image->width;
-            _state.image_height = _image->height;
-            _state.image_bpp    = _image->bits_per_pixel;
-            _state.image_bpl    = _image->bytes_per_line;
-            _state.image_data   = reinterpret_cast<uint8_t*>(_image->data);
-        }
-        if(_state.viewport_w >= _state.visible_w) {
-            _state.image_x = +((_state.viewport_w - _state.visible_w) / 2);
+        if(_state.viewport_w >= _output.w) {
+            _state.image_x = +((_state.viewport_w - _output.w) / 2);
         }
         else {
-            _state.image_x = -((_state.visible_w - _state.viewport_w) / 2);
+            _state.image_x = -((_output.w - _state.viewport_w) / 2);
         }
-        if(_state.viewport_h >= _state.visible_h) {
-            _state.image_y = +((_state.viewport_h - _state.visible_h) / 2);
+        if(_state.viewport_h >= _output.h) {
+            _state.image_y = +((_state.viewport_h - _output.h) / 2);
         }
         else {
-            _state.image_y = -((_state.visible_h - _state.viewport_h) / 2);
+            _state.image_y = -((_output.h - _state.viewport_h) / 2);
         }
     };
 
@@ -200,8 +169,7 @@ auto Renderer::realize() -> void
     auto do_realize = [&]() -> void
     {
         do_realize_renderer();
-        do_realize_shm_image();
-        do_realize_std_image();
+        do_realize_image();
         do_realize_state();
         do_clear_area();
     };
@@ -231,40 +199,21 @@ auto Renderer::unrealize() -> void
 
     auto do_unrealize_state = [&]() -> void
     {
-        _state.image_x      = 0;
-        _state.image_y      = 0;
-        _state.image_width  = 0;
-        _state.image_height = 0;
-        _state.image_bpp    = 0;
-        _state.image_bpl    = 0;
-        _state.image_data   = nullptr;
-        _state.viewport_w   = 0;
-        _state.viewport_h   = 0;
+        _state.image_x    = 0;
+        _state.image_y    = 0;
+        _state.viewport_w = 0;
+        _state.viewport_h = 0;
     };
 
-    auto do_unrealize_std_image = [&]() -> void
+    auto do_unrealize_image = [&]() -> void
     {
-        if(_image != nullptr) {
-            _image = (XcpcDestroyStdImage(_image), nullptr);
-        }
-    };
-
-    auto do_unrealize_shm_image = [&]() -> void
-    {
-        if(_image == nullptr) {
-            return;
-        }
-        if(_parameters.use_xshm != false) {
-            _parameters.use_xshm = (XcpcDetachShmImage(_display, _image), false);
-            _image = (XcpcDestroyShmImage(_image), nullptr);
-        }
+        delete_image();
     };
 
     auto do_unrealize = [&]() -> void
     {
         do_unrealize_state();
-        do_unrealize_shm_image();
-        do_unrealize_std_image();
+        do_unrealize_image();
         do_unrealize_renderer();
     };
 
@@ -278,19 +227,19 @@ auto Renderer::resize(int width, int height) -> void
         _state.viewport_h = height;
     }
     /* compute image_x */ {
-        if(_state.viewport_w >= _state.visible_w) {
-            _state.image_x = +((_state.viewport_w - _state.visible_w) / 2);
+        if(_state.viewport_w >= _output.w) {
+            _state.image_x = +((_state.viewport_w - _output.w) / 2);
         }
         else {
-            _state.image_x = -((_state.visible_w - _state.viewport_w) / 2);
+            _state.image_x = -((_output.w - _state.viewport_w) / 2);
         }
     }
     /* compute image_y */ {
-        if(_state.viewport_h >= _state.visible_h) {
-            _state.image_y = +((_state.viewport_h - _state.visible_h) / 2);
+        if(_state.viewport_h >= _output.h) {
+            _state.image_y = +((_state.viewport_h - _output.h) / 2);
         }
         else {
-            _state.image_y = -((_state.visible_h - _state.viewport_h) / 2);
+            _state.image_y = -((_output.h - _state.viewport_h) / 2);
         }
     }
 }
@@ -306,8 +255,8 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
     /* init monitor area */ {
         monitor.x1 = _state.image_x;
         monitor.y1 = _state.image_y;
-        monitor.x2 = ((monitor.x1 + _state.visible_w) - 1);
-        monitor.y2 = ((monitor.y1 + _state.visible_h) - 1);
+        monitor.x2 = ((monitor.x1 + _output.w) - 1);
+        monitor.y2 = ((monitor.y1 + _output.h) - 1);
     }
     /* init refresh area */ {
         refresh.x1 = x;
@@ -335,9 +284,10 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
             refresh.y2 = monitor.y2;
         }
     }
-    /* put image */ {
-        const int src_x = _state.visible_x + (refresh.x1 - _state.image_x);
-        const int src_y = _state.visible_y + (refresh.y1 - _state.image_y);
+    /* put front image */ {
+        XImage* const image = (_buffers[_front].image != nullptr ? _buffers[_front].image : _image);
+        const int src_x = _output.x + (refresh.x1 - _state.image_x);
+        const int src_y = _output.y + (refresh.y1 - _state.image_y);
         const int dst_x = refresh.x1;
         const int dst_y = refresh.y1;
         const int dst_w = ((refresh.x2 - refresh.x1) + 1);
@@ -346,7 +296,7 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
         static_cast<void>(XcpcPutImage ( _display
                                        , _window
                                        , _gc
-                                       , _image
+                                       , image
                                        , src_x
                                        , src_y
                                        , dst_x
@@ -362,17 +312,27 @@ auto Renderer::expose(int x, int y, int width, int height) -> void
 auto Renderer::render() -> void
 {
     if((_display != nullptr) && (_window != None) && (_image != nullptr)) {
-        const int src_x = _state.visible_x;
-        const int src_y = _state.visible_y;
+        auto& back(_buffers[_back]);
+        const int src_x = _output.x;
+        const int src_y = _output.y;
         const int dst_x = _state.image_x;
         const int dst_y = _state.image_y;
-        const int dst_w = _state.visible_w;
-        const int dst_h = _state.visible_h;
-        static_cast<void>(XSync(_display, False));
+        const int dst_w = _output.w;
+        const int dst_h = _output.h;
+        if(_parameters.use_upscaler != false) {
+            upscale_image(back.image);
+        }
+        if(_parameters.crt_filter != false) {
+            filter_image(back.image);
+        }
+        if(_parameters.use_xshm != false) {
+            back.serial  = NextRequest(_display);
+            back.pending = true;
+        }
         static_cast<void>(XcpcPutImage ( _display
                                        , _window
                                        , _gc
-                                       , _image
+                                       , back.image
                                        , src_x
                                        , src_y
                                        , dst_x
@@ -380,8 +340,22 @@ auto Renderer::render() -> void
                                        , dst_w
                                        , dst_h
                                        , _parameters.use_xshm ? True : False
-                                       , False ));
+                                       , _parameters.use_xshm ? True : False ));
         static_cast<void>(XFlush(_display));
+        swap_images();
+    }
+}
+
+auto Renderer::notify(const XEvent& event) -> void
+{
+    if((_display != nullptr) && (_parameters.use_xshm != false)) {
+        for(auto& buffer : _buffers) {
+            if((buffer.image != nullptr) && (buffer.pending != false)) {
+                if((XcpcIsShmCompletion(_display, buffer.image, &event) != False) && (event.xany.serial >= buffer.serial)) {
+                    buffer.pending = false;
+                }
+            }
+        }
     }
 }
 
@@ -391,6 +365,16 @@ auto Renderer::set_visible_area(int x, int y, int w, int h) -> void
     _state.visible_y = y;
     _state.visible_w = w;
     _state.visible_h = h;
+
+    if(_image != nullptr) {
+        if((_state.image_width  != get_required_image_width())
+        || (_state.image_height != get_required_image_height())
+        || (_upscaler.is_enabled() != false)) {
+            delete_image();
+            create_image();
+        }
+        update_output();
+    }
 }
 
 auto Renderer::alloc_color(uint16_t r, uint16_t g, uint16_t b) -> uint32_t
@@ -436,14 +420,297 @@ auto Renderer::set_parameterb(const std::string& parameter, bool value) -> void
             /* do nothing */
         }
     }
+    if((parameter == "video.crt_filter") || (parameter == "video.x11.crt_filter")) {
+        const bool old_crt_filter = _parameters.crt_filter;
+        const bool new_crt_filter = _parameters.crt_filter = value;
+        if(new_crt_filter != old_crt_filter) {
+            _filter.reset();
+        }
+        _state.image_scanlines = new_crt_filter;
+    }
 }
 
 auto Renderer::set_parameteri(const std::string& parameter, int value) -> void
 {
+    if((parameter == "video.upscaler") || (parameter == "video.x11.upscaler")) {
+        if((_upscaler.set_mode(value) != false) && (_image != nullptr)) {
+            delete_image();
+            create_image();
+            resize(_state.viewport_w, _state.viewport_h);
+        }
+        return;
+    }
 }
 
 auto Renderer::set_parameterf(const std::string& parameter, float value) -> void
 {
+    auto clampf = [](float value, const float min, const float max) -> float
+    {
+        if(value < min) {
+            value = min;
+        }
+        if(value > max) {
+            value = max;
+        }
+        return value;
+    };
+
+    if((parameter == "video.u_hsampling") || (parameter == "video.x11.u_hsampling")) {
+        _parameters.u_hsampling = clampf(value, 0.0f, 5.0f);
+        return;
+    }
+    if((parameter == "video.u_vsampling") || (parameter == "video.x11.u_vsampling")) {
+        _parameters.u_vsampling = clampf(value, 0.0f, 5.0f);
+        return;
+    }
+    if((parameter == "video.u_curvature") || (parameter == "video.x11.u_curvature")) {
+        _parameters.u_curvature = clampf(value, 0.0f, 1.0f);
+        return;
+    }
+    if((parameter == "video.u_corner") || (parameter == "video.x11.u_corner")) {
+        _parameters.u_corner = clampf(value, 0.0f, 1.0f);
+        return;
+    }
+    if((parameter == "video.u_dotline") || (parameter == "video.x11.u_dotline")) {
+        _parameters.u_dotline = clampf(value, 0.0f, 1.0f);
+        return;
+    }
+    if((parameter == "video.u_dotmask") || (parameter == "video.x11.u_dotmask")) {
+        _parameters.u_dotmask = clampf(value, 0.0f, 1.0f);
+        return;
+    }
+    if((parameter == "video.u_vignetting") || (parameter == "video.x11.u_vignetting")) {
+        _parameters.u_vignetting = clampf(value, 0.0f, 2.0f);
+        return;
+    }
+    if((parameter == "video.u_brightness") || (parameter == "video.x11.u_brightness")) {
+        _parameters.u_brightness = clampf(value, 0.0f, 2.0f);
+        return;
+    }
+}
+
+auto Renderer::create_image() -> void
+{
+    const int  source_width  = get_required_image_width();
+    const int  source_height = get_required_image_height();
+    const bool use_upscaler  = ((_upscaler.is_enabled() != false)
+                             && (_state.visible_w > 0)
+                             && (_state.visible_h > 0)
+                             && (query_bits_per_pixel() == 32));
+    const int  image_width   = (use_upscaler != false ? _upscaler.get_output_width(_state.visible_w)  : source_width );
+    const int  image_height  = (use_upscaler != false ? _upscaler.get_output_height(_state.visible_h) : source_height);
+
+    auto create_shm_image = [&](Buffer& buffer) -> void
+    {
+        if(buffer.image != nullptr) {
+            return;
+        }
+        if(_parameters.has_xshm != false) {
+            buffer.image = XcpcCreateShmImage ( _display
+                                              , _visual
+                                              , _depth
+                                              , ZPixmap
+                                              , image_width
+                                              , image_height );
+        }
+        if(buffer.image != nullptr) {
+            if(XcpcAttachShmImage(_display, buffer.image) == False) {
+                buffer.image = (XcpcDestroyShmImage(buffer.image), nullptr);
+            }
+        }
+    };
+
+    auto create_shm_images = [&]() -> void
+    {
+        if(_parameters.try_xshm != false) {
+            _parameters.has_xshm = (XcpcQueryShmExtension(_display) != False ? true : false);
+        }
+        for(auto& buffer : _buffers) {
+            create_shm_image(buffer);
+            if(buffer.image == nullptr) {
+                break;
+            }
+        }
+        _parameters.use_xshm = (_buffers[0].image != nullptr);
+    };
+
+    auto create_std_image = [&]() -> void
+    {
+        if(_buffers[0].image == nullptr) {
+            _buffers[0].image = XcpcCreateStdImage ( _display
+                                                   , _visual
+                                                   , _depth
+                                                   , ZPixmap
+                                                   , image_width
+                                                   , image_height );
+        }
+    };
+
+    auto update_state = [&]() -> void
+    {
+        _back  = 0;
+        _front = 0;
+        _image = _buffers[_back].image;
+        _parameters.use_upscaler = ((use_upscaler != false) && (_image != nullptr) && (_image->bits_per_pixel == 32));
+        if(_parameters.use_upscaler != false) {
+            _source.resize(source_width * source_height);
+            _state.image_width  = source_width;
+            _state.image_height = source_height;
+            _state.image_bpp    = 32;
+            _state.image_bpl    = source_width * 4;
+            _state.image_data   = reinterpret_cast<uint8_t*>(_source.data());
+        }
+        else if(_image != nullptr) {
+            _state.image_width  = _image->width;
+            _state.image_height = _image->height;
+            _state.image_bpp    = _image->bits_per_pixel;
+            _state.image_bpl    = _image->bytes_per_line;
+            _state.image_data   = reinterpret_cast<uint8_t*>(_image->data);
+        }
+        if(_image != nullptr) {
+            _state.red_mask   = static_cast<uint32_t>(_image->red_mask);
+            _state.green_mask = static_cast<uint32_t>(_image->green_mask);
+            _state.blue_mask  = static_cast<uint32_t>(_image->blue_mask);
+        }
+        update_output();
+    };
+
+    create_shm_images();
+    create_std_image();
+    update_state();
+}
+
+auto Renderer::delete_image() -> void
+{
+    auto update_state = [&]() -> void
+    {
+        _state.image_width  = 0;
+        _state.image_height = 0;
+        _state.image_bpp    = 0;
+        _state.image_bpl    = 0;
+        _state.image_data   = nullptr;
+        _state.red_mask     = 0;
+        _state.green_mask   = 0;
+        _state.blue_mask    = 0;
+        _image              = nullptr;
+        _back               = 0;
+        _front              = 0;
+        _output             = Output();
+    };
+
+    auto delete_shm_image = [&](Buffer& buffer) -> void
+    {
+        if(buffer.image != nullptr) {
+            static_cast<void>(XcpcDetachShmImage(_display, buffer.image));
+            buffer.image = (XcpcDestroyShmImage(buffer.image), nullptr);
+        }
+    };
+
+    auto delete_std_image = [&](Buffer& buffer) -> void
+    {
+        if(buffer.image != nullptr) {
+            buffer.image = (XcpcDestroyStdImage(buffer.image), nullptr);
+        }
+    };
+
+    update_state();
+    _filter.reset();
+    _upscaler.reset();
+    _source.clear();
+    _parameters.use_upscaler = false;
+    for(auto& buffer : _buffers) {
+        if(_parameters.use_xshm != false) {
+            delete_shm_image(buffer);
+        }
+        else {
+            delete_std_image(buffer);
+        }
+        buffer.serial  = 0UL;
+        buffer.pending = false;
+    }
+    _parameters.use_xshm = false;
+}
+
+auto Renderer::swap_images() -> void
+{
+    int next = ((_back + 1) % BUFFER_COUNT);
+
+    if(_buffers[next].image == nullptr) {
+        next = _back;
+    }
+    if(_buffers[next].pending != false) {
+        static_cast<void>(XSync(_display, False));
+        for(auto& buffer : _buffers) {
+            buffer.pending = false;
+        }
+    }
+    _front = _back;
+    _back  = next;
+    _image = _buffers[_back].image;
+    if(_parameters.use_upscaler == false) {
+        _state.image_data = reinterpret_cast<uint8_t*>(_image->data);
+    }
+}
+
+auto Renderer::filter_image(XImage* image) -> void
+{
+    CrtFilter::Settings settings;
+
+    settings.u_hsampling  = _parameters.u_hsampling;
+    settings.u_vsampling  = _parameters.u_vsampling;
+    settings.u_curvature  = _parameters.u_curvature;
+    settings.u_corner     = _parameters.u_corner;
+    settings.u_dotline    = _parameters.u_dotline;
+    settings.u_dotmask    = _parameters.u_dotmask;
+    settings.u_vignetting = _parameters.u_vignetting;
+    settings.u_brightness = _parameters.u_brightness;
+    _filter.configure(settings);
+    static_cast<void>(_filter.process(image, _output.x, _output.y, _output.w, _output.h));
+}
+
+auto Renderer::upscale_image(XImage* image) -> void
+{
+    const uint8_t* src_data = _state.image_data + (_state.visible_y * _state.image_bpl) + (_state.visible_x * 4);
+    uint8_t*       dst_data = reinterpret_cast<uint8_t*>(image->data);
+
+    if(_upscaler.process(src_data, _state.image_bpl, _state.visible_w, _state.visible_h, dst_data, image->bytes_per_line) != false) {
+        _state.upscale_us     += _upscaler.get_elapsed_us();
+        _state.upscale_frames += 1;
+    }
+}
+
+auto Renderer::update_output() -> void
+{
+    if((_parameters.use_upscaler != false) && (_image != nullptr)) {
+        _output.x = 0;
+        _output.y = 0;
+        _output.w = _image->width;
+        _output.h = _image->height;
+    }
+    else {
+        _output.x = _state.visible_x;
+        _output.y = _state.visible_y;
+        _output.w = _state.visible_w;
+        _output.h = _state.visible_h;
+    }
+}
+
+auto Renderer::query_bits_per_pixel() const -> int
+{
+    int count = 0;
+    int bits_per_pixel = 0;
+    XPixmapFormatValues* formats = XListPixmapFormats(_display, &count);
+
+    if(formats != nullptr) {
+        for(int index = 0; index < count; ++index) {
+            if(formats[index].depth == _depth) {
+                bits_per_pixel = formats[index].bits_per_pixel;
+                break;
+            }
+        }
+        static_cast<void>(XFree(formats));
+    }
+    return bits_per_pixel;
 }
 
 }
@@ -19,6 +19,8 @@
 
 #include <xcpc/amstrad/dpy/dpy-core.h>
 #include <xcpc/amstrad/dpy/x11-wrapper.h>
+#include <xcpc/amstrad/dpy/x11-filter.h>
+#include <xcpc/amstrad/dpy/dpy-upscaler.h>
 
 // ---------------------------------------------------------------------------
 // x11::Renderer
@@ -52,6 +54,8 @@ public: // public interface
 
     virtual auto render() -> void override final;
 
+    virtual auto notify(const XEvent& event) -> void override final;
+
     virtual auto set_visible_area(int x, int y, int w, int h) -> void override final;
 
     virtual auto alloc_color(uint16_t r, uint16_t g, uint16_t b) -> uint32_t override final;
@@ -88,15 +92,61 @@ public: // public interface
         return 0;
     }
 
+private: // private interface
+    auto create_image() -> void;
+
+    auto delete_image() -> void;
+
+    auto swap_images() -> void;
+
+    auto filter_image(XImage* image) -> void;
+
+    auto upscale_image(XImage* image) -> void;
+
+    auto update_output() -> void;
+
+    auto query_bits_per_pixel() const -> int;
+
 private: // private types
     struct Parameters
     {
-        bool crt_emulation = false;
-        bool try_xshm      = false;
-        bool has_xshm      = false;
-        bool use_xshm      = false;
+        bool  crt_emulation = false;
+        bool  crt_filter    = false;
+        bool  try_xshm      = false;
+        bool  has_xshm      = false;
+        bool  use_xshm      = false;
+        bool  use_upscaler  = false;
+        float u_hsampling   = 0.75f;
+        float u_vsampling   = 0.25f;
+        float u_curvature   = 0.10f;
+        float u_corner      = 0.15f;
+        float u_dotline     = 0.30f;
+        float u_dotmask     = 0.10f;
+        float u_vignetting  = 1.00f;
+        float u_brightness  = 1.30f;
     };
 
+    struct Buffer
+    {
+        XImage*       image   = nullptr;
+        unsigned long serial  = 0UL;
+        bool          pending = false;
+    };
+
+    struct Output
+    {
+        int x = 0;
+        int y = 0;
+        int w = 0;
+        int h = 0;
+    };
+
+    static constexpr int BUFFER_COUNT = 2;
+
+    using Workers  = dpy::Workers;
+    using Upscaler = dpy::Upscaler;
+    using Source   = std::vector<uint32_t>;
+
 private: // private data
     Parameters _parameters;
     Display*   _display;
@@ -107,6 +157,14 @@ private: // private data
     GC         _gc;
     XImage*    _image;
     int        _depth;
+    Buffer     _buffers[BUFFER_COUNT];
+    int        _back;
+    int        _front;
+    Output     _output;
+    Workers    _workers;
+    CrtFilter  _filter;
+    Upscaler   _upscaler;
+    Source     _source;
 };
 
 }
@@ -272,6 +272,24 @@ struct x11_traits
         return status;
     }
 
+    static Bool shm_completion(Display* display, void* shminfo, const XEvent* event)
+    {
+        Bool status = False;
+#ifdef HAVE_XSHM
+        if((shminfo != nullptr) && (event != nullptr)) {
+            const int completion = XShmGetEventBase(display) + ShmCompletion;
+            if(event->type == completion) {
+                const XShmCompletionEvent* xshm_event        = reinterpret_cast<const XShmCompletionEvent*>(event);
+                const XShmSegmentInfo*     xshm_segment_info = static_cast<const XShmSegmentInfo*>(shminfo);
+                if(xshm_event->shmseg == xshm_segment_info->shmseg) {
+                    status = True;
+                }
+            }
+        }
+#endif
+        return status;
+    }
+
     static Bool shm_detach(Display* display, void* shminfo)
     {
         Bool status = False;
@@ -362,6 +380,15 @@ Bool XcpcDetachShmImage(Display* display, XImage* image)
     return x11_traits::shm_detach(display, image->obdata);
 }
 
+// ---------------------------------------------------------------------------
+// XcpcIsShmCompletion
+// ---------------------------------------------------------------------------
+
+Bool XcpcIsShmCompletion(Display* display, XImage* image, const XEvent* event)
+{
+    return x11_traits::shm_completion(display, image->obdata, event);
+}
+
 // ---------------------------------------------------------------------------
 // XcpcPutImage
 // ---------------------------------------------------------------------------
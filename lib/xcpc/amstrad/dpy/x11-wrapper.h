@@ -57,6 +57,10 @@ extern Bool    XcpcAttachShmImage    ( Display* display
 extern Bool    XcpcDetachShmImage    ( Display* display
                                      , XImage*  image );
 
+extern Bool    XcpcIsShmCompletion   ( Display*      display
+                                     , XImage*       image
+                                     , const XEvent* event );
+
 extern int     XcpcPutImage          ( Display*     display
                                      , Drawable     drawable
                                      , GC           gc
@@ -23,14 +23,19 @@
 #include <cstring>
 #include <cstdint>
 #include <cstdarg>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <iostream>
 #include <stdexcept>
 #include <libdsk/libdsk.h>
 #include <lib765/765.h>
 #include <xcpc/libxcpc-priv.h>
+#include <xcpc/formats/dsk/dsk-format.h>
+#include <xcpc/formats/dsk/dsk-archive.h>
+#include <xcpc/formats/dsk/dsk-library.h>
 #include "fdc-core.h"
 
 // ---------------------------------------------------------------------------
@@ -47,6 +52,461 @@ struct BasicTraits
     using Interface = fdc::Interface;
     using FdcImpl   = fdc::FdcImpl;
     using FddImpl   = fdc::FddImpl;
+    using Loader    = fdc::Loader;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::MemoryDrive
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct MemoryDrive
+{
+    FDRV_PTR    proxy;  /* libdsk drive for the other disk formats */
+    dsk::Image* image;  /* in-memory DSK/EDSK image, if any        */
+    int         sector; /* rotating sector position for read id    */
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::MemoryDriveTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct MemoryDriveTraits final
+    : public BasicTraits
+{
+    using Image = dsk::Image;
+    using Track = dsk::Image::Track;
+
+    struct Location
+    {
+        Track* track;
+        int    slot;
+        int    length;
+        int    copies;
+    };
+
+    static inline auto cast(FddImpl* fdd) -> MemoryDrive*
+    {
+        return reinterpret_cast<MemoryDrive*>(::fdh_getdata(fdd));
+    }
+
+    static inline auto enter(FddImpl* fdd) -> FddImpl*
+    {
+        FddImpl* proxy = cast(fdd)->proxy;
+
+        ::fd_setmotor(proxy, ::fd_getmotor(fdd));
+        ::fd_setcurcyl(proxy, ::fd_getcurcyl(fdd));
+
+        return proxy;
+    }
+
+    static inline auto leave(FddImpl* fdd) -> void
+    {
+        FddImpl* proxy = cast(fdd)->proxy;
+
+        ::fd_setcurcyl(fdd, ::fd_getcurcyl(proxy));
+        ::fd_setreadonly(fdd, ::fd_getreadonly(proxy));
+    }
+
+    static auto check_recording(Image& image, const Track& track, int mfm) -> bool
+    {
+        const uint8_t* info      = image.get_track_info(track);
+        const int      size      = (0x80 << (info[0x14] & 7));
+        uint8_t        rate      = info[0x12];
+        uint8_t        recording = info[0x13];
+
+        if(rate == 0) {
+            rate = 1;
+        }
+        if(recording == 0) {
+            recording = (((size == 256) && (info[0x15] == 10)) ? 1 : 2);
+        }
+        if(rate != 1) {
+            return false;
+        }
+        return recording == (mfm != 0 ? 2 : 1);
+    }
+
+    static auto locate(FddImpl* fdd, int xcylinder, int xhead, int head, int sector, int mfm, bool random, int& len, Location& location) -> fd_err_t
+    {
+        Image& image(*cast(fdd)->image);
+        Track* track = image.find_track(::fd_getcurcyl(fdd), head);
+
+        if((track == nullptr) || (check_recording(image, *track, mfm) == false)) {
+            return FD_E_NOADDR;
+        }
+        if((sector < 0) || (sector > 255) || (track->index[sector] == Image::NO_SECTOR)) {
+            return FD_E_NOADDR;
+        }
+        int slot = track->index[sector];
+        if((track->unique == false) && (random != false)) {
+            int matches[29];
+            int count = 0;
+            for(int other = 0; other < track->count; ++other) {
+                if(image.get_sector_info(*track, other)[2] == sector) {
+                    matches[count++] = other;
+                }
+            }
+            slot = matches[::rand() % count];
+        }
+        const uint8_t* info = image.get_sector_info(*track, slot);
+        if((info[0] != xcylinder) || (info[1] != xhead)) {
+            return FD_E_NOADDR;
+        }
+        fd_err_t  err    = FD_E_OK;
+        const int length = (0x80 << (info[3] & 7));
+        const int size   = track->sector[slot].size;
+        if(length < len) {
+            err = FD_E_DATAERR;
+            len = length;
+        }
+        else if(length > len) {
+            err = FD_E_DATAERR;
+        }
+        location.track  = track;
+        location.slot   = slot;
+        location.length = length;
+        location.copies = ((length * 2) <= size ? (size / length) : 1);
+        return err;
+    }
+
+    static auto seek_cylinder(FddImpl* fdd, int cylinder) -> fd_err_t
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const fd_err_t err = ::fd_seek_cylinder(enter(fdd), cylinder);
+            return (leave(fdd), err);
+        }
+        if(cylinder > drive->image->get_number_of_tracks()) {
+            return FD_E_SEEKFAIL;
+        }
+        ::fd_setcurcyl(fdd, cylinder);
+        return FD_E_OK;
+    }
+
+    static auto read_id(FddImpl* fdd, int head, int sector, fdc_byte* buf) -> fd_err_t
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const fd_err_t err = ::fd_read_id(enter(fdd), head, sector, buf);
+            return (leave(fdd), err);
+        }
+        Image& image(*drive->image);
+        Track* track = image.find_track(::fd_getcurcyl(fdd), head);
+        if((track == nullptr) || (track->count == 0)) {
+            return FD_E_NOADDR;
+        }
+        if(++drive->sector < 0) {
+            drive->sector = 0;
+        }
+        const uint8_t* info = image.get_sector_info(*track, (drive->sector % track->count));
+        buf[0] = info[0];
+        buf[1] = info[1];
+        buf[2] = info[2];
+        buf[3] = info[3];
+        return FD_E_OK;
+    }
+
+    static auto read_sector(FddImpl* fdd, int xcylinder, int xhead, int head, int sector, fdc_byte* buf, int len, int* deleted, int skip_deleted, int mfm, int multi) -> fd_err_t
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const fd_err_t err = ::fd_read_sector(enter(fdd), xcylinder, xhead, head, sector, buf, len, deleted, skip_deleted, mfm, multi);
+            return (leave(fdd), err);
+        }
+        Image&    image(*drive->image);
+        const int rdeleted  = (((deleted != nullptr) && (*deleted != 0)) ? 0x40 : 0);
+        bool      try_again = false;
+        fd_err_t  err       = FD_E_OK;
+        Location  location;
+        do {
+            err = locate(fdd, xcylinder, xhead, head, sector, mfm, true, len, location);
+            if((try_again != false) && (err == FD_E_NOADDR)) {
+                err = FD_E_NODATA;
+            }
+            try_again = false;
+            if(err == FD_E_NOADDR) {
+                drive->sector = -1;
+            }
+            if((err != FD_E_OK) && (err != FD_E_DATAERR)) {
+                return err;
+            }
+            const uint8_t* info = image.get_sector_info(*location.track, location.slot);
+            if(deleted != nullptr) {
+                *deleted = 0;
+            }
+            if(rdeleted != (info[5] & 0x40)) {
+                if(skip_deleted != 0) {
+                    try_again = true;
+                    ++sector;
+                    continue;
+                }
+                if(deleted != nullptr) {
+                    *deleted = 1;
+                }
+            }
+            const uint32_t offset = ((::rand() % location.copies) * location.length);
+            const uint32_t limit  = image.get_sector_limit(*location.track, location.slot);
+            const uint32_t avail  = (limit > offset ? limit - offset : 0);
+            const uint32_t count  = (static_cast<uint32_t>(len) < avail ? len : avail);
+            static_cast<void>(::memcpy(buf, image.get_sector_data(*location.track, location.slot) + offset, count));
+            if(count < static_cast<uint32_t>(len)) {
+                err = FD_E_DATAERR;
+            }
+            if((info[5] & 0x20) != 0) {
+                err = FD_E_DATAERR;
+            }
+        } while(try_again != false);
+
+        return err;
+    }
+
+    static auto read_track(FddImpl* fdd, int xcylinder, int xhead, int head, fdc_byte* buf, int* len) -> fd_err_t
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const fd_err_t err = ::fd_read_track(enter(fdd), xcylinder, xhead, head, buf, len);
+            return (leave(fdd), err);
+        }
+        Image& image(*drive->image);
+        Track* track = image.find_track(::fd_getcurcyl(fdd), head);
+        if(track == nullptr) {
+            return FD_E_NOADDR;
+        }
+        uint32_t offset = 0;
+        for(int slot = 0; (slot < track->count) && (offset < static_cast<uint32_t>(*len)); ++slot) {
+            const uint8_t* info = image.get_sector_info(*track, slot);
+            if((info[0] != xcylinder) || (info[1] != xhead)) {
+                return FD_E_NOADDR;
+            }
+            const uint32_t length = (0x80 << (info[3] & 7));
+            const uint32_t limit  = image.get_sector_limit(*track, slot);
+            uint32_t       count  = (*len - offset);
+            if(count > length) {
+                count = length;
+            }
+            if(count > limit) {
+                count = limit;
+            }
+            static_cast<void>(::memcpy(&buf[offset], image.get_sector_data(*track, slot), count));
+            offset += length;
+        }
+        return FD_E_OK;
+    }
+
+    static auto write_sector(FddImpl* fdd, int xcylinder, int xhead, int head, int sector, fdc_byte* buf, int len, int deleted, int skip_deleted, int mfm, int multi) -> fd_err_t
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const fd_err_t err = ::fd_write_sector(enter(fdd), xcylinder, xhead, head, sector, buf, len, deleted, skip_deleted, mfm, multi);
+            return (leave(fdd), err);
+        }
+        Image& image(*drive->image);
+        if(image.is_readonly() != false) {
+            return FD_E_READONLY;
+        }
+        Location       location;
+        const fd_err_t err = locate(fdd, xcylinder, xhead, head, sector, mfm, false, len, location);
+        if((err != FD_E_OK) && (err != FD_E_DATAERR)) {
+            return err;
+        }
+        uint8_t*       info  = image.get_sector_info(*location.track, location.slot);
+        uint8_t*       data  = image.get_sector_data(*location.track, location.slot);
+        const uint32_t limit = image.get_sector_limit(*location.track, location.slot);
+        for(int copy = 0; copy < location.copies; ++copy) {
+            const uint32_t offset = (copy * location.length);
+            const uint32_t avail  = (limit > offset ? limit - offset : 0);
+            const uint32_t count  = (static_cast<uint32_t>(len) < avail ? len : avail);
+            static_cast<void>(::memcpy(data + offset, buf, count));
+        }
+        if(deleted != 0) {
+            info[5] |= 0x40;
+        }
+        else {
+            info[5] &= ~0x40;
+        }
+        image.mark_dirty(*location.track);
+        return FD_E_OK;
+    }
+
+    static auto format_track(FddImpl* fdd, int head, int sectors, fdc_byte* track, fdc_byte filler) -> fd_err_t
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const fd_err_t err = ::fd_format_track(enter(fdd), head, sectors, track, filler);
+            return (leave(fdd), err);
+        }
+        if(drive->image->format(::fd_getcurcyl(fdd), head, track, sectors, filler) == false) {
+            return FD_E_READONLY;
+        }
+        return FD_E_OK;
+    }
+
+    static auto drive_status(FddImpl* fdd) -> fdc_byte
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const fdc_byte status = ::fd_drive_status(enter(fdd));
+            return (leave(fdd), status);
+        }
+        return ::fdd_drive_status(fdd);
+    }
+
+    static auto isready(FddImpl* fdd) -> int
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            const int ready = ::fd_isready(enter(fdd));
+            return (leave(fdd), ready);
+        }
+        return (::fd_getmotor(fdd) != 0 ? 1 : 0);
+    }
+
+    static auto dirty(FddImpl* fdd) -> int
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image == nullptr) {
+            return ::fd_dirty(drive->proxy);
+        }
+        return (drive->image->is_dirty() != false ? FD_D_DIRTY : FD_D_CLEAN);
+    }
+
+    static auto eject(FddImpl* fdd) -> void
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image != nullptr) {
+            flush(fdd);
+            drive->image = (delete drive->image, nullptr);
+            ::fd_setreadonly(fdd, 0);
+        }
+        drive->sector = -1;
+        ::fd_eject(drive->proxy);
+    }
+
+    static auto set_datarate(FddImpl* fdd, fdc_byte rate) -> void
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        ::fd_set_datarate(drive->proxy, rate);
+    }
+
+    static auto reset(FddImpl* fdd) -> void
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        ::fd_reset(drive->proxy);
+    }
+
+    static auto destroy(FddImpl* fdd) -> void
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        ::fd_destroy(&drive->proxy);
+        delete drive;
+    }
+
+    static auto flush(FddImpl* fdd) -> void
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image != nullptr) {
+            try {
+                drive->image->flush();
+            }
+            catch(const std::exception& e) {
+                ::xcpc_log_error("unable to write back <%s> (%s)", drive->image->get_filename().c_str(), e.what());
+            }
+        }
+    }
+
+    static auto load(FddImpl* fdd, const std::string& filename) -> bool
+    {
+        if(Image::probe(filename) == false) {
+            return false;
+        }
+        std::unique_ptr<Image> image(new Image(filename));
+        try {
+            image->load();
+        }
+        catch(const std::exception& e) {
+            ::xcpc_log_debug("unable to cache <%s> (%s)", filename.c_str(), e.what());
+            return false;
+        }
+        return (adopt(fdd, image.release()), true);
+    }
+
+    static auto adopt(FddImpl* fdd, Image* image) -> void
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        drive->image = image;
+        ::fd_setreadonly(fdd, (image->is_readonly() != false ? 1 : 0));
+    }
+
+    static auto get_filename(FddImpl* fdd) -> std::string
+    {
+        MemoryDrive* drive = cast(fdd);
+
+        if(drive->image != nullptr) {
+            return drive->image->get_filename();
+        }
+        return ::fdl_getfilename(drive->proxy);
+    }
+
+    static auto get_proxy(FddImpl* fdd) -> FddImpl*
+    {
+        return cast(fdd)->proxy;
+    }
+
+    static auto create() -> FddImpl*
+    {
+        static FLOPPY_DRIVE_VTABLE vtable = {
+            &seek_cylinder,
+            &read_id,
+            &read_sector,
+            &read_track,
+            &write_sector,
+            &format_track,
+            &drive_status,
+            &isready,
+            &dirty,
+            &eject,
+            &set_datarate,
+            &reset,
+            &destroy,
+            nullptr,
+        };
+        FddImpl* proxy = ::fd_newldsk();
+        if(proxy == nullptr) {
+            return nullptr;
+        }
+        MemoryDrive* drive = new MemoryDrive;
+        drive->proxy  = proxy;
+        drive->image  = nullptr;
+        drive->sector = -1;
+        FddImpl* fdd = ::fd_newhost(&vtable, drive);
+        if(fdd == nullptr) {
+            return (::fd_destroy(&drive->proxy), delete drive, nullptr);
+        }
+        return fdd;
+    }
 };
 
 }
@@ -100,6 +560,13 @@ struct FdcTraits final
         }
     }
 
+    static inline auto collapse(FdcImpl* fdc) -> void
+    {
+        if(fdc != nullptr) {
+            ::fdc_expire(fdc);
+        }
+    }
+
     static inline auto set_motor(FdcImpl* fdc, uint8_t motor) -> uint8_t
     {
         if(fdc != nullptr) {
@@ -159,44 +626,33 @@ namespace {
 struct FddTraits final
     : public BasicTraits
 {
-    static inline auto check_supported(const std::string& filename) -> void
+    static inline auto is_compressed(const std::string& filename) -> bool
     {
-        uint8_t magic[4] = { 0, 0, 0, 0 };
-        size_t  count    = 0;
-        FILE*   file     = ::fopen(filename.c_str(), "rb");
+        const dsk::Archive archive(filename);
 
-        if(file != nullptr) {
-            count = ::fread(magic, 1, sizeof(magic), file);
-            static_cast<void>(::fclose(file));
-        }
-        else {
-            return;
-        }
+        return archive.sniff() != dsk::ARCHIVE_NONE;
+    }
 
-        const char* needed = nullptr;
-        if((count >= 2) && (magic[0] == 0x1f) && (magic[1] == 0x8b)) {
-#ifndef HAVE_LIBZ
-            needed = "gzip (.gz)";
-#endif
-        }
-        else if((count >= 3) && (magic[0] == 0x42) && (magic[1] == 0x5a) && (magic[2] == 0x68)) {
-#ifndef HAVE_LIBBZ2
-            needed = "bzip2 (.bz2)";
-#endif
-        }
-        else if((count >= 4) && (magic[0] == 0x50) && (magic[1] == 0x4b) && (magic[2] == 0x03) && (magic[3] == 0x04)) {
-#ifndef HAVE_LIBZIP
-            needed = "zip (.zip)";
-#endif
-        }
-        if(needed != nullptr) {
-            throw std::runtime_error(std::string("unsupported compressed disk image: this build has no ") + needed + " support");
+    static inline auto is_library_member(const std::string& filename) -> bool
+    {
+        std::string directory;
+        std::string name;
+
+        return dsk::Library::split_member(filename, directory, name);
+    }
+
+    static inline auto check_supported(const std::string& filename) -> void
+    {
+        const dsk::Archive archive(filename);
+
+        if(archive.is_supported() == false) {
+            throw std::runtime_error(std::string("unsupported compressed disk image: this build has no ") + dsk::Archive::get_name(archive.sniff()) + " support");
         }
     }
 
     static inline auto create() -> FddImpl*
     {
-        FddImpl* fdd = ::fd_newldsk();
+        FddImpl* fdd = MemoryDriveTraits::create();
 
         if(fdd == nullptr) {
             throw std::runtime_error("fd_newldsk() has failed");
@@ -228,7 +684,8 @@ struct FddTraits final
     {
         if(fdd != nullptr) {
             if(filename.size() != 0) {
-                ::fdl_create_dsk(fdd, filename.c_str());
+                ::fd_eject(fdd);
+                ::fdl_create_dsk(MemoryDriveTraits::get_proxy(fdd), filename.c_str());
             }
             else {
                 ::fd_eject(fdd);
@@ -241,7 +698,10 @@ struct FddTraits final
         if(fdd != nullptr) {
             if(filename.size() != 0) {
                 check_supported(filename);
-                ::fdl_setfilename(fdd, filename.c_str());
+                ::fd_eject(fdd);
+                if(MemoryDriveTraits::load(fdd, filename) == false) {
+                    ::fdl_setfilename(MemoryDriveTraits::get_proxy(fdd), filename.c_str());
+                }
             }
             else {
                 ::fd_eject(fdd);
@@ -249,6 +709,26 @@ struct FddTraits final
         }
     }
 
+    static inline auto insert_image(FddImpl* fdd, Loader::Job& job) -> void
+    {
+        if(fdd != nullptr) {
+            ::fd_eject(fdd);
+            if(job.image != nullptr) {
+                if((job.image->is_compressed() != false) && (job.image->is_readonly() != false)) {
+                    ::xcpc_log_alert("<%s> is not writable, the compressed disk image is mounted read-only", job.filename.c_str());
+                }
+                MemoryDriveTraits::adopt(fdd, job.image.release());
+            }
+            else if(is_library_member(job.filename) != false) {
+                ::xcpc_log_error("unable to load <%s> from the disk library (%s)", job.filename.c_str(), job.error.c_str());
+            }
+            else {
+                ::xcpc_log_debug("unable to inflate <%s> in memory (%s)", job.filename.c_str(), job.error.c_str());
+                ::fdl_setfilename(MemoryDriveTraits::get_proxy(fdd), job.filename.c_str());
+            }
+        }
+    }
+
     static inline auto remove_disk(FddImpl* fdd) -> void
     {
         if(fdd != nullptr) {
@@ -261,7 +741,7 @@ struct FddTraits final
         std::string filename;
 
         if(fdd != nullptr) {
-            filename = ::fdl_getfilename(fdd);
+            filename = MemoryDriveTraits::get_filename(fdd);
         }
         return filename;
     }
@@ -285,6 +765,8 @@ struct StateTraits final
         state.fd1  = FddTraits::create();
         state.fd2  = FddTraits::create();
         state.fd3  = FddTraits::create();
+        state.motor = 0;
+        state.turbo = false;
     }
 
     static inline auto destruct(State& state) -> void
@@ -303,10 +785,14 @@ struct StateTraits final
         FddTraits::reset(state.fd1);
         FddTraits::reset(state.fd2);
         FddTraits::reset(state.fd3);
+        state.motor = 0;
     }
 
     static inline auto clock(State& state) -> void
     {
+        if(state.turbo != false) {
+            FdcTraits::collapse(state.fdc);
+        }
         FdcTraits::clock(state.fdc);
         FddTraits::clock(state.fd0);
         FddTraits::clock(state.fd1);
@@ -317,6 +803,174 @@ struct StateTraits final
 
 }
 
+// ---------------------------------------------------------------------------
+// fdc::Loader
+// ---------------------------------------------------------------------------
+
+namespace fdc {
+
+Loader::Loader()
+    : _mutex()
+    , _not_empty()
+    , _thread()
+    , _queued()
+    , _loaded()
+    , _serial()
+    , _pending()
+    , _running(false)
+    , _stopping(false)
+{
+}
+
+Loader::~Loader()
+{
+    stop();
+}
+
+auto Loader::submit(const int drive, const std::string& filename) -> void
+{
+    if((drive < 0) || (drive >= MAX_DRIVES)) {
+        return;
+    }
+    if(_running == false) {
+        start();
+    }
+
+    xcpc::MutexLock lock(_mutex);
+
+    /* any previous job for this drive becomes stale */ {
+        Job job;
+        job.drive    = drive;
+        job.serial   = ++_serial[drive];
+        job.filename = filename;
+        _pending[drive] = filename;
+        _queued.push_back(std::move(job));
+        _not_empty.notify_one();
+    }
+}
+
+auto Loader::cancel(const int drive) -> void
+{
+    if((drive < 0) || (drive >= MAX_DRIVES)) {
+        return;
+    }
+
+    xcpc::MutexLock lock(_mutex);
+
+    ++_serial[drive];
+    _pending[drive].clear();
+}
+
+auto Loader::collect(Jobs& jobs) -> void
+{
+    xcpc::MutexLock lock(_mutex);
+
+    for(auto& job : _loaded) {
+        if(is_current(job) != false) {
+            _pending[job.drive].clear();
+            jobs.push_back(std::move(job));
+        }
+    }
+    _loaded.clear();
+}
+
+auto Loader::stop() -> void
+{
+    if(_running == false) {
+        return;
+    }
+    /* let the worker finish its current job */ {
+        xcpc::MutexLock lock(_mutex);
+        _stopping = true;
+        _queued.clear();
+        _not_empty.notify_all();
+    }
+    if(_thread.joinable()) {
+        _thread.join();
+    }
+    _loaded.clear();
+    _running = false;
+}
+
+auto Loader::get_pending(const int drive) const -> std::string
+{
+    if((drive < 0) || (drive >= MAX_DRIVES)) {
+        return std::string();
+    }
+
+    xcpc::MutexLock lock(_mutex);
+
+    return _pending[drive];
+}
+
+auto Loader::start() -> void
+{
+    /* reset the queues */ {
+        _queued.clear();
+        _loaded.clear();
+        _running  = true;
+        _stopping = false;
+    }
+    /* start the worker */ {
+        _thread = Thread(&Loader::loop, this);
+    }
+}
+
+auto Loader::loop() -> void
+{
+    xcpc::MutexLock lock(_mutex);
+
+    while(true) {
+        while((_queued.empty() != false) && (_stopping == false)) {
+            _not_empty.wait(lock);
+        }
+        if(_stopping != false) {
+            break;
+        }
+        Job job(std::move(_queued.front()));
+        _queued.erase(_queued.begin());
+        if(is_current(job) == false) {
+            continue;
+        }
+        lock.unlock();
+        inflate(job);
+        lock.lock();
+        if(is_current(job) != false) {
+            _loaded.push_back(std::move(job));
+        }
+    }
+}
+
+auto Loader::inflate(Job& job) -> void
+{
+    try {
+        std::unique_ptr<dsk::Image> image(new dsk::Image(job.filename));
+        std::string                 directory;
+        std::string                 name;
+        if(dsk::Library::split_member(job.filename, directory, name) != false) {
+            std::vector<uint8_t> buffer;
+            dsk::Library library(directory);
+            library.open(false);
+            library.extract(name, buffer);
+            image->load(buffer);
+        }
+        else {
+            image->inflate();
+        }
+        job.image = std::move(image);
+    }
+    catch(const std::exception& e) {
+        job.error = e.what();
+    }
+}
+
+auto Loader::is_current(const Job& job) const -> bool
+{
+    return job.serial == _serial[job.drive];
+}
+
+}
+
 // ---------------------------------------------------------------------------
 // fdc::Instance
 // ---------------------------------------------------------------------------
@@ -326,6 +980,7 @@ namespace fdc {
 Instance::Instance(Interface& interface)
     : _interface(interface)
     , _state()
+    , _loader()
 {
     StateTraits::construct(_state);
 
@@ -389,6 +1044,8 @@ auto Instance::detach_drive(const int drive) -> void
 
 auto Instance::create_disk(const int drive, const std::string& filename) -> void
 {
+    _loader.cancel(drive);
+
     switch(drive) {
         case Drive::FDC_DRIVE0:
             FddTraits::create_disk(_state.fd0, filename);
@@ -409,6 +1066,19 @@ auto Instance::create_disk(const int drive, const std::string& filename) -> void
 
 auto Instance::insert_disk(const int drive, const std::string& filename) -> void
 {
+    _loader.cancel(drive);
+
+    if((filename.empty() == false) && (FddTraits::is_library_member(filename) != false)) {
+        remove_disk(drive);
+        _loader.submit(drive, filename);
+        return;
+    }
+    if((filename.empty() == false) && (FddTraits::is_compressed(filename) != false)) {
+        FddTraits::check_supported(filename);
+        remove_disk(drive);
+        _loader.submit(drive, filename);
+        return;
+    }
     switch(drive) {
         case Drive::FDC_DRIVE0:
             FddTraits::insert_disk(_state.fd0, filename);
@@ -429,6 +1099,8 @@ auto Instance::insert_disk(const int drive, const std::string& filename) -> void
 
 auto Instance::remove_disk(const int drive) -> void
 {
+    _loader.cancel(drive);
+
     switch(drive) {
         case Drive::FDC_DRIVE0:
             FddTraits::remove_disk(_state.fd0);
@@ -449,8 +1121,11 @@ auto Instance::remove_disk(const int drive) -> void
 
 auto Instance::get_filename(const int drive) -> std::string
 {
-    std::string filename;
+    std::string filename(_loader.get_pending(drive));
 
+    if(filename.empty() == false) {
+        return filename;
+    }
     switch(drive) {
         case Drive::FDC_DRIVE0:
             filename = FddTraits::get_filename(_state.fd0);
@@ -470,9 +1145,49 @@ auto Instance::get_filename(const int drive) -> std::string
     return filename;
 }
 
+auto Instance::poll() -> void
+{
+    Loader::Jobs jobs;
+
+    _loader.collect(jobs);
+
+    for(auto& job : jobs) {
+        switch(job.drive) {
+            case Drive::FDC_DRIVE0:
+                FddTraits::insert_image(_state.fd0, job);
+                break;
+            case Drive::FDC_DRIVE1:
+                FddTraits::insert_image(_state.fd1, job);
+                break;
+            case Drive::FDC_DRIVE2:
+                FddTraits::insert_image(_state.fd2, job);
+                break;
+            case Drive::FDC_DRIVE3:
+                FddTraits::insert_image(_state.fd3, job);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+auto Instance::set_turbo(const bool turbo) -> void
+{
+    _state.turbo = turbo;
+}
+
+auto Instance::has_turbo() const -> bool
+{
+    return (_state.turbo != false) && (_state.motor != 0);
+}
+
 auto Instance::set_motor(uint8_t data) -> uint8_t
 {
-    return FdcTraits::set_motor(_state.fdc, data);
+    data = FdcTraits::set_motor(_state.fdc, data);
+
+    _state.motor = data;
+
+    return data;
 }
 
 auto Instance::rd_stat(uint8_t data) -> uint8_t
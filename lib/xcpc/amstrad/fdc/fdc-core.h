@@ -24,6 +24,16 @@
 struct fdc_765;
 struct floppy_drive;
 
+// ---------------------------------------------------------------------------
+// dsk forward declarations
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+class Image;
+
+}
+
 // ---------------------------------------------------------------------------
 // forward declarations
 // ---------------------------------------------------------------------------
@@ -68,6 +78,80 @@ struct State
     FddImpl* fd1;
     FddImpl* fd2;
     FddImpl* fd3;
+    uint8_t  motor;
+    bool     turbo;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// fdc::Loader
+// ---------------------------------------------------------------------------
+
+namespace fdc {
+
+class Loader
+{
+public: // public types
+    struct Job
+    {
+        int                         drive  = 0;
+        unsigned long               serial = 0UL;
+        std::string                 filename;
+        std::unique_ptr<dsk::Image> image;
+        std::string                 error;
+    };
+
+    using Jobs = std::vector<Job>;
+
+public: // public interface
+    Loader();
+
+    Loader(Loader&&) = delete;
+
+    Loader(const Loader&) = delete;
+
+    Loader& operator=(Loader&&) = delete;
+
+    Loader& operator=(const Loader&) = delete;
+
+    virtual ~Loader();
+
+    auto submit(const int drive, const std::string& filename) -> void;
+
+    auto cancel(const int drive) -> void;
+
+    auto collect(Jobs& jobs) -> void;
+
+    auto stop() -> void;
+
+    auto get_pending(const int drive) const -> std::string;
+
+private: // private types
+    using Thread    = std::thread;
+    using Condition = std::condition_variable;
+
+    static constexpr int MAX_DRIVES = 4;
+
+private: // private interface
+    auto start() -> void;
+
+    auto loop() -> void;
+
+    auto inflate(Job& job) -> void;
+
+    auto is_current(const Job& job) const -> bool;
+
+private: // private data
+    mutable xcpc::Mutex _mutex;
+    Condition           _not_empty;
+    Thread              _thread;
+    Jobs                _queued;
+    Jobs                _loaded;
+    unsigned long       _serial[MAX_DRIVES];
+    std::string         _pending[MAX_DRIVES];
+    bool                _running;
+    bool                _stopping;
 };
 
 }
@@ -109,6 +193,12 @@ public: // public interface
 
     auto get_filename(const int drive) -> std::string;
 
+    auto poll() -> void;
+
+    auto set_turbo(const bool turbo) -> void;
+
+    auto has_turbo() const -> bool;
+
     auto set_motor(uint8_t data) -> uint8_t;
 
     auto rd_stat(uint8_t data) -> uint8_t;
@@ -127,6 +217,7 @@ public: // public interface
 protected: // protected data
     Interface& _interface;
     State      _state;
+    Loader     _loader;
 };
 
 }
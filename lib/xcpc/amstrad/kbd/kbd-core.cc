@@ -66,6 +66,20 @@ struct BasicTraits
     static constexpr uint8_t BIT5 = 0x20;
     static constexpr uint8_t BIT6 = 0x40;
     static constexpr uint8_t BIT7 = 0x80;
+
+    static inline auto lookup_keysym(const XKeyEvent& event) -> KeySym
+    {
+        char   buffer[16] = { '\0' };
+        KeySym keysym = NoSymbol;
+
+        /* display-less events carry the already translated keysym in place of the keycode */ {
+            if(event.display == nullptr) {
+                return static_cast<KeySym>(event.keycode);
+            }
+        }
+        static_cast<void>(::XLookupString(const_cast<XKeyEvent*>(&event), buffer, sizeof(buffer), &keysym, nullptr));
+        return keysym;
+    }
 };
 
 }
@@ -125,8 +139,6 @@ struct StateTraits final
 
     static inline auto decode_english(State& state, const XKeyEvent& event, uint8_t& line, uint8_t& data, uint8_t& mods) -> void
     {
-        char   buffer[16] = { '\0' };
-        size_t buflen = sizeof(buffer);
         KeySym keysym = NoSymbol;
         KeySym keypag = NoSymbol;
 
@@ -151,7 +163,7 @@ struct StateTraits final
             mods = ((mods & ~0x03) | 0x03);
         };
 
-        buflen = ::XLookupString(const_cast<XKeyEvent*>(&event), buffer, buflen, &keysym, nullptr);
+        keysym = lookup_keysym(event);
         keypag = (keysym >> 8);
         if(keypag == 0x00) {
             switch(keysym) {
@@ -571,8 +583,6 @@ struct StateTraits final
 
     static inline auto decode_french(State& state, const XKeyEvent& event, uint8_t& line, uint8_t& data, uint8_t& mods) -> void
     {
-        char   buffer[16] = { '\0' };
-        size_t buflen = sizeof(buffer);
         KeySym keysym = NoSymbol;
         KeySym keypag = NoSymbol;
 
@@ -597,7 +607,7 @@ struct StateTraits final
             mods = ((mods & ~0x03) | 0x03);
         };
 
-        buflen = ::XLookupString(const_cast<XKeyEvent*>(&event), buffer, buflen, &keysym, nullptr);
+        keysym = lookup_keysym(event);
         keypag = (keysym >> 8);
         if(keypag == 0x00) {
             switch(keysym) {
@@ -23,9 +23,20 @@
 #include <cstring>
 #include <cstdint>
 #include <cstdarg>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 #include <memory>
 #include <string>
 #include <vector>
+#include <map>
+#include <mutex>
 #include <iostream>
 #include <stdexcept>
 #include <xcpc/libxcpc-priv.h>
@@ -41,6 +52,8 @@ struct BasicTraits
 {
     using BankType  = mem::BankType;
     using State     = mem::State;
+    using Arena     = mem::Arena;
+    using Rom       = mem::Rom;
     using Instance  = mem::Instance;
     using Interface = mem::Interface;
 };
@@ -56,29 +69,31 @@ namespace {
 struct StateTraits final
     : public BasicTraits
 {
-    static inline auto construct(State& state, const BankType bank_type) -> void
+    static inline auto construct(State& state, const BankType bank_type, uint8_t* data) -> void
     {
+        if(data == nullptr) {
+            throw std::runtime_error("invalid bank data");
+        }
         state.bank_type = bank_type;
+        state.data      = data;
+        static_cast<void>(::memset(state.data, 0, mem::BANK_SIZE));
     }
 
     static inline auto destruct(State& state) -> void
     {
+        state.data = nullptr;
     }
 
     static inline auto reset(State& state) -> void
     {
         auto reset_rom = [&]() -> void
         {
-            for(auto& byte : state.data) {
-                byte |= 0;
-            }
+            /* rom banks keep their contents */
         };
 
         auto reset_ram = [&]() -> void
         {
-            for(auto& byte : state.data) {
-                byte &= 0;
-            }
+            static_cast<void>(::memset(state.data, 0, mem::BANK_SIZE));
         };
 
         auto reset_data = [&]() -> void
@@ -106,17 +121,519 @@ struct StateTraits final
 
 }
 
+// ---------------------------------------------------------------------------
+// <anonymous>::ArenaTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ArenaTraits final
+    : public BasicTraits
+{
+    static constexpr size_t HUGE_PAGE_SIZE = (2UL * 1024UL * 1024UL);
+
+    static inline auto round_up(const size_t value, const size_t alignment) -> size_t
+    {
+        return ((value + (alignment - 1)) / alignment) * alignment;
+    }
+
+#ifdef HAVE_SYS_MMAN_H
+    static inline auto allocate(const size_t size, size_t& mapped, bool& huge_pages) -> uint8_t*
+    {
+        const size_t length = round_up(size, HUGE_PAGE_SIZE);
+
+        auto map_huge_pages = [&]() -> uint8_t*
+        {
+#ifdef MAP_HUGETLB
+            void* addr = ::mmap(nullptr, length, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB), -1, 0);
+            if(addr != MAP_FAILED) {
+                mapped     = length;
+                huge_pages = true;
+                return static_cast<uint8_t*>(addr);
+            }
+#endif
+            return nullptr;
+        };
+
+        auto map_aligned_pages = [&]() -> uint8_t*
+        {
+            const size_t padded = length + HUGE_PAGE_SIZE;
+            void*        addr   = ::mmap(nullptr, padded, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+            if(addr == MAP_FAILED) {
+                throw std::runtime_error("mmap() has failed");
+            }
+            uint8_t*     base = static_cast<uint8_t*>(addr);
+            uint8_t*     data = reinterpret_cast<uint8_t*>(round_up(reinterpret_cast<uintptr_t>(base), HUGE_PAGE_SIZE));
+            const size_t head = (data - base);
+            const size_t tail = (padded - head - length);
+            if(head != 0) {
+                static_cast<void>(::munmap(base, head));
+            }
+            if(tail != 0) {
+                static_cast<void>(::munmap(data + length, tail));
+            }
+            mapped = length;
+#ifdef MADV_HUGEPAGE
+            if(::madvise(data, length, MADV_HUGEPAGE) == 0) {
+                huge_pages = true;
+            }
+#endif
+            return data;
+        };
+
+        uint8_t* data = map_huge_pages();
+        if(data == nullptr) {
+            data = map_aligned_pages();
+        }
+        return data;
+    }
+
+    static inline auto deallocate(uint8_t* data, const size_t mapped) -> void
+    {
+        if(data != nullptr) {
+            static_cast<void>(::munmap(data, mapped));
+        }
+    }
+#else
+    static inline auto allocate(const size_t size, size_t& mapped, bool& huge_pages) -> uint8_t*
+    {
+        void* data = ::calloc(1, size);
+
+        if(data == nullptr) {
+            throw std::runtime_error("calloc() has failed");
+        }
+        mapped     = 0;
+        huge_pages = false;
+        return static_cast<uint8_t*>(data);
+    }
+
+    static inline auto deallocate(uint8_t* data, const size_t mapped) -> void
+    {
+        if(data != nullptr) {
+            ::free(data);
+        }
+    }
+#endif
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ImageTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ImageTraits final
+    : public BasicTraits
+{
+#ifdef HAVE_SYS_MMAN_H
+    static inline auto create(const size_t size) -> int
+    {
+        int handle = -1;
+
+        auto create_handle = [&]() -> void
+        {
+#ifdef HAVE_MEMFD_CREATE
+            handle = ::memfd_create("xcpc-memory-image", MFD_CLOEXEC);
+#else
+            FILE* file = ::tmpfile();
+            if(file != nullptr) {
+                handle = ::dup(::fileno(file));
+                file = (static_cast<void>(::fclose(file)), nullptr);
+            }
+#endif
+            if(handle < 0) {
+                throw std::runtime_error("unable to create the memory image");
+            }
+        };
+
+        auto resize_handle = [&]() -> void
+        {
+            if(::ftruncate(handle, size) != 0) {
+                handle = (static_cast<void>(::close(handle)), -1);
+                throw std::runtime_error("ftruncate() has failed");
+            }
+        };
+
+        create_handle();
+        resize_handle();
+
+        return handle;
+    }
+
+    static inline auto destroy(const int handle) -> void
+    {
+        if(handle >= 0) {
+            static_cast<void>(::close(handle));
+        }
+    }
+
+    static inline auto write(const int handle, const uint8_t* data, size_t size, size_t offset) -> void
+    {
+        while(size != 0) {
+            const ssize_t count = ::pwrite(handle, data, size, offset);
+            if(count < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("pwrite() has failed");
+            }
+            data   += count;
+            size   -= count;
+            offset += count;
+        }
+    }
+#endif
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::RomTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct RomTraits final
+    : public BasicTraits
+{
+    static inline auto hash(const uint8_t* data, size_t size) -> uint64_t
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+
+        while(size-- != 0) {
+            hash ^= *data++;
+            hash *= 0x00000100000001b3ULL;
+        }
+        return hash;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::RomCacheTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct RomCacheTraits final
+    : public BasicTraits
+{
+    using RomPtr  = std::shared_ptr<const Rom>;
+    using RomRef  = std::weak_ptr<const Rom>;
+    using PathMap = std::map<std::string, RomRef>;
+    using HashMap = std::map<uint64_t, RomRef>;
+
+    struct Cache
+    {
+        std::mutex mutex;
+        PathMap    by_path;
+        HashMap    by_hash;
+    };
+
+    static auto cache() -> Cache&
+    {
+        static Cache cache;
+
+        return cache;
+    }
+
+    static auto key_of(const std::string& filename, const size_t offset) -> std::string
+    {
+        return filename + '@' + std::to_string(offset);
+    }
+
+    static auto is_current(const Rom& rom, const std::string& filename) -> bool
+    {
+#ifdef HAVE_SYS_STAT_H
+        struct stat statbuf;
+        if(::stat(filename.c_str(), &statbuf) != 0) {
+            return false;
+        }
+        if(static_cast<uint64_t>(statbuf.st_ino) != rom.inode()) {
+            return false;
+        }
+        if(static_cast<int64_t>(statbuf.st_mtime) != rom.mtime()) {
+            return false;
+        }
+#endif
+        return true;
+    }
+
+    static auto is_same(const Rom& lhs, const Rom& rhs) -> bool
+    {
+        if(lhs.hash() != rhs.hash()) {
+            return false;
+        }
+        return ::memcmp(lhs.data(), rhs.data(), mem::BANK_SIZE) == 0;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::Arena
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+Arena::Arena(const size_t bank_count)
+    : _data(nullptr)
+    , _size(bank_count * BANK_SIZE)
+    , _mapped(0)
+    , _huge_pages(false)
+{
+    if(bank_count == 0) {
+        throw std::runtime_error("invalid bank count");
+    }
+    _data = ArenaTraits::allocate(_size, _mapped, _huge_pages);
+}
+
+Arena::~Arena()
+{
+    _data = (ArenaTraits::deallocate(_data, _mapped), nullptr);
+}
+
+auto Arena::bank(const size_t index) const -> uint8_t*
+{
+    if((index * BANK_SIZE) >= _size) {
+        throw std::runtime_error("invalid bank index");
+    }
+    return _data + (index * BANK_SIZE);
+}
+
+auto Arena::attach(const Image& image) -> void
+{
+    if(image.size() != length()) {
+        throw std::runtime_error("incompatible memory image");
+    }
+#ifdef HAVE_SYS_MMAN_H
+    void* addr = ::mmap(_data, length(), (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_FIXED), image.handle(), 0);
+    if(addr == MAP_FAILED) {
+        throw std::runtime_error("mmap() has failed");
+    }
+    _huge_pages = false;
+#else
+    static_cast<void>(::memcpy(_data, image.data(), _size));
+#endif
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::Image
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+Image::Image(const Arena& arena)
+    : _handle(-1)
+    , _size(arena.length())
+    , _data()
+{
+#ifdef HAVE_SYS_MMAN_H
+    _handle = ImageTraits::create(_size);
+#else
+    _data.resize(_size);
+#endif
+}
+
+Image::~Image()
+{
+#ifdef HAVE_SYS_MMAN_H
+    _handle = (ImageTraits::destroy(_handle), -1);
+#endif
+}
+
+auto Image::store(const Arena& arena, const size_t index) -> void
+{
+    const uint8_t* data   = arena.bank(index);
+    const size_t   offset = (index * BANK_SIZE);
+
+#ifdef HAVE_SYS_MMAN_H
+    ImageTraits::write(_handle, data, BANK_SIZE, offset);
+#else
+    static_cast<void>(::memcpy(&_data[offset], data, BANK_SIZE));
+#endif
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::Rom
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+Rom::Rom(const std::string& filename, const size_t offset)
+    : _data(nullptr)
+    , _mapped(0)
+    , _hash(0)
+    , _inode(0)
+    , _mtime(0)
+    , _buffer()
+{
+    int fd = -1;
+
+    auto file_open = [&]() -> void
+    {
+        if((fd = ::open(filename.c_str(), O_RDONLY)) < 0) {
+            throw std::runtime_error("open() has failed");
+        }
+    };
+
+    auto file_stat = [&]() -> void
+    {
+        struct stat statbuf;
+        if(::fstat(fd, &statbuf) != 0) {
+            throw std::runtime_error("fstat() has failed");
+        }
+        if(static_cast<size_t>(statbuf.st_size) < (offset + BANK_SIZE)) {
+            throw std::runtime_error("rom image is too short");
+        }
+        _inode = static_cast<uint64_t>(statbuf.st_ino);
+        _mtime = static_cast<int64_t>(statbuf.st_mtime);
+    };
+
+    auto file_map = [&]() -> bool
+    {
+#ifdef HAVE_SYS_MMAN_H
+        const long page_size = ::sysconf(_SC_PAGESIZE);
+        if((page_size > 0) && ((offset % page_size) == 0)) {
+            void* addr = ::mmap(nullptr, BANK_SIZE, PROT_READ, MAP_PRIVATE, fd, offset);
+            if(addr != MAP_FAILED) {
+                _data   = static_cast<uint8_t*>(addr);
+                _mapped = BANK_SIZE;
+                return true;
+            }
+        }
+#endif
+        return false;
+    };
+
+    auto file_read = [&]() -> void
+    {
+        _buffer.resize(BANK_SIZE);
+        size_t count = 0;
+        while(count < BANK_SIZE) {
+            const ssize_t rc = ::pread(fd, &_buffer[count], (BANK_SIZE - count), (offset + count));
+            if(rc < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("pread() has failed");
+            }
+            if(rc == 0) {
+                throw std::runtime_error("pread() has failed");
+            }
+            count += rc;
+        }
+        _data = _buffer.data();
+    };
+
+    auto file_close = [&]() -> void
+    {
+        if(fd >= 0) {
+            fd = (static_cast<void>(::close(fd)), -1);
+        }
+    };
+
+    try {
+        file_open();
+        file_stat();
+        if(file_map() == false) {
+            file_read();
+        }
+        file_close();
+    }
+    catch(...) {
+        file_close();
+        throw;
+    }
+    _hash = RomTraits::hash(_data, BANK_SIZE);
+}
+
+Rom::~Rom()
+{
+#ifdef HAVE_SYS_MMAN_H
+    if(_mapped != 0) {
+        static_cast<void>(::munmap(_data, _mapped));
+    }
+#endif
+    _data = nullptr;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::RomCache
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+auto RomCache::acquire(const std::string& filename, const size_t offset) -> std::shared_ptr<const Rom>
+{
+    auto&             cache(RomCacheTraits::cache());
+    const std::string key(RomCacheTraits::key_of(filename, offset));
+    const std::lock_guard<std::mutex> lock(cache.mutex);
+
+    auto lookup_path = [&]() -> std::shared_ptr<const Rom>
+    {
+        auto found = cache.by_path.find(key);
+        if(found != cache.by_path.end()) {
+            auto rom = found->second.lock();
+            if((rom != nullptr) && RomCacheTraits::is_current(*rom, filename)) {
+                return rom;
+            }
+            cache.by_path.erase(found);
+        }
+        return nullptr;
+    };
+
+    auto lookup_hash = [&](std::shared_ptr<const Rom> rom) -> std::shared_ptr<const Rom>
+    {
+        auto found = cache.by_hash.find(rom->hash());
+        if(found != cache.by_hash.end()) {
+            auto other = found->second.lock();
+            if((other != nullptr) && RomCacheTraits::is_same(*rom, *other)) {
+                return other;
+            }
+        }
+        cache.by_hash[rom->hash()] = rom;
+        return rom;
+    };
+
+    auto acquire_rom = [&]() -> std::shared_ptr<const Rom>
+    {
+        auto rom = lookup_path();
+        if(rom == nullptr) {
+            rom = lookup_hash(std::make_shared<const Rom>(filename, offset));
+            cache.by_path[key] = rom;
+        }
+        return rom;
+    };
+
+    return acquire_rom();
+}
+
+}
+
 // ---------------------------------------------------------------------------
 // mem::Instance
 // ---------------------------------------------------------------------------
 
 namespace mem {
 
-Instance::Instance(const BankType bank_type, Interface& interface)
+Instance::Instance(const BankType bank_type, Interface& interface, uint8_t* data)
     : _interface(interface)
     , _state()
+    , _pending()
+    , _bank(data)
+    , _rom()
 {
-    StateTraits::construct(_state, bank_type);
+    StateTraits::construct(_state, bank_type, data);
 
     reset();
 }
@@ -138,9 +655,40 @@ auto Instance::clock() -> void
 
 auto Instance::load(const std::string& filename, size_t offset) -> void
 {
+    struct stat status;
+
+    auto check_file = [&]() -> void
+    {
+        if(::access(filename.c_str(), R_OK) != 0) {
+            throw std::runtime_error("access() has failed");
+        }
+        if(::stat(filename.c_str(), &status) != 0) {
+            throw std::runtime_error("stat() has failed");
+        }
+        if(S_ISREG(status.st_mode) == 0) {
+            throw std::runtime_error("not a regular file");
+        }
+        if(static_cast<uint64_t>(status.st_size) < (offset + BANK_SIZE)) {
+            throw std::runtime_error("file is too short");
+        }
+    };
+
+    if(filename.empty() != false) {
+        throw std::runtime_error("invalid filename");
+    }
+    check_file();
+    _pending.filename = filename;
+    _pending.offset   = offset;
+}
+
+auto Instance::commit() -> void
+{
+    const Pending    pending(_pending);
+    const auto&      filename(pending.filename);
+    const size_t     offset = pending.offset;
     FILE*            file = nullptr;
     void*            data = _state.data;
-    constexpr size_t size = sizeof(_state.data);
+    constexpr size_t size = BANK_SIZE;
 
     auto file_open = [&]() -> void
     {
@@ -171,21 +719,57 @@ auto Instance::load(const std::string& filename, size_t offset) -> void
         }
     };
 
-    try {
-        file_open();
-        file_seek();
-        file_read();
-        file_close();
+    auto load_rom = [&]() -> void
+    {
+        _rom = RomCache::acquire(filename, offset);
+        _state.data = const_cast<uint8_t*>(_rom->data());
+    };
+
+    auto load_ram = [&]() -> void
+    {
+        try {
+            file_open();
+            file_seek();
+            file_read();
+            file_close();
+        }
+        catch(...) {
+            file_close();
+            throw;
+        }
+    };
+
+    if(filename.empty() != false) {
+        return;
     }
-    catch(...) {
-        file_close();
-        throw;
+    _pending = Pending();
+    if(_state.bank_type == BankType::ROM_BANK) {
+        load_rom();
+    }
+    else {
+        load_ram();
+    }
+}
+
+auto Instance::share(const Instance& other) -> void
+{
+    _pending = other._pending;
+    _rom     = other._rom;
+    if(_rom != nullptr) {
+        _state.data = const_cast<uint8_t*>(_rom->data());
+    }
+    else {
+        _state.data = _bank;
+        static_cast<void>(::memcpy(_state.data, other._state.data, BANK_SIZE));
     }
 }
 
 auto Instance::fetch(uint8_t* data, const size_t size) -> void
 {
-    if((data != nullptr) && (size == sizeof(_state.data))) {
+    if(_pending.filename.empty() == false) {
+        commit();
+    }
+    if((data != nullptr) && (size == BANK_SIZE)) {
         static_cast<void>(::memcpy(data, _state.data, size));
     }
     else {
@@ -195,7 +779,14 @@ auto Instance::fetch(uint8_t* data, const size_t size) -> void
 
 auto Instance::store(uint8_t* data, const size_t size) -> void
 {
-    if((data != nullptr) && (size == sizeof(_state.data))) {
+    if(_pending.filename.empty() == false) {
+        _pending = Pending();
+    }
+    if(_rom != nullptr) {
+        _rom.reset();
+        _state.data = _bank;
+    }
+    if((data != nullptr) && (size == BANK_SIZE)) {
         static_cast<void>(::memcpy(_state.data, data, size));
     }
     else {
@@ -24,6 +24,10 @@
 namespace mem {
 
 struct State;
+class  Arena;
+class  Image;
+class  Rom;
+class  RomCache;
 class  Instance;
 class  Interface;
 
@@ -43,6 +47,16 @@ enum BankType
 
 }
 
+// ---------------------------------------------------------------------------
+// mem::BankSize
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+constexpr size_t BANK_SIZE = 16384;
+
+}
+
 // ---------------------------------------------------------------------------
 // mem::State
 // ---------------------------------------------------------------------------
@@ -51,8 +65,174 @@ namespace mem {
 
 struct State
 {
-    uint8_t bank_type;
-    uint8_t data[16384];
+    uint8_t  bank_type;
+    uint8_t* data;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::Arena
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+class Arena
+{
+public: // public interface
+    Arena(const size_t bank_count);
+
+    Arena(Arena&&) = delete;
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(Arena&&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    virtual ~Arena();
+
+    auto bank(const size_t index) const -> uint8_t*;
+
+    auto attach(const Image& image) -> void;
+
+    auto data() const -> uint8_t*
+    {
+        return _data;
+    }
+
+    auto size() const -> size_t
+    {
+        return _size;
+    }
+
+    auto length() const -> size_t
+    {
+        return (_mapped != 0 ? _mapped : _size);
+    }
+
+    auto huge_pages() const -> bool
+    {
+        return _huge_pages;
+    }
+
+private: // private data
+    uint8_t* _data;
+    size_t   _size;
+    size_t   _mapped;
+    bool     _huge_pages;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::Image
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+class Image
+{
+public: // public interface
+    Image(const Arena& arena);
+
+    Image(Image&&) = delete;
+
+    Image(const Image&) = delete;
+
+    Image& operator=(Image&&) = delete;
+
+    Image& operator=(const Image&) = delete;
+
+    virtual ~Image();
+
+    auto store(const Arena& arena, const size_t index) -> void;
+
+    auto handle() const -> int
+    {
+        return _handle;
+    }
+
+    auto data() const -> const uint8_t*
+    {
+        return _data.data();
+    }
+
+    auto size() const -> size_t
+    {
+        return _size;
+    }
+
+private: // private data
+    int                  _handle;
+    size_t               _size;
+    std::vector<uint8_t> _data;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::Rom
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+class Rom
+{
+public: // public interface
+    Rom(const std::string& filename, const size_t offset);
+
+    Rom(Rom&&) = delete;
+
+    Rom(const Rom&) = delete;
+
+    Rom& operator=(Rom&&) = delete;
+
+    Rom& operator=(const Rom&) = delete;
+
+    virtual ~Rom();
+
+    auto data() const -> const uint8_t*
+    {
+        return _data;
+    }
+
+    auto hash() const -> uint64_t
+    {
+        return _hash;
+    }
+
+    auto inode() const -> uint64_t
+    {
+        return _inode;
+    }
+
+    auto mtime() const -> int64_t
+    {
+        return _mtime;
+    }
+
+private: // private data
+    uint8_t*             _data;
+    size_t               _mapped;
+    uint64_t             _hash;
+    uint64_t             _inode;
+    int64_t              _mtime;
+    std::vector<uint8_t> _buffer;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// mem::RomCache
+// ---------------------------------------------------------------------------
+
+namespace mem {
+
+class RomCache
+{
+public: // public interface
+    static auto acquire(const std::string& filename, const size_t offset) -> std::shared_ptr<const Rom>;
 };
 
 }
@@ -66,7 +246,7 @@ namespace mem {
 class Instance
 {
 public: // public interface
-    Instance(const BankType bank_type, Interface& interface);
+    Instance(const BankType bank_type, Interface& interface, uint8_t* data);
 
     Instance(Instance&&) = delete;
 
@@ -84,6 +264,10 @@ public: // public interface
 
     auto load(const std::string& filename, size_t offset) -> void;
 
+    auto commit() -> void;
+
+    auto share(const Instance& other) -> void;
+
     auto fetch(uint8_t* data, const size_t size) -> void;
 
     auto store(uint8_t* data, const size_t size) -> void;
@@ -93,9 +277,27 @@ public: // public interface
         return &_state;
     }
 
+    auto map() -> uint8_t*
+    {
+        if(_pending.filename.empty() == false) {
+            commit();
+        }
+        return _state.data;
+    }
+
+protected: // protected types
+    struct Pending
+    {
+        std::string filename;
+        size_t      offset = 0;
+    };
+
 protected: // protected data
-    Interface& _interface;
-    State      _state;
+    Interface&                 _interface;
+    State                      _state;
+    Pending                    _pending;
+    uint8_t*                   _bank;
+    std::shared_ptr<const Rom> _rom;
 };
 
 }
@@ -41,7 +41,7 @@ struct BasicTraits
 {
     using State     = vga::State;
     using Colormap  = vga::Colormap;
-    using Scanline  = vga::Scanline;
+    using Palette   = vga::Palette;
     using Instance  = vga::Instance;
     using Interface = vga::Interface;
 
@@ -53,6 +53,8 @@ struct BasicTraits
     static constexpr uint8_t BIT5 = 0x20;
     static constexpr uint8_t BIT6 = 0x40;
     static constexpr uint8_t BIT7 = 0x80;
+
+    static constexpr uint16_t PALETTE_COUNT = (sizeof(State::palette) / sizeof(State::palette[0]));
 };
 
 }
@@ -141,9 +143,33 @@ struct StateTraits final
         state.r02 &= 0;
         state.frame_x &= 0;
         state.frame_y &= 0;
+        state.generation = 0;
+        state.current    = (PALETTE_COUNT - 1);
+        for(auto& palette : state.palette) {
+            palette = Palette();
+        }
         for(auto& scanline : state.scanline) {
-            scanline = Scanline();
+            scanline = 0;
         }
+        publish(state);
+    }
+
+    static inline auto publish(State& state) -> void
+    {
+        /*
+         * the palette versions are recycled in a ring, the pool is large
+         * enough to keep every version referenced by the scanlines of the
+         * frames that have not been rendered yet
+         */
+        const uint16_t current = ((state.current + 1) % PALETTE_COUNT);
+        Palette& palette(state.palette[current]);
+
+        palette.generation = state.generation;
+        palette.mode       = (state.rmr & 0x03);
+        for(int index = 0; index < 17; ++index) {
+            palette.ink[index] = state.ink[index];
+        }
+        state.current = current;
     }
 
     static inline auto clock(State& state) -> void
@@ -197,9 +223,15 @@ auto Instance::set_value(uint8_t value) -> uint8_t
             _state.pen = ((value & 0x10) != 0 ? (value & 0x10) : (value & 0x0f));
             break;
         case 1: /* ink */
+            if(_state.ink[_state.pen] != (value & 0x1f)) {
+                ++_state.generation;
+            }
             _state.ink[_state.pen] = (value & 0x1f);
             break;
         case 2: /* interrupt control, rom configuration and screen mode */
+            if((_state.rmr & 0x03) != (value & 0x03)) {
+                ++_state.generation;
+            }
             _state.rmr = (value & 0x1f);
             if((value & 0x10) != 0) {
                 _state.r52 = 0;
@@ -222,17 +254,11 @@ auto Instance::assert_hsync(uint8_t hsync) -> void
 {
     auto on_rising_edge = [&]() -> void
     {
+        if(_state.palette[_state.current].generation != _state.generation) {
+            StateTraits::publish(_state);
+        }
         if(++_state.frame_y < 576) {
-            Scanline& scanline(_state.scanline[_state.frame_y]);
-            scanline.mode = (_state.rmr & 0x03);
-            int index = 0;
-            for(const auto ink : _state.ink) {
-                auto& entry(scanline.color[index]);
-                entry.ink    = ink;
-                entry.pixel0 = _state.colormap.pixel0[ink];
-                entry.pixel1 = _state.colormap.pixel1[ink];
-                ++index;
-            }
+            _state.scanline[_state.frame_y] = _state.current;
         }
         else {
             _state.frame_y = 575;
@@ -283,6 +309,11 @@ auto Instance::assert_vsync(uint8_t vsync) -> void
     }
 }
 
+auto Instance::invalidate() -> void
+{
+    ++_state.generation;
+}
+
 }
 
 // ---------------------------------------------------------------------------
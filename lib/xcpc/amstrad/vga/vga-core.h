@@ -24,6 +24,7 @@
 namespace vga {
 
 struct State;
+struct Palette;
 class  Instance;
 class  Interface;
 
@@ -44,19 +45,16 @@ struct Colormap
 }
 
 // ---------------------------------------------------------------------------
-// vga::Scanline
+// vga::Palette
 // ---------------------------------------------------------------------------
 
 namespace vga {
 
-struct Scanline
+struct Palette
 {
-    uint8_t mode;
-    struct {
-        uint8_t  ink;
-        uint32_t pixel0;
-        uint32_t pixel1;
-    } color[17];
+    uint32_t generation;
+    uint8_t  mode;
+    uint8_t  ink[17];
 };
 
 }
@@ -81,7 +79,10 @@ struct State
     uint8_t  mode2[256];
     uint8_t  mode3[256];
     Colormap colormap;
-    Scanline scanline[576];
+    uint32_t generation;
+    uint16_t current;
+    Palette  palette[1024];
+    uint16_t scanline[576];
 };
 
 }
@@ -121,6 +122,8 @@ public: // public interface
 
     auto assert_vsync(uint8_t hsync) -> void;
 
+    auto invalidate() -> void;
+
     auto operator->() -> State*
     {
         return &_state;
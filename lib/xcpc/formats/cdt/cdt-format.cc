@@ -39,10 +39,46 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include "cdt-format.h"
 
+// ---------------------------------------------------------------------------
+// <anonymous>::TapeTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct TapeTraits
+{
+    static constexpr char     SIGNATURE[]   = "ZXTape!\x1a";
+    static constexpr uint32_t HEADER_SIZE   = 10;
+    static constexpr uint32_t FIRST_BLOCK   = HEADER_SIZE;
+    static constexpr uint32_t PAUSE_EDGE    = 3500;
+    static constexpr uint32_t MAXIMUM_RUN   = 32768;
+    static constexpr uint32_t MAXIMUM_STEPS = 65536;
+
+    static auto error(const std::string& filename, const char* message) -> std::runtime_error
+    {
+        return std::runtime_error(std::string() + '<' + filename + '>' + ' ' + message);
+    }
+
+    static auto get_ticks_per_ms() -> uint32_t
+    {
+        return cdt::Tape::TAPE_CLOCK / 1000;
+    }
+};
+
+constexpr char     TapeTraits::SIGNATURE[];
+constexpr uint32_t TapeTraits::HEADER_SIZE;
+constexpr uint32_t TapeTraits::FIRST_BLOCK;
+constexpr uint32_t TapeTraits::PAUSE_EDGE;
+constexpr uint32_t TapeTraits::MAXIMUM_RUN;
+constexpr uint32_t TapeTraits::MAXIMUM_STEPS;
+
+}
+
 // ---------------------------------------------------------------------------
 // cdt::Tape
 // ---------------------------------------------------------------------------
@@ -50,7 +86,552 @@
 namespace cdt {
 
 Tape::Tape(const std::string& filename)
+    : _filename(filename)
+    , _fd(-1)
+    , _size(0)
+    , _buffer(BUFFER_SIZE)
+    , _buffer_offset(0)
+    , _buffer_length(0)
+    , _blocks()
+    , _loops()
+    , _calls()
+    , _block()
+    , _index(0)
+    , _phase(PHASE_BLOCK)
+    , _counter(0)
+    , _byte(0)
+    , _bit(0)
+    , _half(0)
+    , _level(0)
+    , _stopped(false)
+    , _ended(false)
+    , _position(0)
+    , _deadline(0)
+{
+    auto do_open = [&]() -> void
+    {
+        _fd = ::open(_filename.c_str(), O_RDONLY);
+        if(_fd < 0) {
+            throw TapeTraits::error(_filename, "could not be opened");
+        }
+    };
+
+    auto do_stat = [&]() -> void
+    {
+        struct stat statbuf;
+        if(::fstat(_fd, &statbuf) != 0) {
+            throw TapeTraits::error(_filename, "could not be examined");
+        }
+        if(static_cast<uint64_t>(statbuf.st_size) > UINT32_MAX) {
+            throw TapeTraits::error(_filename, "is too large");
+        }
+        _size = statbuf.st_size;
+    };
+
+    try {
+        do_open();
+        do_stat();
+        check_header();
+        rewind();
+    }
+    catch(...) {
+        if(_fd >= 0) {
+            _fd = (::close(_fd), -1);
+        }
+        throw;
+    }
+}
+
+Tape::~Tape()
+{
+    if(_fd >= 0) {
+        _fd = (::close(_fd), -1);
+    }
+}
+
+void Tape::rewind()
+{
+    if(_blocks.empty()) {
+        _blocks.push_back(TapeTraits::FIRST_BLOCK);
+    }
+    _loops.clear();
+    _calls.clear();
+    _block    = Block();
+    _index    = 0;
+    _phase    = PHASE_BLOCK;
+    _counter  = 0;
+    _byte     = 0;
+    _bit      = 0;
+    _half     = 0;
+    _level    = 0;
+    _stopped  = false;
+    _ended    = false;
+    _position = 0;
+    _deadline = 0;
+}
+
+void Tape::play()
+{
+    _stopped = false;
+}
+
+auto Tape::advance(const uint32_t ticks) -> uint8_t
+{
+    if((_stopped != false) || (_ended != false)) {
+        return _level;
+    }
+    _position += (static_cast<uint64_t>(ticks) * TAPE_CLOCK);
+    while(_position >= _deadline) {
+        Event event;
+        _position -= _deadline;
+        if(next_event(event) == false) {
+            _position = 0;
+            _deadline = 0;
+            break;
+        }
+        _level    = event.level;
+        _deadline = (static_cast<uint64_t>(event.duration) * CPU_CLOCK);
+    }
+    return _level;
+}
+
+void Tape::check_header()
+{
+    if(_size < TapeTraits::HEADER_SIZE) {
+        throw TapeTraits::error(_filename, "is not a CDT/TZX tape image");
+    }
+    for(uint32_t offset = 0; offset < (TapeTraits::HEADER_SIZE - 2); ++offset) {
+        if(fetch_u8(offset) != static_cast<uint8_t>(TapeTraits::SIGNATURE[offset])) {
+            throw TapeTraits::error(_filename, "is not a CDT/TZX tape image");
+        }
+    }
+    if(fetch_u8(8) != 1) {
+        throw TapeTraits::error(_filename, "has an unsupported CDT/TZX major version");
+    }
+}
+
+auto Tape::fetch_u8(const uint32_t offset) -> uint8_t
+{
+    if(offset >= _size) {
+        throw TapeTraits::error(_filename, "is truncated");
+    }
+    if((offset < _buffer_offset) || (offset >= (_buffer_offset + _buffer_length))) {
+        const ssize_t rc = ::pread(_fd, _buffer.data(), _buffer.size(), offset);
+        if(rc <= 0) {
+            throw TapeTraits::error(_filename, "could not be read");
+        }
+        _buffer_offset = offset;
+        _buffer_length = rc;
+    }
+    return _buffer[offset - _buffer_offset];
+}
+
+auto Tape::fetch_u16(const uint32_t offset) -> uint16_t
+{
+    return static_cast<uint16_t>(fetch_u8(offset + 0) << 0)
+         | static_cast<uint16_t>(fetch_u8(offset + 1) << 8)
+         ;
+}
+
+auto Tape::fetch_u24(const uint32_t offset) -> uint32_t
+{
+    return (static_cast<uint32_t>(fetch_u16(offset + 0)) <<  0)
+         | (static_cast<uint32_t>(fetch_u8 (offset + 2)) << 16)
+         ;
+}
+
+auto Tape::fetch_u32(const uint32_t offset) -> uint32_t
+{
+    return (static_cast<uint32_t>(fetch_u16(offset + 0)) <<  0)
+         | (static_cast<uint32_t>(fetch_u16(offset + 2)) << 16)
+         ;
+}
+
+void Tape::parse_block(const uint32_t offset, Block& block)
+{
+    const uint32_t body = offset + 1;
+
+    block        = Block();
+    block.offset = offset;
+    block.type   = fetch_u8(offset);
+    switch(block.type) {
+        case BLOCK_STANDARD_SPEED:
+            block.pause       = fetch_u16(body + 0);
+            block.length      = fetch_u16(body + 2);
+            block.data        = body + 4;
+            block.pilot_pulse = 2168;
+            block.pilot_count = ((block.length == 0) || (fetch_u8(block.data) < 128) ? 8063 : 3223);
+            block.sync1_pulse = 667;
+            block.sync2_pulse = 735;
+            block.zero_pulse  = 855;
+            block.one_pulse   = 1710;
+            break;
+        case BLOCK_TURBO_SPEED:
+            block.pilot_pulse = fetch_u16(body +  0);
+            block.sync1_pulse = fetch_u16(body +  2);
+            block.sync2_pulse = fetch_u16(body +  4);
+            block.zero_pulse  = fetch_u16(body +  6);
+            block.one_pulse   = fetch_u16(body +  8);
+            block.pilot_count = fetch_u16(body + 10);
+            block.used_bits   = fetch_u8 (body + 12);
+            block.pause       = fetch_u16(body + 13);
+            block.length      = fetch_u24(body + 15);
+            block.data        = body + 18;
+            break;
+        case BLOCK_PURE_TONE:
+            block.pilot_pulse = fetch_u16(body + 0);
+            block.pilot_count = fetch_u16(body + 2);
+            block.data        = body + 4;
+            break;
+        case BLOCK_PULSE_SEQUENCE:
+            block.length = (fetch_u8(body) * 2);
+            block.data   = body + 1;
+            break;
+        case BLOCK_PURE_DATA:
+            block.zero_pulse = fetch_u16(body + 0);
+            block.one_pulse  = fetch_u16(body + 2);
+            block.used_bits  = fetch_u8 (body + 4);
+            block.pause      = fetch_u16(body + 5);
+            block.length     = fetch_u24(body + 7);
+            block.data       = body + 10;
+            break;
+        case BLOCK_DIRECT_RECORD:
+            /* the sample length is kept as the pilot pulse length */
+            block.pilot_pulse = fetch_u16(body + 0);
+            block.pause       = fetch_u16(body + 2);
+            block.used_bits   = fetch_u8 (body + 4);
+            block.length      = fetch_u24(body + 5);
+            block.data        = body + 8;
+            break;
+        case BLOCK_PAUSE:
+            block.pause = fetch_u16(body);
+            block.data  = body + 2;
+            break;
+        case BLOCK_GROUP_START:
+        case BLOCK_TEXT:
+            block.length = fetch_u8(body);
+            block.data   = body + 1;
+            break;
+        case BLOCK_GROUP_END:
+        case BLOCK_LOOP_END:
+        case BLOCK_RETURN:
+            block.data = body;
+            break;
+        case BLOCK_JUMP:
+        case BLOCK_LOOP_START:
+            block.length = 2;
+            block.data   = body;
+            break;
+        case BLOCK_CALL_SEQUENCE:
+            block.length = 2 + (fetch_u16(body) * 2);
+            block.data   = body;
+            break;
+        case BLOCK_SELECT:
+        case BLOCK_ARCHIVE_INFO:
+            block.length = fetch_u16(body);
+            block.data   = body + 2;
+            break;
+        case BLOCK_MESSAGE:
+            block.length = fetch_u8(body + 1);
+            block.data   = body + 2;
+            break;
+        case BLOCK_HARDWARE_TYPE:
+            block.length = (fetch_u8(body) * 3);
+            block.data   = body + 1;
+            break;
+        case BLOCK_EMULATION_INFO:
+            block.length = 8;
+            block.data   = body;
+            break;
+        case BLOCK_CUSTOM_INFO:
+            block.length = fetch_u32(body + 16);
+            block.data   = body + 20;
+            break;
+        case BLOCK_SNAPSHOT:
+            block.length = fetch_u24(body + 1);
+            block.data   = body + 4;
+            break;
+        case BLOCK_GLUE:
+            block.length = 9;
+            block.data   = body;
+            break;
+        default:
+            /* every other block (csw, generalized data, stop the tape if in 48k mode, ...) starts with its length */
+            block.length = fetch_u32(body);
+            block.data   = body + 4;
+            break;
+    }
+    if((block.used_bits == 0) || (block.used_bits > 8)) {
+        block.used_bits = 8;
+    }
+    if((static_cast<uint64_t>(block.data) + block.length) > _size) {
+        throw TapeTraits::error(_filename, "has a truncated block");
+    }
+    block.next = block.data + block.length;
+}
+
+void Tape::seek_block(const int64_t index)
+{
+    if(index < 0) {
+        _ended = true;
+        return;
+    }
+    while(_blocks.size() <= static_cast<uint64_t>(index)) {
+        const uint32_t offset = _blocks.back();
+        if(offset >= _size) {
+            _ended = true;
+            return;
+        }
+        Block block;
+        parse_block(offset, block);
+        _blocks.push_back(block.next);
+    }
+    _index = static_cast<uint32_t>(index);
+    _phase = PHASE_BLOCK;
+}
+
+auto Tape::next_event(Event& event) -> bool
+{
+    auto pulse = [&](const uint32_t duration) -> bool
+    {
+        event.duration = duration;
+        event.level    = (_level ^ 1);
+        return true;
+    };
+
+    for(uint32_t step = 0; step < TapeTraits::MAXIMUM_STEPS; ++step) {
+        if((_stopped != false) || (_ended != false)) {
+            return false;
+        }
+        switch(_phase) {
+            case PHASE_BLOCK:
+                if(start_block(event) != false) {
+                    return true;
+                }
+                break;
+            case PHASE_PILOT:
+                if(_counter < _block.pilot_count) {
+                    ++_counter;
+                    return pulse(_block.pilot_pulse);
+                }
+                _phase = PHASE_SYNC1;
+                break;
+            case PHASE_SYNC1:
+                _phase = PHASE_SYNC2;
+                if(_block.sync1_pulse != 0) {
+                    return pulse(_block.sync1_pulse);
+                }
+                break;
+            case PHASE_SYNC2:
+                _phase = PHASE_DATA;
+                if(_block.sync2_pulse != 0) {
+                    return pulse(_block.sync2_pulse);
+                }
+                break;
+            case PHASE_DATA:
+                if(_block.type == BLOCK_DIRECT_RECORD) {
+                    if(next_sample(event) != false) {
+                        return true;
+                    }
+                }
+                else if(_block.type == BLOCK_PULSE_SEQUENCE) {
+                    if(_byte < _block.length) {
+                        const uint16_t duration = fetch_u16(_block.data + _byte);
+                        _byte += 2;
+                        return pulse(duration);
+                    }
+                }
+                else {
+                    if(_half == 0) {
+                        const int bit = next_bit();
+                        if(bit >= 0) {
+                            _counter = (bit != 0 ? _block.one_pulse : _block.zero_pulse);
+                        }
+                        else {
+                            _counter = 0;
+                        }
+                    }
+                    if(_counter != 0) {
+                        _half ^= 1;
+                        return pulse(_counter);
+                    }
+                }
+                if(start_pause(event) != false) {
+                    return true;
+                }
+                break;
+            case PHASE_PAUSE:
+                finish_block();
+                if(_counter != 0) {
+                    event.duration = _counter;
+                    event.level    = 0;
+                    return true;
+                }
+                break;
+            default:
+                _ended = true;
+                break;
+        }
+    }
+    /* a tape that loops forever without producing any pulse is treated as ended */ {
+        _ended = true;
+    }
+    return false;
+}
+
+auto Tape::start_block(Event& event) -> bool
+{
+    const uint32_t offset = _blocks[_index];
+
+    if(offset >= _size) {
+        _ended = true;
+        return false;
+    }
+    parse_block(offset, _block);
+    if((_index + 1) == _blocks.size()) {
+        _blocks.push_back(_block.next);
+    }
+    _counter = 0;
+    _byte    = 0;
+    _bit     = 0;
+    _half    = 0;
+    switch(_block.type) {
+        case BLOCK_STANDARD_SPEED:
+        case BLOCK_TURBO_SPEED:
+        case BLOCK_PURE_TONE:
+            _phase = PHASE_PILOT;
+            break;
+        case BLOCK_PULSE_SEQUENCE:
+        case BLOCK_PURE_DATA:
+        case BLOCK_DIRECT_RECORD:
+            _phase = PHASE_DATA;
+            break;
+        case BLOCK_PAUSE:
+            if(_block.pause == 0) {
+                finish_block();
+                _stopped = true;
+                return false;
+            }
+            return start_pause(event);
+        case BLOCK_JUMP:
+            if(fetch_u16(_block.data) == 0) {
+                _ended = true;
+                return false;
+            }
+            seek_block(static_cast<int64_t>(_index) + static_cast<int16_t>(fetch_u16(_block.data)));
+            break;
+        case BLOCK_LOOP_START:
+            finish_block();
+            _loops.push_back(Loop { _index, static_cast<uint16_t>(std::max(fetch_u16(_block.data), uint16_t(1)) - 1) });
+            break;
+        case BLOCK_LOOP_END:
+            if((_loops.empty() == false) && (_loops.back().count != 0)) {
+                _loops.back().count -= 1;
+                seek_block(_loops.back().block);
+            }
+            else {
+                if(_loops.empty() == false) {
+                    _loops.pop_back();
+                }
+                finish_block();
+            }
+            break;
+        case BLOCK_CALL_SEQUENCE:
+            if(fetch_u16(_block.data) == 0) {
+                finish_block();
+                break;
+            }
+            _calls.push_back(Call { _index, _block.data, 0, fetch_u16(_block.data) });
+            seek_block(static_cast<int64_t>(_index) + static_cast<int16_t>(fetch_u16(_block.data + 2)));
+            break;
+        case BLOCK_RETURN:
+            if(_calls.empty() != false) {
+                finish_block();
+                break;
+            }
+            if(++_calls.back().index < _calls.back().count) {
+                const Call& call(_calls.back());
+                seek_block(static_cast<int64_t>(call.block) + static_cast<int16_t>(fetch_u16(call.data + 2 + (call.index * 2))));
+            }
+            else {
+                const uint32_t block = _calls.back().block;
+                _calls.pop_back();
+                seek_block(static_cast<int64_t>(block) + 1);
+            }
+            break;
+        case BLOCK_SIGNAL_LEVEL:
+            finish_block();
+            event.duration = 0;
+            event.level    = (fetch_u8(_block.data) != 0 ? 1 : 0);
+            return true;
+        default:
+            finish_block();
+            break;
+    }
+    return false;
+}
+
+auto Tape::next_bit() -> int
+{
+    if(_byte >= _block.length) {
+        return -1;
+    }
+    const uint8_t bits  = ((_byte + 1) == _block.length ? _block.used_bits : 8);
+    const uint8_t value = fetch_u8(_block.data + _byte);
+    const int     bit   = ((value & (0x80 >> _bit)) != 0 ? 1 : 0);
+
+    if(++_bit >= bits) {
+        _bit = 0;
+        ++_byte;
+    }
+    return bit;
+}
+
+auto Tape::next_sample(Event& event) -> bool
+{
+    const int level = next_bit();
+    uint32_t  count = 1;
+
+    if(level < 0) {
+        return false;
+    }
+    /* merge the consecutive samples of the same level into a single event */ {
+        while(count < TapeTraits::MAXIMUM_RUN) {
+            const uint32_t byte = _byte;
+            const uint8_t  bit  = _bit;
+            if(next_bit() != level) {
+                _byte = byte;
+                _bit  = bit;
+                break;
+            }
+            ++count;
+        }
+    }
+    event.duration = (count * _block.pilot_pulse);
+    event.level    = static_cast<uint8_t>(level);
+
+    return true;
+}
+
+auto Tape::start_pause(Event& event) -> bool
+{
+    const uint32_t pause = (_block.pause * TapeTraits::get_ticks_per_ms());
+
+    if(pause == 0) {
+        finish_block();
+        return false;
+    }
+    _phase         = PHASE_PAUSE;
+    _counter       = (pause - std::min(pause, TapeTraits::PAUSE_EDGE));
+    event.duration = std::min(pause, TapeTraits::PAUSE_EDGE);
+    event.level    = (_level ^ 1);
+
+    return true;
+}
+
+void Tape::finish_block()
 {
+    seek_block(static_cast<int64_t>(_index) + 1);
 }
 
 }
@@ -17,6 +17,45 @@
 #ifndef __XCPC_CDT_FORMAT_H__
 #define __XCPC_CDT_FORMAT_H__
 
+// ---------------------------------------------------------------------------
+// cdt::BlockType
+// ---------------------------------------------------------------------------
+
+namespace cdt {
+
+enum BlockType
+{
+    BLOCK_STANDARD_SPEED = 0x10,
+    BLOCK_TURBO_SPEED    = 0x11,
+    BLOCK_PURE_TONE      = 0x12,
+    BLOCK_PULSE_SEQUENCE = 0x13,
+    BLOCK_PURE_DATA      = 0x14,
+    BLOCK_DIRECT_RECORD  = 0x15,
+    BLOCK_CSW_RECORD     = 0x18,
+    BLOCK_GENERALIZED    = 0x19,
+    BLOCK_PAUSE          = 0x20,
+    BLOCK_GROUP_START    = 0x21,
+    BLOCK_GROUP_END      = 0x22,
+    BLOCK_JUMP           = 0x23,
+    BLOCK_LOOP_START     = 0x24,
+    BLOCK_LOOP_END       = 0x25,
+    BLOCK_CALL_SEQUENCE  = 0x26,
+    BLOCK_RETURN         = 0x27,
+    BLOCK_SELECT         = 0x28,
+    BLOCK_STOP_48K       = 0x2a,
+    BLOCK_SIGNAL_LEVEL   = 0x2b,
+    BLOCK_TEXT           = 0x30,
+    BLOCK_MESSAGE        = 0x31,
+    BLOCK_ARCHIVE_INFO   = 0x32,
+    BLOCK_HARDWARE_TYPE  = 0x33,
+    BLOCK_EMULATION_INFO = 0x34,
+    BLOCK_CUSTOM_INFO    = 0x35,
+    BLOCK_SNAPSHOT       = 0x40,
+    BLOCK_GLUE           = 0x5a,
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // cdt::Tape
 // ---------------------------------------------------------------------------
@@ -25,6 +64,30 @@ namespace cdt {
 
 class Tape
 {
+public: // public types
+    struct Block
+    {
+        uint32_t offset      = 0; /* offset of the block id        */
+        uint32_t next        = 0; /* offset of the next block      */
+        uint32_t data        = 0; /* offset of the block payload   */
+        uint32_t length      = 0; /* length of the block payload   */
+        uint8_t  type        = 0; /* block id                      */
+        uint8_t  used_bits   = 8; /* used bits in the last byte    */
+        uint16_t pilot_pulse = 0; /* pilot pulse length            */
+        uint16_t pilot_count = 0; /* number of pilot pulses        */
+        uint16_t sync1_pulse = 0; /* first sync pulse length       */
+        uint16_t sync2_pulse = 0; /* second sync pulse length      */
+        uint16_t zero_pulse  = 0; /* zero bit pulse length         */
+        uint16_t one_pulse   = 0; /* one bit pulse length          */
+        uint16_t pause       = 0; /* pause after the block, in ms  */
+    };
+
+    struct Event
+    {
+        uint32_t duration = 0; /* length in tape T-states      */
+        uint8_t  level    = 0; /* signal level during the event */
+    };
+
 public: // public interface
     Tape(const std::string& filename);
 
@@ -36,7 +99,118 @@ public: // public interface
 
     Tape& operator=(const Tape&) = delete;
 
-    virtual ~Tape() = default;
+    virtual ~Tape();
+
+    void rewind();
+
+    void play();
+
+    auto advance(const uint32_t ticks) -> uint8_t;
+
+    auto get_filename() const -> const std::string&
+    {
+        return _filename;
+    }
+
+    auto get_level() const -> uint8_t
+    {
+        return _level;
+    }
+
+    auto get_block_index() const -> uint32_t
+    {
+        return _index;
+    }
+
+    auto is_stopped() const -> bool
+    {
+        return _stopped;
+    }
+
+    auto has_ended() const -> bool
+    {
+        return _ended;
+    }
+
+public: // public types
+    static constexpr uint32_t TAPE_CLOCK  = 3500000; /* T-states of the CDT/TZX timings */
+    static constexpr uint32_t CPU_CLOCK   = 4000000; /* T-states of the CPC */
+    static constexpr uint32_t BUFFER_SIZE = 16384;
+
+private: // private types
+    enum Phase
+    {
+        PHASE_BLOCK = 0,
+        PHASE_PILOT = 1,
+        PHASE_SYNC1 = 2,
+        PHASE_SYNC2 = 3,
+        PHASE_DATA  = 4,
+        PHASE_PAUSE = 5,
+    };
+
+    struct Loop
+    {
+        uint32_t block;
+        uint16_t count;
+    };
+
+    struct Call
+    {
+        uint32_t block;
+        uint32_t data;
+        uint16_t index;
+        uint16_t count;
+    };
+
+private: // private interface
+    void check_header();
+
+    auto fetch_u8(const uint32_t offset) -> uint8_t;
+
+    auto fetch_u16(const uint32_t offset) -> uint16_t;
+
+    auto fetch_u24(const uint32_t offset) -> uint32_t;
+
+    auto fetch_u32(const uint32_t offset) -> uint32_t;
+
+    void parse_block(const uint32_t offset, Block& block);
+
+    void seek_block(const int64_t index);
+
+    auto next_event(Event& event) -> bool;
+
+    auto start_block(Event& event) -> bool;
+
+    auto next_bit() -> int;
+
+    auto next_sample(Event& event) -> bool;
+
+    auto start_pause(Event& event) -> bool;
+
+    void finish_block();
+
+private: // private data
+    const std::string     _filename;
+    int                   _fd;
+    uint32_t              _size;
+    std::vector<uint8_t>  _buffer;
+    uint32_t              _buffer_offset;
+    uint32_t              _buffer_length;
+    std::vector<uint32_t> _blocks;
+    std::vector<Loop>     _loops;
+    std::vector<Call>     _calls;
+    Block                 _block;
+    uint32_t              _index;
+    Phase                 _phase;
+    uint32_t              _counter;
+    uint32_t              _byte;
+    uint8_t               _bit;
+    uint8_t               _half;
+    uint8_t               _level;
+    bool                  _stopped;
+    bool                  _ended;
+    uint64_t              _position;
+    uint64_t              _deadline;
 };
 
 }
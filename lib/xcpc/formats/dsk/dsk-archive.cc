@@ -0,0 +1,654 @@
+/*
+ * dsk-archive.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cstdint>
+#include <climits>
+#include <strings.h>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+#ifdef HAVE_LIBBZ2
+#include <bzlib.h>
+#endif
+#ifdef HAVE_LIBZIP
+#include <zip.h>
+#endif
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include "dsk-archive.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ArchiveTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ArchiveTraits
+{
+    static constexpr size_t CHUNK_SIZE = 65536;
+
+    static auto error(const std::string& filename, const char* message) -> std::runtime_error
+    {
+        return std::runtime_error(std::string() + '<' + filename + '>' + ' ' + message);
+    }
+
+    static auto open(const std::string& filename) -> int
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw error(filename, "could not be opened");
+        }
+        return fd;
+    }
+
+    static auto create(const std::string& filename, const std::string& tempname) -> int
+    {
+        struct stat statbuf;
+        if(::stat(filename.c_str(), &statbuf) != 0) {
+            throw error(filename, "could not be stat'ed");
+        }
+        const int fd = ::open(tempname.c_str(), (O_WRONLY | O_CREAT | O_TRUNC), (statbuf.st_mode & 0777));
+        if(fd < 0) {
+            throw error(tempname, "could not be created");
+        }
+        return fd;
+    }
+
+    static auto close(const int fd) -> void
+    {
+        if(fd >= 0) {
+            static_cast<void>(::close(fd));
+        }
+    }
+
+    static auto fetch(const std::string& filename, const int fd, uint8_t* buffer, const size_t length) -> size_t
+    {
+        ssize_t rc = -1;
+        do {
+            rc = ::read(fd, buffer, length);
+        } while((rc < 0) && (errno == EINTR));
+        if(rc < 0) {
+            throw error(filename, "could not be read");
+        }
+        return static_cast<size_t>(rc);
+    }
+
+    static auto store(const std::string& filename, const int fd, const uint8_t* buffer, size_t length) -> void
+    {
+        while(length != 0) {
+            const ssize_t rc = ::write(fd, buffer, length);
+            if(rc < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw error(filename, "could not be written");
+            }
+            buffer += rc;
+            length -= rc;
+        }
+    }
+
+    static auto commit(const std::string& filename, const std::string& tempname, const int fd) -> void
+    {
+        if(::fsync(fd) != 0) {
+            throw error(tempname, "could not be synced");
+        }
+        if(::rename(tempname.c_str(), filename.c_str()) != 0) {
+            throw error(filename, "could not be replaced");
+        }
+    }
+
+    static auto grow(const std::string& filename, std::vector<uint8_t>& buffer, const size_t used) -> void
+    {
+        const size_t maximum = dsk::Archive::MAXIMUM_SIZE;
+
+        if(used >= maximum) {
+            throw error(filename, "is too large to be a disk image");
+        }
+        if(used == buffer.size()) {
+            size_t size = (buffer.size() != 0 ? buffer.size() * 2 : CHUNK_SIZE * 4);
+            if(size > maximum) {
+                size = maximum;
+            }
+            buffer.resize(size);
+        }
+    }
+
+    static auto has_dsk_suffix(const char* name) -> bool
+    {
+        const size_t length = ::strlen(name);
+
+        if(length < 4) {
+            return false;
+        }
+        return ::strcasecmp(&name[length - 4], ".dsk") == 0;
+    }
+
+#ifdef HAVE_LIBZIP
+    static auto select_dsk(const std::string& filename, zip_t* archive) -> zip_int64_t
+    {
+        zip_int64_t       selected      = -1;
+        const char*       selected_name = nullptr;
+        const zip_int64_t count         = ::zip_get_num_entries(archive, 0);
+
+        for(zip_int64_t index = 0; index < count; ++index) {
+            const char* name = ::zip_get_name(archive, index, 0);
+            if((name == nullptr) || (has_dsk_suffix(name) == false)) {
+                continue;
+            }
+            if((selected_name == nullptr) || (::strcasecmp(name, selected_name) < 0)) {
+                selected      = index;
+                selected_name = name;
+            }
+        }
+        if(selected < 0) {
+            throw error(filename, "does not contain any .dsk file");
+        }
+        return selected;
+    }
+#endif
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::Archive
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+Archive::Archive(const std::string& filename)
+    : _filename(filename)
+{
+}
+
+auto Archive::sniff() const -> ArchiveType
+{
+    uint8_t   magic[4] = { 0, 0, 0, 0 };
+    ssize_t   count    = 0;
+    const int file     = ::open(_filename.c_str(), O_RDONLY);
+
+    if(file != -1) {
+        count = ::read(file, magic, sizeof(magic));
+        static_cast<void>(::close(file));
+    }
+    if((count >= 2) && (magic[0] == 0x1f) && (magic[1] == 0x8b)) {
+        return ARCHIVE_GZIP;
+    }
+    if((count >= 3) && (magic[0] == 0x42) && (magic[1] == 0x5a) && (magic[2] == 0x68)) {
+        return ARCHIVE_BZIP2;
+    }
+    if((count >= 4) && (magic[0] == 0x50) && (magic[1] == 0x4b) && (magic[2] == 0x03) && (magic[3] == 0x04)) {
+        return ARCHIVE_ZIP;
+    }
+    return ARCHIVE_NONE;
+}
+
+auto Archive::is_supported() const -> bool
+{
+    switch(sniff()) {
+        case ARCHIVE_GZIP:
+#ifdef HAVE_LIBZ
+            return true;
+#else
+            return false;
+#endif
+        case ARCHIVE_BZIP2:
+#ifdef HAVE_LIBBZ2
+            return true;
+#else
+            return false;
+#endif
+        case ARCHIVE_ZIP:
+#ifdef HAVE_LIBZIP
+            return true;
+#else
+            return false;
+#endif
+        default:
+            break;
+    }
+    return true;
+}
+
+void Archive::inflate(std::vector<uint8_t>& buffer) const
+{
+    buffer.clear();
+
+    switch(sniff()) {
+        case ARCHIVE_GZIP:
+            inflate_gzip(buffer);
+            break;
+        case ARCHIVE_BZIP2:
+            inflate_bzip2(buffer);
+            break;
+        case ARCHIVE_ZIP:
+            inflate_zip(buffer);
+            break;
+        default:
+            throw ArchiveTraits::error(_filename, "is not a compressed file");
+    }
+    buffer.shrink_to_fit();
+}
+
+void Archive::deflate(const std::vector<uint8_t>& buffer) const
+{
+    switch(sniff()) {
+        case ARCHIVE_GZIP:
+            deflate_gzip(buffer);
+            break;
+        case ARCHIVE_BZIP2:
+            deflate_bzip2(buffer);
+            break;
+        case ARCHIVE_ZIP:
+            deflate_zip(buffer);
+            break;
+        default:
+            throw ArchiveTraits::error(_filename, "is not a compressed file");
+    }
+}
+
+auto Archive::get_name(const ArchiveType type) -> const char*
+{
+    switch(type) {
+        case ARCHIVE_GZIP:
+            return "gzip (.gz)";
+        case ARCHIVE_BZIP2:
+            return "bzip2 (.bz2)";
+        case ARCHIVE_ZIP:
+            return "zip (.zip)";
+        default:
+            break;
+    }
+    return "uncompressed";
+}
+
+void Archive::inflate_gzip(std::vector<uint8_t>& buffer) const
+{
+#ifdef HAVE_LIBZ
+    std::vector<uint8_t> input(ArchiveTraits::CHUNK_SIZE);
+    size_t               used   = 0;
+    int                  status = Z_OK;
+    z_stream             stream;
+    const int            file = ArchiveTraits::open(_filename);
+
+    auto do_inflate = [&]() -> void
+    {
+        stream.next_in  = nullptr;
+        stream.avail_in = 0;
+        /* read the file and inflate each gzip member in turn */ {
+            while(true) {
+                if(stream.avail_in == 0) {
+                    const size_t count = ArchiveTraits::fetch(_filename, file, input.data(), input.size());
+                    if(count == 0) {
+                        break;
+                    }
+                    stream.next_in  = input.data();
+                    stream.avail_in = count;
+                }
+                if(status == Z_STREAM_END) {
+                    if(::inflateReset(&stream) != Z_OK) {
+                        throw ArchiveTraits::error(_filename, "is not a valid gzip file");
+                    }
+                }
+                ArchiveTraits::grow(_filename, buffer, used);
+                stream.next_out  = &buffer[used];
+                stream.avail_out = buffer.size() - used;
+                status = ::inflate(&stream, Z_NO_FLUSH);
+                used   = buffer.size() - stream.avail_out;
+                if((status != Z_OK) && (status != Z_STREAM_END) && (status != Z_BUF_ERROR)) {
+                    throw ArchiveTraits::error(_filename, "is not a valid gzip file");
+                }
+            }
+        }
+        if(status != Z_STREAM_END) {
+            throw ArchiveTraits::error(_filename, "is a truncated gzip file");
+        }
+        buffer.resize(used);
+    };
+
+    ::memset(&stream, 0, sizeof(stream));
+    if(::inflateInit2(&stream, (15 + 16)) != Z_OK) {
+        ArchiveTraits::close(file);
+        throw ArchiveTraits::error(_filename, "could not be inflated");
+    }
+    try {
+        do_inflate();
+    }
+    catch(...) {
+        static_cast<void>(::inflateEnd(&stream));
+        ArchiveTraits::close(file);
+        throw;
+    }
+    static_cast<void>(::inflateEnd(&stream));
+    ArchiveTraits::close(file);
+#else
+    throw ArchiveTraits::error(_filename, "needs gzip (.gz) support");
+#endif
+}
+
+void Archive::inflate_bzip2(std::vector<uint8_t>& buffer) const
+{
+#ifdef HAVE_LIBBZ2
+    std::vector<uint8_t> input(ArchiveTraits::CHUNK_SIZE);
+    size_t               used   = 0;
+    int                  status = BZ_OK;
+    bz_stream            stream;
+    const int            file = ArchiveTraits::open(_filename);
+
+    auto do_inflate = [&]() -> void
+    {
+        stream.next_in  = nullptr;
+        stream.avail_in = 0;
+        /* read the file and decompress each bzip2 stream in turn */ {
+            while(true) {
+                if(stream.avail_in == 0) {
+                    const size_t count = ArchiveTraits::fetch(_filename, file, input.data(), input.size());
+                    if(count == 0) {
+                        break;
+                    }
+                    stream.next_in  = reinterpret_cast<char*>(input.data());
+                    stream.avail_in = count;
+                }
+                if(status == BZ_STREAM_END) {
+                    char*        next_in  = stream.next_in;
+                    unsigned int avail_in = stream.avail_in;
+                    static_cast<void>(::BZ2_bzDecompressEnd(&stream));
+                    ::memset(&stream, 0, sizeof(stream));
+                    if(::BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK) {
+                        throw ArchiveTraits::error(_filename, "is not a valid bzip2 file");
+                    }
+                    stream.next_in  = next_in;
+                    stream.avail_in = avail_in;
+                }
+                ArchiveTraits::grow(_filename, buffer, used);
+                stream.next_out  = reinterpret_cast<char*>(&buffer[used]);
+                stream.avail_out = buffer.size() - used;
+                status = ::BZ2_bzDecompress(&stream);
+                used   = buffer.size() - stream.avail_out;
+                if((status != BZ_OK) && (status != BZ_STREAM_END)) {
+                    throw ArchiveTraits::error(_filename, "is not a valid bzip2 file");
+                }
+            }
+        }
+        if(status != BZ_STREAM_END) {
+            throw ArchiveTraits::error(_filename, "is a truncated bzip2 file");
+        }
+        buffer.resize(used);
+    };
+
+    ::memset(&stream, 0, sizeof(stream));
+    if(::BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK) {
+        ArchiveTraits::close(file);
+        throw ArchiveTraits::error(_filename, "could not be decompressed");
+    }
+    try {
+        do_inflate();
+    }
+    catch(...) {
+        static_cast<void>(::BZ2_bzDecompressEnd(&stream));
+        ArchiveTraits::close(file);
+        throw;
+    }
+    static_cast<void>(::BZ2_bzDecompressEnd(&stream));
+    ArchiveTraits::close(file);
+#else
+    throw ArchiveTraits::error(_filename, "needs bzip2 (.bz2) support");
+#endif
+}
+
+void Archive::inflate_zip(std::vector<uint8_t>& buffer) const
+{
+#ifdef HAVE_LIBZIP
+    zip_t*      archive  = nullptr;
+    zip_file_t* entry    = nullptr;
+    zip_int64_t selected = -1;
+
+    auto do_select = [&]() -> void
+    {
+        selected = ArchiveTraits::select_dsk(_filename, archive);
+    };
+
+    auto do_inflate = [&]() -> void
+    {
+        size_t used = 0;
+        entry = ::zip_fopen_index(archive, selected, 0);
+        if(entry == nullptr) {
+            throw ArchiveTraits::error(_filename, "could not be decompressed");
+        }
+        while(true) {
+            ArchiveTraits::grow(_filename, buffer, used);
+            const zip_int64_t count = ::zip_fread(entry, &buffer[used], buffer.size() - used);
+            if(count < 0) {
+                throw ArchiveTraits::error(_filename, "is not a valid zip file");
+            }
+            if(count == 0) {
+                break;
+            }
+            used += count;
+        }
+        buffer.resize(used);
+    };
+
+    auto do_close = [&]() -> void
+    {
+        if(entry != nullptr) {
+            entry = (static_cast<void>(::zip_fclose(entry)), nullptr);
+        }
+        if(archive != nullptr) {
+            archive = (::zip_discard(archive), nullptr);
+        }
+    };
+
+    archive = ::zip_open(_filename.c_str(), ZIP_RDONLY, nullptr);
+    if(archive == nullptr) {
+        throw ArchiveTraits::error(_filename, "is not a valid zip file");
+    }
+    try {
+        do_select();
+        do_inflate();
+    }
+    catch(...) {
+        do_close();
+        throw;
+    }
+    do_close();
+#else
+    throw ArchiveTraits::error(_filename, "needs zip (.zip) support");
+#endif
+}
+
+
+void Archive::deflate_gzip(const std::vector<uint8_t>& buffer) const
+{
+#ifdef HAVE_LIBZ
+    std::vector<uint8_t> output(ArchiveTraits::CHUNK_SIZE);
+    const std::string    tempname(_filename + ".tmp");
+    int                  status = Z_OK;
+    z_stream             stream;
+    int                  file = -1;
+
+    auto do_deflate = [&]() -> void
+    {
+        stream.next_in  = const_cast<uint8_t*>(buffer.data());
+        stream.avail_in = buffer.size();
+        /* compress the whole buffer as a single gzip member */ {
+            while(status != Z_STREAM_END) {
+                stream.next_out  = output.data();
+                stream.avail_out = output.size();
+                status = ::deflate(&stream, Z_FINISH);
+                if((status != Z_OK) && (status != Z_STREAM_END)) {
+                    throw ArchiveTraits::error(_filename, "could not be deflated");
+                }
+                ArchiveTraits::store(tempname, file, output.data(), (output.size() - stream.avail_out));
+            }
+        }
+        ArchiveTraits::commit(_filename, tempname, file);
+    };
+
+    ::memset(&stream, 0, sizeof(stream));
+    if(::deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, (15 + 16), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw ArchiveTraits::error(_filename, "could not be deflated");
+    }
+    try {
+        file = ArchiveTraits::create(_filename, tempname);
+        do_deflate();
+    }
+    catch(...) {
+        static_cast<void>(::deflateEnd(&stream));
+        ArchiveTraits::close(file);
+        static_cast<void>(::unlink(tempname.c_str()));
+        throw;
+    }
+    static_cast<void>(::deflateEnd(&stream));
+    ArchiveTraits::close(file);
+#else
+    throw ArchiveTraits::error(_filename, "needs gzip (.gz) support");
+#endif
+}
+
+void Archive::deflate_bzip2(const std::vector<uint8_t>& buffer) const
+{
+#ifdef HAVE_LIBBZ2
+    std::vector<uint8_t> output(ArchiveTraits::CHUNK_SIZE);
+    const std::string    tempname(_filename + ".tmp");
+    int                  status = BZ_OK;
+    bz_stream            stream;
+    int                  file = -1;
+
+    auto do_deflate = [&]() -> void
+    {
+        stream.next_in  = reinterpret_cast<char*>(const_cast<uint8_t*>(buffer.data()));
+        stream.avail_in = buffer.size();
+        /* compress the whole buffer as a single bzip2 stream */ {
+            while(status != BZ_STREAM_END) {
+                stream.next_out  = reinterpret_cast<char*>(output.data());
+                stream.avail_out = output.size();
+                status = ::BZ2_bzCompress(&stream, BZ_FINISH);
+                if((status != BZ_FINISH_OK) && (status != BZ_STREAM_END)) {
+                    throw ArchiveTraits::error(_filename, "could not be compressed");
+                }
+                ArchiveTraits::store(tempname, file, output.data(), (output.size() - stream.avail_out));
+            }
+        }
+        ArchiveTraits::commit(_filename, tempname, file);
+    };
+
+    ::memset(&stream, 0, sizeof(stream));
+    if(::BZ2_bzCompressInit(&stream, 9, 0, 0) != BZ_OK) {
+        throw ArchiveTraits::error(_filename, "could not be compressed");
+    }
+    try {
+        file = ArchiveTraits::create(_filename, tempname);
+        do_deflate();
+    }
+    catch(...) {
+        static_cast<void>(::BZ2_bzCompressEnd(&stream));
+        ArchiveTraits::close(file);
+        static_cast<void>(::unlink(tempname.c_str()));
+        throw;
+    }
+    static_cast<void>(::BZ2_bzCompressEnd(&stream));
+    ArchiveTraits::close(file);
+#else
+    throw ArchiveTraits::error(_filename, "needs bzip2 (.bz2) support");
+#endif
+}
+
+void Archive::deflate_zip(const std::vector<uint8_t>& buffer) const
+{
+#ifdef HAVE_LIBZIP
+    zip_t*        archive  = nullptr;
+    zip_source_t* source   = nullptr;
+    zip_int64_t   selected = -1;
+
+    auto do_replace = [&]() -> void
+    {
+        selected = ArchiveTraits::select_dsk(_filename, archive);
+        source   = ::zip_source_buffer(archive, buffer.data(), buffer.size(), 0);
+        if(source == nullptr) {
+            throw ArchiveTraits::error(_filename, "could not be compressed");
+        }
+        if(::zip_file_replace(archive, selected, source, 0) != 0) {
+            throw ArchiveTraits::error(_filename, "could not be compressed");
+        }
+        source = nullptr;
+    };
+
+    auto do_commit = [&]() -> void
+    {
+        if(::zip_close(archive) != 0) {
+            throw ArchiveTraits::error(_filename, "could not be written");
+        }
+        archive = nullptr;
+    };
+
+    auto do_close = [&]() -> void
+    {
+        if(source != nullptr) {
+            source = (::zip_source_free(source), nullptr);
+        }
+        if(archive != nullptr) {
+            archive = (::zip_discard(archive), nullptr);
+        }
+    };
+
+    archive = ::zip_open(_filename.c_str(), 0, nullptr);
+    if(archive == nullptr) {
+        throw ArchiveTraits::error(_filename, "is not a valid zip file");
+    }
+    try {
+        do_replace();
+        do_commit();
+    }
+    catch(...) {
+        do_close();
+        throw;
+    }
+    do_close();
+#else
+    throw ArchiveTraits::error(_filename, "needs zip (.zip) support");
+#endif
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
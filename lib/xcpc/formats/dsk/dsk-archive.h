@@ -0,0 +1,93 @@
+/*
+ * dsk-archive.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_DSK_ARCHIVE_H__
+#define __XCPC_DSK_ARCHIVE_H__
+
+// ---------------------------------------------------------------------------
+// dsk::ArchiveType
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+enum ArchiveType
+{
+    ARCHIVE_NONE  = 0,
+    ARCHIVE_GZIP  = 1,
+    ARCHIVE_BZIP2 = 2,
+    ARCHIVE_ZIP   = 3,
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::Archive
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+class Archive
+{
+public: // public interface
+    Archive(const std::string& filename);
+
+    Archive(Archive&&) = delete;
+
+    Archive(const Archive&) = delete;
+
+    Archive& operator=(Archive&&) = delete;
+
+    Archive& operator=(const Archive&) = delete;
+
+    virtual ~Archive() = default;
+
+    auto sniff() const -> ArchiveType;
+
+    auto is_supported() const -> bool;
+
+    void inflate(std::vector<uint8_t>& buffer) const;
+
+    void deflate(const std::vector<uint8_t>& buffer) const;
+
+    static auto get_name(const ArchiveType type) -> const char*;
+
+public: // public types
+    static constexpr size_t MAXIMUM_SIZE = (64UL * 1024UL * 1024UL);
+
+private: // private interface
+    void inflate_gzip(std::vector<uint8_t>& buffer) const;
+
+    void inflate_bzip2(std::vector<uint8_t>& buffer) const;
+
+    void inflate_zip(std::vector<uint8_t>& buffer) const;
+
+    void deflate_gzip(const std::vector<uint8_t>& buffer) const;
+
+    void deflate_bzip2(const std::vector<uint8_t>& buffer) const;
+
+    void deflate_zip(const std::vector<uint8_t>& buffer) const;
+
+private: // private data
+    const std::string _filename;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_DSK_ARCHIVE_H__ */
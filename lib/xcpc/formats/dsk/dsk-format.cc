@@ -30,6 +30,9 @@
 #ifdef HAVE_SYS_STAT_H
 #include <sys/stat.h>
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
@@ -39,9 +42,11 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include "dsk-format.h"
+#include "dsk-archive.h"
 
 // ---------------------------------------------------------------------------
 // some useful macros
@@ -136,6 +141,14 @@ struct utils
         }
     }
 
+    static void seek(int fd, const off_t offset)
+    {
+        const off_t rc = ::lseek(fd, offset, SEEK_SET);
+        if(rc != offset) {
+            throw std::runtime_error("lseek() has failed");
+        }
+    }
+
     static void unlink(const std::string& filename)
     {
         const int rc = ::unlink(filename.c_str());
@@ -144,6 +157,45 @@ struct utils
         }
     }
 
+    static auto escape(const uint8_t* bytes, const size_t count, char* buffer) -> const char*
+    {
+        char* string = buffer;
+
+        for(size_t index = 0; index < count; ++index) {
+            const uint8_t character = bytes[index];
+            if(character >= ' ') {
+                *string++ = character;
+            }
+            else if(character == '\0') {
+                *string++ = '\\';
+                *string++ = '0';
+            }
+            else if(character == '\r') {
+                *string++ = '\\';
+                *string++ = 'r';
+            }
+            else if(character == '\n') {
+                *string++ = '\\';
+                *string++ = 'n';
+            }
+            else {
+                *string++ = '?';
+            }
+        }
+        *string = '\0';
+        return buffer;
+    }
+
+    static auto prefix(const uint8_t* bytes, const char* expected, const size_t count) -> size_t
+    {
+        size_t index = 0;
+
+        while((index < count) && (bytes[index] == static_cast<uint8_t>(expected[index]))) {
+            ++index;
+        }
+        return index;
+    }
+
     template <typename T>
     static void clear_data(T& data, const uint8_t byte)
     {
@@ -1336,8 +1388,35 @@ Disk::~Disk()
 
 void Disk::dump()
 {
-    constexpr int flags = (O_RDONLY);
-    constexpr int mode  = 0;
+    auto do_dump = [&]() -> void
+    {
+        const DiskFile file(_filename);
+        file.print();
+        file.check();
+        const int count = file.get_number_of_blocks();
+        for(int index = 0; index < count; ++index) {
+            const TrackView track(file.get_track(index));
+            if(track.is_formatted() == false) {
+                continue;
+            }
+            track.print();
+            track.check();
+            const int number_of_sectors = track.get_number_of_sectors();
+            for(int slot = 0; slot < number_of_sectors; ++slot) {
+                const SectorView sector(track.get_sector(slot));
+                sector.print();
+                sector.check();
+            }
+        }
+    };
+
+    return do_dump();
+}
+
+void Disk::create()
+{
+    constexpr int flags = (O_CREAT | O_TRUNC | O_RDWR);
+    constexpr int mode  = 0644;
 
     auto do_open = [&]() -> void
     {
@@ -1359,75 +1438,1020 @@ void Disk::dump()
         }
     };
 
-    auto do_fetch = [&]() -> void
+    auto do_store = [&]() -> void
     {
         ImageAdapter image(_image, _file);
 
         image.clear();
-        image.fetch();
+        image.store();
     };
 
-    auto do_dump = [&]() -> void
+    auto do_create = [&]() -> void
     {
         do_open();
-        do_fetch();
+        do_store();
         do_close();
     };
 
-    return do_dump();
+    return do_create();
 }
 
-void Disk::create()
+void Disk::remove()
 {
-    constexpr int flags = (O_CREAT | O_TRUNC | O_RDWR);
-    constexpr int mode  = 0644;
+    auto do_remove = [&]() -> void
+    {
+        utils::unlink(_filename);
+    };
+
+    return do_remove();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::Image
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+Image::Image(const std::string& filename)
+    : _filename(filename)
+    , _arena()
+    , _tracks()
+    , _dirty()
+    , _header_dirty(false)
+    , _extended(false)
+    , _readonly(false)
+    , _compressed(false)
+{
+}
+
+auto Image::probe(const std::string& filename) -> bool
+{
+    char    magic[8];
+    ssize_t count = 0;
+    const int file = ::open(filename.c_str(), O_RDONLY);
+
+    if(file != -1) {
+        count = ::read(file, magic, sizeof(magic));
+        static_cast<void>(::close(file));
+    }
+    if(count == sizeof(magic)) {
+        if(::memcmp(magic, "MV - CPC", 8) == 0) {
+            return true;
+        }
+        if(::memcmp(magic, "EXTENDED", 8) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Image::load()
+{
+    int file = -1;
 
     auto do_open = [&]() -> void
     {
-        if(_file == -1) {
-            _file = utils::open(_filename, flags, mode);
+        file = utils::open(_filename, O_RDONLY);
+    };
+
+    auto do_close = [&]() -> void
+    {
+        file = (utils::close(file), -1);
+    };
+
+    auto do_fetch = [&]() -> void
+    {
+        struct stat statbuf;
+        if(::fstat(file, &statbuf) != 0) {
+            throw std::runtime_error("fstat() has failed");
         }
-        else {
-            throw std::runtime_error(std::string() + '<' + _filename + '>' + ' ' + "is already opened");
+        _arena.resize(statbuf.st_size);
+        const ssize_t rc = utils::fetch(file, _arena.data(), _arena.size());
+        if(rc != static_cast<ssize_t>(_arena.size())) {
+            throw std::runtime_error("fetch() has failed");
         }
     };
 
+    auto do_load = [&]() -> void
+    {
+        do_open();
+        try {
+            do_fetch();
+        }
+        catch(...) {
+            do_close();
+            throw;
+        }
+        do_close();
+        check_header();
+        _readonly = (::access(_filename.c_str(), W_OK) != 0);
+        build_index();
+    };
+
+    return do_load();
+}
+
+void Image::load(std::vector<uint8_t>& buffer)
+{
+    auto do_load = [&]() -> void
+    {
+        _arena.swap(buffer);
+        buffer.clear();
+        check_header();
+        _readonly = true;
+        build_index();
+    };
+
+    return do_load();
+}
+
+void Image::inflate()
+{
+    std::vector<uint8_t> buffer;
+
+    auto do_inflate = [&]() -> void
+    {
+        const Archive archive(_filename);
+        archive.inflate(buffer);
+    };
+
+    auto do_load = [&]() -> void
+    {
+        do_inflate();
+        load(buffer);
+        _readonly   = (::access(_filename.c_str(), W_OK) != 0);
+        _compressed = true;
+    };
+
+    return do_load();
+}
+
+void Image::flush()
+{
+    int file = -1;
+
+    auto do_open = [&]() -> void
+    {
+        file = utils::open(_filename, O_WRONLY);
+    };
+
     auto do_close = [&]() -> void
     {
-        if(_file != -1) {
-            _file = (utils::close(_file), -1);
+        file = (utils::close(file), -1);
+    };
+
+    auto do_store = [&](const uint32_t offset, const uint32_t length) -> void
+    {
+        utils::seek(file, offset);
+        const ssize_t rc = utils::store(file, &_arena[offset], length);
+        if(rc != static_cast<ssize_t>(length)) {
+            throw std::runtime_error("store() has failed");
         }
-        else {
-            throw std::runtime_error(std::string() + '<' + _filename + '>' + ' ' + "is already closed");
+    };
+
+    auto do_store_tracks = [&]() -> void
+    {
+        for(const int index : _dirty) {
+            Track& track(_tracks[index]);
+            do_store(track.offset, track.length);
+            track.dirty = false;
         }
+        _dirty.clear();
     };
 
-    auto do_store = [&]() -> void
+    auto do_store_header = [&]() -> void
     {
-        ImageAdapter image(_image, _file);
+        if(_header_dirty != false) {
+            do_store(0, 256);
+            _header_dirty = false;
+        }
+    };
 
-        image.clear();
-        image.store();
+    auto do_deflate = [&]() -> void
+    {
+        const Archive archive(_filename);
+        archive.deflate(_arena);
+        for(const int index : _dirty) {
+            _tracks[index].dirty = false;
+        }
+        _dirty.clear();
+        _header_dirty = false;
     };
 
-    auto do_create = [&]() -> void
+    auto do_flush = [&]() -> void
     {
+        if(is_dirty() == false) {
+            return;
+        }
+        if(_compressed != false) {
+            return do_deflate();
+        }
         do_open();
-        do_store();
+        try {
+            do_store_tracks();
+            do_store_header();
+        }
+        catch(...) {
+            do_close();
+            throw;
+        }
         do_close();
     };
 
-    return do_create();
+    return do_flush();
 }
 
-void Disk::remove()
+void Image::mark_dirty(Track& track)
 {
-    auto do_remove = [&]() -> void
+    if(track.dirty == false) {
+        track.dirty = true;
+        _dirty.push_back(&track - _tracks.data());
+    }
+}
+
+auto Image::format(int cylinder, int head, const uint8_t* ids, int count, uint8_t filler) -> bool
+{
+    const int sides  = (_arena[0x31] > 1 ? 2 : 1);
+    uint32_t  needed = 256;
+
+    auto do_check = [&]() -> bool
     {
-        utils::unlink(_filename);
+        if((_readonly != false) || (count < 0) || (count > 29)) {
+            return false;
+        }
+        if((cylinder < 0) || (head < 0) || (head >= sides)) {
+            return false;
+        }
+        for(int slot = 0; slot < count; ++slot) {
+            needed += (0x80 << (ids[(slot * 4) + 3] & 7));
+        }
+        return true;
     };
 
-    return do_remove();
+    auto do_grow = [&]() -> bool
+    {
+        const int tracks = _arena[0x30];
+        if(cylinder < tracks) {
+            return true;
+        }
+        if((cylinder != tracks) || (cylinder >= 0xff)) {
+            return false;
+        }
+        if((_extended != false) && ((0x34 + ((cylinder + 1) * sides)) > 256)) {
+            return false;
+        }
+        _arena[0x30] = (cylinder + 1);
+        _header_dirty = true;
+        build_index();
+        if(_extended == false) {
+            for(int side = 0; side < sides; ++side) {
+                mark_dirty(_tracks[(cylinder * sides) + side]);
+            }
+        }
+        return true;
+    };
+
+    auto do_allocate = [&](const int index) -> bool
+    {
+        Track& track(_tracks[index]);
+        if((_extended == false) || (track.length != 0)) {
+            return true;
+        }
+        for(size_t other = (index + 1); other < _tracks.size(); ++other) {
+            if(_tracks[other].length != 0) {
+                return false;
+            }
+        }
+        const uint32_t length = ((needed + 255) & ~255);
+        if(length > 0xff00) {
+            return false;
+        }
+        _arena[0x34 + index] = (length >> 8);
+        _header_dirty = true;
+        if(_arena.size() < (track.offset + length)) {
+            _arena.resize(track.offset + length, 0);
+        }
+        track.length = length;
+        return true;
+    };
+
+    auto do_store = [&](const int index) -> bool
+    {
+        Track&   track(_tracks[index]);
+        uint8_t* block  = &_arena[track.offset];
+        uint32_t offset = 256;
+        if(needed > track.length) {
+            return false;
+        }
+        static_cast<void>(::memset(block, 0, track.length));
+        static_cast<void>(::memcpy(block, "Track-Info\r\n", 12));
+        block[0x10] = cylinder;
+        block[0x11] = head;
+        block[0x14] = (count != 0 ? ids[3] : 2);
+        block[0x15] = count;
+        block[0x16] = 0x4e;
+        block[0x17] = filler;
+        for(int slot = 0; slot < count; ++slot) {
+            uint8_t*       record = &block[0x18 + (slot * 8)];
+            const uint8_t* id     = &ids[slot * 4];
+            const uint32_t size   = (0x80 << (id[3] & 7));
+            record[0] = id[0];
+            record[1] = id[1];
+            record[2] = id[2];
+            record[3] = id[3];
+            if(_extended != false) {
+                record[6] = ((size >> 0) & 0xff);
+                record[7] = ((size >> 8) & 0xff);
+            }
+            static_cast<void>(::memset(&block[offset], filler, size));
+            offset += size;
+        }
+        build_track(track, track.offset, track.length);
+        mark_dirty(track);
+        return true;
+    };
+
+    auto do_format = [&]() -> bool
+    {
+        if(do_check() == false) {
+            return false;
+        }
+        if(do_grow() == false) {
+            return false;
+        }
+        const int index = ((cylinder * sides) + head);
+        if(do_allocate(index) == false) {
+            return false;
+        }
+        return do_store(index);
+    };
+
+    return do_format();
+}
+
+auto Image::find_track(int cylinder, int head) -> Track*
+{
+    const int sides = (_arena[0x31] > 1 ? 2 : 1);
+
+    if((cylinder < 0) || (cylinder >= _arena[0x30])) {
+        return nullptr;
+    }
+    if((head < 0) || (head >= sides)) {
+        return nullptr;
+    }
+    Track& track(_tracks[(cylinder * sides) + head]);
+    if(track.valid == false) {
+        return nullptr;
+    }
+    return &track;
+}
+
+void Image::check_header()
+{
+    if(_arena.size() < 256) {
+        throw std::runtime_error(std::string() + '<' + _filename + '>' + ' ' + "is not a disk image");
+    }
+    if(::memcmp(&_arena[0], "MV - CPC", 8) == 0) {
+        _extended = false;
+    }
+    else if(::memcmp(&_arena[0], "EXTENDED", 8) == 0) {
+        _extended = true;
+    }
+    else {
+        throw std::runtime_error(std::string() + '<' + _filename + '>' + ' ' + "is not a disk image");
+    }
+}
+
+void Image::build_index()
+{
+    const int sides  = (_arena[0x31] > 1 ? 2 : 1);
+    const int count  = (_arena[0x30] * sides);
+    uint32_t  offset = 256;
+
+    _tracks.clear();
+    _tracks.resize(count);
+    for(int index = 0; index < count; ++index) {
+        offset += get_track_length(index);
+    }
+    if(_arena.size() < offset) {
+        _arena.resize(offset, 0);
+    }
+    offset = 256;
+    for(int index = 0; index < count; ++index) {
+        const uint32_t length = get_track_length(index);
+        build_track(_tracks[index], offset, length);
+        offset += length;
+    }
+    for(const int index : _dirty) {
+        _tracks[index].dirty = true;
+    }
+}
+
+void Image::build_track(Track& track, uint32_t offset, uint32_t length)
+{
+    track.offset = offset;
+    track.length = length;
+    track.count  = 0;
+    track.valid  = false;
+    track.unique = true;
+    static_cast<void>(::memset(track.index, NO_SECTOR, sizeof(track.index)));
+
+    if(length < 256) {
+        return;
+    }
+    const uint8_t* info = &_arena[offset];
+    if(::memcmp(info, "Track-Info", 10) != 0) {
+        return;
+    }
+    track.valid = true;
+    track.count = (info[0x15] < 29 ? info[0x15] : 29);
+
+    uint32_t data = (offset + 256);
+    for(int slot = 0; slot < track.count; ++slot) {
+        const uint8_t* record = &info[0x18 + (slot * 8)];
+        Sector&        sector(track.sector[slot]);
+        sector.info = (offset + 0x18 + (slot * 8));
+        sector.data = data;
+        if(_extended != false) {
+            sector.size = (record[6] | (record[7] << 8));
+        }
+        else {
+            sector.size = (0x80 << (info[0x14] & 7));
+        }
+        if(track.index[record[2]] == NO_SECTOR) {
+            track.index[record[2]] = slot;
+        }
+        else {
+            track.unique = false;
+        }
+        data += sector.size;
+    }
+}
+
+auto Image::get_track_length(int track) const -> uint32_t
+{
+    if(_extended != false) {
+        const int entry = (0x34 + track);
+        if(entry < 256) {
+            return (_arena[entry] * 256);
+        }
+        return 0;
+    }
+    return (_arena[0x32] | (_arena[0x33] << 8));
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::SectorView
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+void SectorView::check() const
+{
+    if(get_fdc_c() >= internal::traits::MAX_NUMBER_OF_TRACKS) {
+        throw std::runtime_error("sector has a bad track number");
+    }
+    if(get_fdc_h() >= internal::traits::MAX_NUMBER_OF_SIDES) {
+        throw std::runtime_error("sector has a bad side number");
+    }
+    if(get_fdc_n() >= internal::traits::MAX_SECTOR_SIZE) {
+        throw std::runtime_error("sector has a bad sector size");
+    }
+}
+
+void SectorView::print() const
+{
+    utils::println("[sector#%02x]", get_fdc_r());
+    utils::println("sector.info.fdc_c .............. 0x%02x", get_fdc_c());
+    utils::println("sector.info.fdc_h .............. 0x%02x", get_fdc_h());
+    utils::println("sector.info.fdc_r .............. 0x%02x", get_fdc_r());
+    utils::println("sector.info.fdc_n .............. 0x%02x", get_fdc_n());
+    utils::println("sector.info.fdc_st1 ............ 0x%02x", get_fdc_st1());
+    utils::println("sector.info.fdc_st2 ............ 0x%02x", get_fdc_st2());
+    utils::println("sector.info.size ............... %d"    , get_size());
+    utils::println("");
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::TrackView
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+void TrackView::check() const
+{
+    const TrackRecord& track(get_record());
+
+    if(utils::prefix(track.info.s.signature, internal::trk_info, countof(internal::trk_info)) < 10) {
+        throw std::runtime_error("track has a bad signature");
+    }
+    if(get_track_number() >= internal::traits::MAX_NUMBER_OF_TRACKS) {
+        throw std::runtime_error("track has a bad track number");
+    }
+    if(get_side_number() >= internal::traits::MAX_NUMBER_OF_SIDES) {
+        throw std::runtime_error("track has a bad side number");
+    }
+    if(get_sector_size() >= internal::traits::MAX_SECTOR_SIZE) {
+        throw std::runtime_error("track has a bad sector size");
+    }
+    if(get_number_of_sectors() >= internal::traits::MAX_NUMBER_OF_SECTORS) {
+        throw std::runtime_error("track has a bad number of sectors");
+    }
+}
+
+void TrackView::print() const
+{
+    const TrackRecord& track(get_record());
+    char               signature[(sizeof(track.info.s.signature) * 2) + 1];
+
+    utils::println("[track#%02x]", get_track_number());
+    utils::println("track.info.signature ........... %s"    , utils::escape(track.info.s.signature, sizeof(track.info.s.signature), signature));
+    utils::println("track.info.reserved1 ........... 0x%02x", track.info.s.reserved1);
+    utils::println("track.info.reserved2 ........... 0x%02x", track.info.s.reserved2);
+    utils::println("track.info.reserved3 ........... 0x%02x", track.info.s.reserved3);
+    utils::println("track.info.reserved4 ........... 0x%02x", track.info.s.reserved4);
+    utils::println("track.info.track_number ........ 0x%02x", get_track_number());
+    utils::println("track.info.side_number ......... 0x%02x", get_side_number());
+    utils::println("track.info.reserved5 ........... 0x%02x", track.info.s.reserved5);
+    utils::println("track.info.reserved6 ........... 0x%02x", track.info.s.reserved6);
+    utils::println("track.info.sector_size ......... 0x%02x", get_sector_size());
+    utils::println("track.info.number_of_sectors ... 0x%02x", get_number_of_sectors());
+    utils::println("track.info.gap3_length ......... 0x%02x", get_gap3_length());
+    utils::println("track.info.filler_byte ......... 0x%02x", get_filler_byte());
+    utils::println("");
+}
+
+auto TrackView::get_sector(const int index) const -> SectorView
+{
+    size_t offset = 256;
+
+    for(int slot = 0; slot < index; ++slot) {
+        offset += get_sector_length(slot);
+    }
+    const uint8_t* info = &_block[0x18 + (index * 8)];
+    if(offset >= _length) {
+        return SectorView(info, _block + _length, 0);
+    }
+    const size_t length = get_sector_length(index);
+    return SectorView(info, &_block[offset], std::min(length, (_length - offset)));
+}
+
+auto TrackView::get_sector_length(const int index) const -> size_t
+{
+    if(_extended != false) {
+        const uint8_t* record = &_block[0x18 + (index * 8)];
+        return (record[6] | (record[7] << 8));
+    }
+    return (0x80 << (_block[0x14] & 7));
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::DiskFile
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+DiskFile::DiskFile(const std::string& filename)
+    : _data(nullptr)
+    , _size(0)
+    , _mapped(0)
+    , _disk(nullptr)
+    , _extended(false)
+    , _compressed(false)
+    , _buffer()
+{
+    int fd = -1;
+
+    auto file_inflate = [&]() -> bool
+    {
+        const Archive archive(filename);
+        if(archive.sniff() == ARCHIVE_NONE) {
+            return false;
+        }
+        archive.inflate(_buffer);
+        _data       = _buffer.data();
+        _size       = _buffer.size();
+        _compressed = true;
+        return true;
+    };
+
+    auto file_open = [&]() -> void
+    {
+        fd = utils::open(filename, O_RDONLY);
+    };
+
+    auto file_stat = [&]() -> void
+    {
+        struct stat statbuf;
+        if(::fstat(fd, &statbuf) != 0) {
+            throw std::runtime_error("fstat() has failed");
+        }
+        _size = static_cast<size_t>(statbuf.st_size);
+    };
+
+    auto file_map = [&]() -> bool
+    {
+#ifdef HAVE_SYS_MMAN_H
+        if(_size == 0) {
+            return false;
+        }
+        void* addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(addr != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            static_cast<void>(::madvise(addr, _size, MADV_SEQUENTIAL));
+#endif
+            _data   = static_cast<const uint8_t*>(addr);
+            _mapped = _size;
+            return true;
+        }
+#endif
+        return false;
+    };
+
+    auto file_read = [&]() -> void
+    {
+        _buffer.resize(_size);
+        const ssize_t rc = utils::fetch(fd, _buffer.data(), _buffer.size());
+        if(rc != static_cast<ssize_t>(_buffer.size())) {
+            throw std::runtime_error("fetch() has failed");
+        }
+        _data = _buffer.data();
+    };
+
+    auto file_close = [&]() -> void
+    {
+        if(fd >= 0) {
+            fd = (static_cast<void>(::close(fd)), -1);
+        }
+    };
+
+    auto check_header = [&]() -> void
+    {
+        if(_size < sizeof(DiskRecord)) {
+            throw std::runtime_error(std::string() + '<' + filename + '>' + ' ' + "is not a disk image");
+        }
+        if(::memcmp(_data, "MV - CPC", 8) == 0) {
+            _extended = false;
+        }
+        else if(::memcmp(_data, "EXTENDED", 8) == 0) {
+            _extended = true;
+        }
+        else {
+            throw std::runtime_error(std::string() + '<' + filename + '>' + ' ' + "is not a disk image");
+        }
+        _disk = reinterpret_cast<const DiskRecord*>(_data);
+    };
+
+    try {
+        if(file_inflate() == false) {
+            file_open();
+            file_stat();
+            if(file_map() == false) {
+                file_read();
+            }
+            file_close();
+        }
+        check_header();
+    }
+    catch(...) {
+        file_close();
+#ifdef HAVE_SYS_MMAN_H
+        if(_mapped != 0) {
+            static_cast<void>(::munmap(const_cast<uint8_t*>(_data), _mapped));
+        }
+#endif
+        throw;
+    }
+}
+
+DiskFile::~DiskFile()
+{
+#ifdef HAVE_SYS_MMAN_H
+    if(_mapped != 0) {
+        static_cast<void>(::munmap(const_cast<uint8_t*>(_data), _mapped));
+    }
+#endif
+    _data = nullptr;
+    _disk = nullptr;
+}
+
+void DiskFile::check() const
+{
+    const DiskRecord& disk(get_disk_info());
+    const size_t      std_prefix = utils::prefix(disk.info.s.magic, internal::std_magic, countof(internal::std_magic));
+    const size_t      ext_prefix = utils::prefix(disk.info.s.magic, internal::ext_magic, countof(internal::ext_magic));
+    const size_t      sig_prefix = utils::prefix(disk.info.s.signature, internal::dsk_info, countof(internal::dsk_info));
+    bool              relaxed    = false;
+
+    if(std_prefix >= 8) {
+        relaxed = (std_prefix < countof(internal::std_magic));
+    }
+    else if(ext_prefix >= 8) {
+        relaxed = (ext_prefix < countof(internal::ext_magic));
+    }
+    else {
+        throw std::runtime_error("disk has a bad magic");
+    }
+    if((relaxed == false) && (sig_prefix < 9)) {
+        throw std::runtime_error("disk has a bad signature");
+    }
+    if((get_number_of_tracks() < internal::traits::MIN_NUMBER_OF_TRACKS)
+    || (get_number_of_tracks() > internal::traits::MAX_NUMBER_OF_TRACKS)) {
+        throw std::runtime_error("disk has a bad number of tracks");
+    }
+    if((get_number_of_sides() < internal::traits::MIN_NUMBER_OF_SIDES)
+    || (get_number_of_sides() > internal::traits::MAX_NUMBER_OF_SIDES)) {
+        throw std::runtime_error("disk has a bad number of sides");
+    }
+}
+
+void DiskFile::print() const
+{
+    const DiskRecord& disk(get_disk_info());
+    const uint32_t    track_size = ((disk.info.s.track_size_msb << 8) | (disk.info.s.track_size_lsb << 0));
+    char              magic[(sizeof(disk.info.s.magic) * 2) + 1];
+    char              signature[(sizeof(disk.info.s.signature) * 2) + 1];
+    char              creator[(sizeof(disk.info.s.tool) * 2) + 1];
+
+    utils::println("[disk]");
+    utils::println("disk.info.magic ................ %s", utils::escape(disk.info.s.magic, sizeof(disk.info.s.magic), magic));
+    utils::println("disk.info.signature ............ %s", utils::escape(disk.info.s.signature, sizeof(disk.info.s.signature), signature));
+    utils::println("disk.info.tool ................. %s", utils::escape(disk.info.s.tool, sizeof(disk.info.s.tool), creator));
+    utils::println("disk.info.number_of_tracks ..... %d", get_number_of_tracks());
+    utils::println("disk.info.number_of_sides ...... %d", get_number_of_sides());
+    utils::println("disk.info.track_size ........... %d", track_size);
+    utils::println("disk.info.side_size ............ %d", (get_number_of_sides() * (get_number_of_tracks() * track_size)));
+    utils::println("");
+}
+
+auto DiskFile::inspect() const -> Summary
+{
+    Summary   summary;
+    const int sides  = (get_number_of_sides() > 1 ? 2 : 1);
+    const int count  = (get_number_of_tracks() * sides);
+    size_t    offset = sizeof(DiskRecord);
+
+    auto report = [&](std::vector<std::string>& list, const int index, const std::string& message) -> void
+    {
+        list.push_back("track " + std::to_string(index / sides) + " side " + std::to_string(index % sides) + ": " + message);
+    };
+
+    auto inspect_track = [&](const int index, const uint8_t* info, const size_t length) -> void
+    {
+        if((length < 256) || (::memcmp(info, "Track-Info", 10) != 0)) {
+            return report(summary.errors, index, "bad track-info signature");
+        }
+        if((info[0x10] != (index / sides)) || (info[0x11] != (index % sides))) {
+            report(summary.warnings, index, "track-info refers to track " + std::to_string(info[0x10]) + " side " + std::to_string(info[0x11]));
+        }
+        int number_of_sectors = info[0x15];
+        if(number_of_sectors > 29) {
+            report(summary.errors, index, "too many sectors (" + std::to_string(number_of_sectors) + ")");
+            number_of_sectors = 29;
+        }
+        const TrackView track(info, length, _extended);
+        size_t          used = 256;
+        for(int sector = 0; sector < number_of_sectors; ++sector) {
+            const size_t sector_length = track.get_sector_length(sector);
+            used            += sector_length;
+            summary.data    += sector_length;
+            summary.sectors += 1;
+        }
+        if(used > length) {
+            report(summary.errors, index, "sector data overflows the track block by " + std::to_string(used - length) + " bytes");
+        }
+        summary.tracks += 1;
+    };
+
+    auto inspect_tracks = [&]() -> void
+    {
+        if((_extended == false) && (count != 0) && (get_track_length(0) == 0)) {
+            summary.errors.push_back("the track size is zero");
+            return;
+        }
+        for(int index = 0; index < count; ++index) {
+            const size_t length = get_track_length(index);
+            if(length == 0) {
+                continue;
+            }
+            if(length > (_size - offset)) {
+                report(summary.errors, index, "truncated track block (" + std::to_string(length - (_size - offset)) + " bytes missing)");
+                offset = _size;
+                break;
+            }
+            inspect_track(index, &_data[offset], length);
+            offset += length;
+        }
+        if(offset < _size) {
+            summary.warnings.push_back(std::to_string(_size - offset) + ' ' + "trailing bytes");
+        }
+    };
+
+    return inspect_tracks(), summary;
+}
+
+void DiskFile::convert(const std::string& filename, const bool extended) const
+{
+    const int            sides  = (get_number_of_sides() > 1 ? 2 : 1);
+    const int            count  = (get_number_of_tracks() * sides);
+    size_t               offset = sizeof(DiskRecord);
+    std::vector<uint8_t> output(sizeof(DiskRecord), 0);
+    std::vector<uint8_t> blocks;
+    std::vector<size_t>  lengths;
+
+    auto error = [&](const std::string& message) -> std::runtime_error
+    {
+        return std::runtime_error(std::string() + '<' + filename + '>' + ' ' + message);
+    };
+
+    auto build_header = [&]() -> void
+    {
+        const char* magic = (extended != false ? "EXTENDED CPC DSK File\r\nDisk-Info\r\n" : "MV - CPCEMU Disk-File\r\nDisk-Info\r\n");
+        static_cast<void>(::memcpy(&output[0x00], magic, 34));
+        static_cast<void>(::memcpy(&output[0x22], &_data[0x22], 14));
+        output[0x30] = get_number_of_tracks();
+        output[0x31] = get_number_of_sides();
+    };
+
+    auto build_track = [&](const int index, const uint8_t* info, const size_t length) -> void
+    {
+        std::vector<uint8_t> block(256, 0);
+        if(length == 0) {
+            static_cast<void>(::memcpy(&block[0x00], "Track-Info\r\n", 12));
+            block[0x10] = (index / sides);
+            block[0x11] = (index % sides);
+            block[0x14] = 2;
+            block[0x16] = 0x4e;
+            block[0x17] = 0xe5;
+        }
+        else {
+            if((length < 256) || (::memcmp(info, "Track-Info", 10) != 0)) {
+                throw error("has a bad track-info signature at track " + std::to_string(index / sides));
+            }
+            static_cast<void>(::memcpy(&block[0], info, 256));
+            const TrackView track(info, length, _extended);
+            const int       number_of_sectors = (info[0x15] < 29 ? info[0x15] : 29);
+            size_t          data              = 256;
+            for(int sector = 0; sector < number_of_sectors; ++sector) {
+                const size_t sector_length = track.get_sector_length(sector);
+                if((data + sector_length) > length) {
+                    throw error("has sector data beyond its track block at track " + std::to_string(index / sides));
+                }
+                if(extended != false) {
+                    block[0x18 + (sector * 8) + 6] = ((sector_length >> 0) & 0xff);
+                    block[0x18 + (sector * 8) + 7] = ((sector_length >> 8) & 0xff);
+                }
+                else {
+                    if(sector_length != static_cast<size_t>(0x80 << (info[0x14] & 7))) {
+                        throw error("cannot be represented as a standard disk image");
+                    }
+                    block[0x18 + (sector * 8) + 6] = 0;
+                    block[0x18 + (sector * 8) + 7] = 0;
+                }
+                block.insert(block.end(), &info[data], &info[data + sector_length]);
+                data += sector_length;
+            }
+            block.resize((block.size() + 255) & ~static_cast<size_t>(255), 0);
+        }
+        if((extended != false) && ((block.size() / 256) > 255)) {
+            throw error("has a track block too large for an extended disk image");
+        }
+        blocks.insert(blocks.end(), block.begin(), block.end());
+        lengths.push_back(block.size());
+    };
+
+    auto build_tracks = [&]() -> void
+    {
+        for(int index = 0; index < count; ++index) {
+            const size_t length = get_track_length(index);
+            if(length > (_size - offset)) {
+                throw error("is a truncated disk image");
+            }
+            if((length == 0) && (extended != false)) {
+                lengths.push_back(0);
+                continue;
+            }
+            build_track(index, &_data[offset], length);
+            offset += length;
+        }
+    };
+
+    auto build_layout = [&]() -> void
+    {
+        if(extended != false) {
+            for(int index = 0; (index < count) && ((0x34 + index) < 256); ++index) {
+                output[0x34 + index] = (lengths[index] / 256);
+            }
+            output.insert(output.end(), blocks.begin(), blocks.end());
+        }
+        else {
+            size_t track_size = 0;
+            for(const size_t length : lengths) {
+                if(track_size < length) {
+                    track_size = length;
+                }
+            }
+            if(track_size > 0xffff) {
+                throw error("has a track block too large for a standard disk image");
+            }
+            output[0x32] = ((track_size >> 0) & 0xff);
+            output[0x33] = ((track_size >> 8) & 0xff);
+            size_t block = 0;
+            for(const size_t length : lengths) {
+                output.insert(output.end(), &blocks[block], &blocks[block] + length);
+                output.resize(output.size() + (track_size - length), 0);
+                block += length;
+            }
+        }
+    };
+
+    auto store_output = [&]() -> void
+    {
+        const int file = utils::open(filename, (O_WRONLY | O_CREAT | O_TRUNC), 0644);
+        try {
+            const ssize_t rc = utils::store(file, output.data(), output.size());
+            if(rc != static_cast<ssize_t>(output.size())) {
+                throw std::runtime_error("store() has failed");
+            }
+        }
+        catch(...) {
+            static_cast<void>(::close(file));
+            throw;
+        }
+        utils::close(file);
+    };
+
+    auto do_convert = [&]() -> void
+    {
+        build_header();
+        build_tracks();
+        build_layout();
+        store_output();
+    };
+
+    return do_convert();
+}
+
+auto DiskFile::get_creator() const -> std::string
+{
+    std::string creator;
+
+    for(const uint8_t character : _disk->info.s.tool) {
+        if((character < 0x20) || (character > 0x7e)) {
+            break;
+        }
+        creator += static_cast<char>(character);
+    }
+    while((creator.empty() == false) && (creator.back() == ' ')) {
+        creator.pop_back();
+    }
+    return creator;
+}
+
+auto DiskFile::get_track_length(const int track) const -> size_t
+{
+    if(_extended != false) {
+        const int entry = (0x34 + track);
+        if(entry < 256) {
+            return (_data[entry] * 256);
+        }
+        return 0;
+    }
+    return (_data[0x32] | (_data[0x33] << 8));
+}
+
+auto DiskFile::get_track(const int index) const -> TrackView
+{
+    const size_t offset = get_track_offset(index);
+    const size_t length = get_track_length(index);
+
+    if(length == 0) {
+        return TrackView(nullptr, 0, _extended);
+    }
+    if((offset > _size) || (length > (_size - offset))) {
+        throw std::runtime_error("track block is truncated");
+    }
+    return TrackView(&_data[offset], length, _extended);
+}
+
+auto DiskFile::get_track_offset(const int track) const -> size_t
+{
+    if(_extended != false) {
+        size_t offset = sizeof(DiskRecord);
+        for(int index = 0; index < track; ++index) {
+            offset += get_track_length(index);
+        }
+        return offset;
+    }
+    return sizeof(DiskRecord) + (track * get_track_length(track));
 }
 
 }
@@ -528,6 +528,404 @@ protected: // protected data
 
 }
 
+// ---------------------------------------------------------------------------
+// dsk::Image
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+class Image
+{
+public: // public types
+    struct Sector
+    {
+        uint32_t info; /* arena offset of the sector info */
+        uint32_t data; /* arena offset of the sector data */
+        uint32_t size; /* stored length of the sector data */
+    };
+
+    struct Track
+    {
+        uint32_t offset;     /* arena offset of the track block  */
+        uint32_t length;     /* length of the track block        */
+        uint8_t  count;      /* number of sectors                */
+        bool     valid;      /* the track block has a track-info */
+        bool     unique;     /* all sector ids are distinct      */
+        bool     dirty;      /* the track block must be flushed  */
+        uint8_t  index[256]; /* sector id -> first sector slot   */
+        Sector   sector[29];
+    };
+
+    static constexpr uint8_t NO_SECTOR = 0xff;
+
+public: // public interface
+    Image(const std::string& filename);
+
+    Image(Image&&) = delete;
+
+    Image(const Image&) = delete;
+
+    Image& operator=(Image&&) = delete;
+
+    Image& operator=(const Image&) = delete;
+
+    virtual ~Image() = default;
+
+    static auto probe(const std::string& filename) -> bool;
+
+    void load();
+
+    void load(std::vector<uint8_t>& buffer);
+
+    void inflate();
+
+    void flush();
+
+    void mark_dirty(Track& track);
+
+    auto format(int cylinder, int head, const uint8_t* ids, int count, uint8_t filler) -> bool;
+
+    auto find_track(int cylinder, int head) -> Track*;
+
+    auto get_track_info(const Track& track) -> uint8_t*
+    {
+        return &_arena[track.offset];
+    }
+
+    auto get_sector_info(const Track& track, int slot) -> uint8_t*
+    {
+        return &_arena[track.sector[slot].info];
+    }
+
+    auto get_sector_data(const Track& track, int slot) -> uint8_t*
+    {
+        return _arena.data() + track.sector[slot].data;
+    }
+
+    auto get_sector_limit(const Track& track, int slot) const -> uint32_t
+    {
+        const uint32_t data  = track.sector[slot].data;
+        const uint32_t arena = static_cast<uint32_t>(_arena.size());
+        const uint32_t end   = ((track.offset + track.length) < arena ? (track.offset + track.length) : arena);
+
+        /* overlong sectors (copy protections) must not spill into the next track block */
+        return (data < end ? end - data : 0);
+    }
+
+    auto get_filename() const -> const std::string&
+    {
+        return _filename;
+    }
+
+    auto get_number_of_tracks() const -> uint8_t
+    {
+        return _arena[0x30];
+    }
+
+    auto get_number_of_sides() const -> uint8_t
+    {
+        return _arena[0x31];
+    }
+
+    auto is_extended() const -> bool
+    {
+        return _extended;
+    }
+
+    auto is_readonly() const -> bool
+    {
+        return _readonly;
+    }
+
+    auto is_compressed() const -> bool
+    {
+        return _compressed;
+    }
+
+    auto is_dirty() const -> bool
+    {
+        return (_header_dirty != false) || (_dirty.empty() == false);
+    }
+
+private: // private interface
+    void check_header();
+
+    void build_index();
+
+    void build_track(Track& track, uint32_t offset, uint32_t length);
+
+    auto get_track_length(int track) const -> uint32_t;
+
+private: // private data
+    std::string          _filename;
+    std::vector<uint8_t> _arena;
+    std::vector<Track>   _tracks;
+    std::vector<int>     _dirty;
+    bool                 _header_dirty;
+    bool                 _extended;
+    bool                 _readonly;
+    bool                 _compressed;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::SectorView
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+class SectorView
+{
+public: // public interface
+    SectorView(const uint8_t* info, const uint8_t* data, const size_t size)
+        : _info(info)
+        , _data(data)
+        , _size(size)
+    {
+    }
+
+    void check() const;
+
+    void print() const;
+
+    auto get_fdc_c() const -> uint8_t
+    {
+        return _info[0];
+    }
+
+    auto get_fdc_h() const -> uint8_t
+    {
+        return _info[1];
+    }
+
+    auto get_fdc_r() const -> uint8_t
+    {
+        return _info[2];
+    }
+
+    auto get_fdc_n() const -> uint8_t
+    {
+        return _info[3];
+    }
+
+    auto get_fdc_st1() const -> uint8_t
+    {
+        return _info[4];
+    }
+
+    auto get_fdc_st2() const -> uint8_t
+    {
+        return _info[5];
+    }
+
+    auto get_size() const -> uint16_t
+    {
+        return (static_cast<uint16_t>(_info[7]) << 8)
+             | (static_cast<uint16_t>(_info[6]) << 0)
+             ;
+    }
+
+    auto data() const -> const uint8_t*
+    {
+        return _data;
+    }
+
+    auto size() const -> size_t
+    {
+        return _size;
+    }
+
+private: // private data
+    const uint8_t* _info;
+    const uint8_t* _data;
+    size_t         _size;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::TrackView
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+class TrackView
+{
+public: // public interface
+    TrackView(const uint8_t* block, const size_t length, const bool extended)
+        : _block(block)
+        , _length(length)
+        , _extended(extended)
+    {
+    }
+
+    void check() const;
+
+    void print() const;
+
+    auto get_sector(const int index) const -> SectorView;
+
+    auto get_sector_length(const int index) const -> size_t;
+
+    auto get_record() const -> const TrackRecord&
+    {
+        return *reinterpret_cast<const TrackRecord*>(_block);
+    }
+
+    auto get_track_number() const -> uint8_t
+    {
+        return _block[0x10];
+    }
+
+    auto get_side_number() const -> uint8_t
+    {
+        return _block[0x11];
+    }
+
+    auto get_sector_size() const -> uint8_t
+    {
+        return _block[0x14];
+    }
+
+    auto get_number_of_sectors() const -> uint8_t
+    {
+        return _block[0x15];
+    }
+
+    auto get_gap3_length() const -> uint8_t
+    {
+        return _block[0x16];
+    }
+
+    auto get_filler_byte() const -> uint8_t
+    {
+        return _block[0x17];
+    }
+
+    auto is_formatted() const -> bool
+    {
+        return _length >= 256;
+    }
+
+    auto data() const -> const uint8_t*
+    {
+        return _block;
+    }
+
+    auto size() const -> size_t
+    {
+        return _length;
+    }
+
+private: // private data
+    const uint8_t* _block;
+    size_t         _length;
+    bool           _extended;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::DiskFile
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+class DiskFile
+{
+public: // public types
+    struct Summary
+    {
+        unsigned int             tracks   = 0;
+        unsigned int             sectors  = 0;
+        size_t                   data     = 0;
+        std::vector<std::string> errors;
+        std::vector<std::string> warnings;
+    };
+
+public: // public interface
+    DiskFile(const std::string& filename);
+
+    DiskFile(DiskFile&&) = delete;
+
+    DiskFile(const DiskFile&) = delete;
+
+    DiskFile& operator=(DiskFile&&) = delete;
+
+    DiskFile& operator=(const DiskFile&) = delete;
+
+    virtual ~DiskFile();
+
+    void check() const;
+
+    void print() const;
+
+    auto inspect() const -> Summary;
+
+    void convert(const std::string& filename, const bool extended) const;
+
+    auto get_track(const int index) const -> TrackView;
+
+    auto get_number_of_blocks() const -> int
+    {
+        return get_number_of_tracks() * (get_number_of_sides() > 1 ? 2 : 1);
+    }
+
+    auto get_disk_info() const -> const DiskRecord&
+    {
+        return *_disk;
+    }
+
+    auto get_creator() const -> std::string;
+
+    auto get_number_of_tracks() const -> uint8_t
+    {
+        return _disk->info.s.number_of_tracks;
+    }
+
+    auto get_number_of_sides() const -> uint8_t
+    {
+        return _disk->info.s.number_of_sides;
+    }
+
+    auto get_data() const -> const uint8_t*
+    {
+        return _data;
+    }
+
+    auto get_size() const -> size_t
+    {
+        return _size;
+    }
+
+    auto is_extended() const -> bool
+    {
+        return _extended;
+    }
+
+    auto is_compressed() const -> bool
+    {
+        return _compressed;
+    }
+
+private: // private interface
+    auto get_track_offset(const int track) const -> size_t;
+
+    auto get_track_length(const int track) const -> size_t;
+
+private: // private data
+    const uint8_t*       _data;
+    size_t               _size;
+    size_t               _mapped;
+    const DiskRecord*    _disk;
+    bool                 _extended;
+    bool                 _compressed;
+    std::vector<uint8_t> _buffer;
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // End-Of-File
 // ---------------------------------------------------------------------------
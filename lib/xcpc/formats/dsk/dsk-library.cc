@@ -0,0 +1,649 @@
+/*
+ * dsk-library.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+#include <cstdint>
+#include <climits>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_SYS_FILE_H
+#include <sys/file.h>
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <iostream>
+#include <stdexcept>
+#include "dsk-library.h"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::LibraryTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct LibraryTraits
+{
+    static constexpr char   PACK_FILE[]   = "sectors.pack";
+    static constexpr char   BLOB_INDEX[]  = "sectors.idx";
+    static constexpr char   IMAGE_INDEX[] = "images.idx";
+    static constexpr char   BLOB_MAGIC[]  = "XDLBLOB1";
+    static constexpr char   IMAGE_MAGIC[] = "XDLIMGS1";
+    static constexpr size_t MAGIC_SIZE    = 8;
+    static constexpr size_t BLOB_SIZE     = 20;
+
+    static auto error(const std::string& filename, const char* message) -> std::runtime_error
+    {
+        return std::runtime_error(std::string() + '<' + filename + '>' + ' ' + message);
+    }
+
+    static auto hash(const uint8_t* data, const size_t size) -> uint64_t
+    {
+        uint64_t value = 0xcbf29ce484222325ULL;
+
+        for(size_t index = 0; index < size; ++index) {
+            value ^= data[index];
+            value *= 0x00000100000001b3ULL;
+        }
+        return value;
+    }
+
+    static auto open(const std::string& filename, const bool writable) -> int
+    {
+        const int flags = (writable != false ? (O_RDWR | O_CREAT | O_APPEND) : O_RDONLY);
+        const int fd    = ::open(filename.c_str(), flags, 0644);
+
+        if(fd < 0) {
+            throw error(filename, "could not be opened");
+        }
+        return fd;
+    }
+
+    static auto lock(const std::string& directory) -> int
+    {
+        const int fd = ::open(directory.c_str(), O_RDONLY);
+
+        if(fd < 0) {
+            throw error(directory, "could not be opened");
+        }
+        while(::flock(fd, LOCK_EX) != 0) {
+            if(errno != EINTR) {
+                static_cast<void>(::close(fd));
+                throw error(directory, "could not be locked");
+            }
+        }
+        return fd;
+    }
+
+    static auto truncate(const std::string& filename, const int fd, const uint64_t length) -> void
+    {
+        struct stat statbuf;
+        if(::fstat(fd, &statbuf) != 0) {
+            throw error(filename, "could not be examined");
+        }
+        if(static_cast<uint64_t>(statbuf.st_size) > length) {
+            if(::ftruncate(fd, length) != 0) {
+                throw error(filename, "could not be repaired");
+            }
+        }
+    }
+
+    static auto close(const int fd) -> int
+    {
+        if(fd >= 0) {
+            static_cast<void>(::close(fd));
+        }
+        return -1;
+    }
+
+    static auto fetch(const std::string& filename, const int fd, std::vector<uint8_t>& buffer) -> void
+    {
+        struct stat statbuf;
+        if(::fstat(fd, &statbuf) != 0) {
+            throw error(filename, "could not be examined");
+        }
+        buffer.resize(statbuf.st_size);
+        size_t count = 0;
+        while(count < buffer.size()) {
+            const ssize_t rc = ::pread(fd, &buffer[count], (buffer.size() - count), count);
+            if(rc < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw error(filename, "could not be read");
+            }
+            if(rc == 0) {
+                break;
+            }
+            count += rc;
+        }
+        buffer.resize(count);
+    }
+
+    static auto store(const std::string& filename, const int fd, const void* data, const size_t size) -> void
+    {
+        const uint8_t* bufptr = static_cast<const uint8_t*>(data);
+        size_t         buflen = size;
+
+        while(buflen > 0) {
+            const ssize_t rc = ::write(fd, bufptr, buflen);
+            if(rc < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw error(filename, "could not be written");
+            }
+            bufptr += rc;
+            buflen -= rc;
+        }
+    }
+
+    static auto sync(const std::string& filename, const int fd) -> void
+    {
+        while(::fdatasync(fd) != 0) {
+            if(errno != EINTR) {
+                throw error(filename, "could not be synced");
+            }
+        }
+    }
+
+    static auto put(std::vector<uint8_t>& buffer, uint64_t value, const int count) -> void
+    {
+        for(int index = 0; index < count; ++index) {
+            buffer.push_back(value & 0xff);
+            value >>= 8;
+        }
+    }
+
+    static auto get(const uint8_t* data, const int count) -> uint64_t
+    {
+        uint64_t value = 0;
+
+        for(int index = count - 1; index >= 0; --index) {
+            value = ((value << 8) | data[index]);
+        }
+        return value;
+    }
+
+    static auto check_magic(const std::string& filename, const std::vector<uint8_t>& buffer, const char* magic) -> bool
+    {
+        if(buffer.empty()) {
+            return false;
+        }
+        if((buffer.size() < MAGIC_SIZE) || (::memcmp(buffer.data(), magic, MAGIC_SIZE) != 0)) {
+            throw error(filename, "is not a disk library index");
+        }
+        return true;
+    }
+};
+
+constexpr char   LibraryTraits::PACK_FILE[];
+constexpr char   LibraryTraits::BLOB_INDEX[];
+constexpr char   LibraryTraits::IMAGE_INDEX[];
+constexpr char   LibraryTraits::BLOB_MAGIC[];
+constexpr char   LibraryTraits::IMAGE_MAGIC[];
+
+}
+
+// ---------------------------------------------------------------------------
+// dsk::Library
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+Library::Library(const std::string& directory)
+    : _directory(directory)
+    , _lock(-1)
+    , _pack(-1)
+    , _blob_index(-1)
+    , _image_index(-1)
+    , _pack_size(0)
+    , _blobs()
+    , _hashes()
+    , _images()
+{
+}
+
+Library::~Library()
+{
+    close();
+}
+
+void Library::open(const bool writable)
+{
+    auto do_mkdir = [&]() -> void
+    {
+        if((writable != false) && (::mkdir(_directory.c_str(), 0755) != 0) && (errno != EEXIST)) {
+            throw LibraryTraits::error(_directory, "could not be created");
+        }
+    };
+
+    auto do_lock = [&]() -> void
+    {
+        if(writable != false) {
+            _lock = LibraryTraits::lock(_directory);
+        }
+    };
+
+    auto do_open = [&]() -> void
+    {
+        _pack        = LibraryTraits::open(_directory + '/' + LibraryTraits::PACK_FILE, writable);
+        _blob_index  = LibraryTraits::open(_directory + '/' + LibraryTraits::BLOB_INDEX, writable);
+        _image_index = LibraryTraits::open(_directory + '/' + LibraryTraits::IMAGE_INDEX, writable);
+        struct stat statbuf;
+        if(::fstat(_pack, &statbuf) != 0) {
+            throw LibraryTraits::error(_directory, "could not be examined");
+        }
+        _pack_size = statbuf.st_size;
+    };
+
+    auto do_load = [&]() -> void
+    {
+        const uint64_t blob_length  = load_blobs();
+        const uint64_t image_length = load_images();
+
+        if(writable != false) {
+            _pack_size = (_blobs.empty() ? 0 : _blobs.back().offset + _blobs.back().size);
+            LibraryTraits::truncate(_directory + '/' + LibraryTraits::PACK_FILE, _pack, _pack_size);
+            LibraryTraits::truncate(_directory + '/' + LibraryTraits::BLOB_INDEX, _blob_index, blob_length);
+            LibraryTraits::truncate(_directory + '/' + LibraryTraits::IMAGE_INDEX, _image_index, image_length);
+        }
+    };
+
+    close();
+    try {
+        do_mkdir();
+        do_lock();
+        do_open();
+        do_load();
+    }
+    catch(...) {
+        close();
+        throw;
+    }
+}
+
+void Library::close()
+{
+    _pack        = LibraryTraits::close(_pack);
+    _blob_index  = LibraryTraits::close(_blob_index);
+    _image_index = LibraryTraits::close(_image_index);
+    _lock        = LibraryTraits::close(_lock);
+    _pack_size   = 0;
+    _blobs.clear();
+    _hashes.clear();
+    _images.clear();
+}
+
+auto Library::add(const std::string& name, const DiskFile& disk) -> Added
+{
+    Added                 added;
+    Entry                 entry;
+    std::vector<uint32_t> cuts;
+    const uint8_t*        data = disk.get_data();
+
+    if(name.empty() || (name.find(MEMBER_SEPARATOR) != std::string::npos)) {
+        throw LibraryTraits::error(name, "is not a valid image name");
+    }
+    split(disk, cuts);
+    entry.size = disk.get_size();
+    for(size_t index = 1; index < cuts.size(); ++index) {
+        const uint8_t* segment = &data[cuts[index - 1]];
+        const uint32_t size    = (cuts[index] - cuts[index - 1]);
+        const uint64_t hash    = LibraryTraits::hash(segment, size);
+        int64_t        blob    = find_blob(segment, size, hash);
+        if(blob < 0) {
+            blob = store_blob(segment, size, hash);
+            added.new_blobs += 1;
+            added.new_bytes += size;
+        }
+        entry.segments.push_back(static_cast<uint32_t>(blob));
+    }
+    added.segments = entry.segments.size();
+    /* the blobs must be durable before an image record refers to them */ {
+        if(added.new_blobs != 0) {
+            LibraryTraits::sync(_directory + '/' + LibraryTraits::PACK_FILE, _pack);
+            LibraryTraits::sync(_directory + '/' + LibraryTraits::BLOB_INDEX, _blob_index);
+        }
+    }
+    store_image(name, entry);
+    _images[name] = std::move(entry);
+
+    return added;
+}
+
+void Library::extract(const std::string& name, std::vector<uint8_t>& buffer) const
+{
+    const auto image = _images.find(name);
+
+    if(image == _images.end()) {
+        throw LibraryTraits::error(name, "is not in the disk library");
+    }
+    buffer.resize(image->second.size);
+    size_t offset = 0;
+    for(const uint32_t segment : image->second.segments) {
+        const Blob& blob(_blobs[segment]);
+        if((offset + blob.size) > buffer.size()) {
+            throw LibraryTraits::error(name, "has a corrupted segment list");
+        }
+        fetch_blob(blob, &buffer[offset]);
+        offset += blob.size;
+    }
+    if(offset != buffer.size()) {
+        throw LibraryTraits::error(name, "has a corrupted segment list");
+    }
+}
+
+void Library::restore(const std::string& name, const std::string& filename) const
+{
+    std::vector<uint8_t> buffer;
+
+    extract(name, buffer);
+    const int fd = ::open(filename.c_str(), (O_WRONLY | O_CREAT | O_TRUNC), 0644);
+    if(fd < 0) {
+        throw LibraryTraits::error(filename, "could not be created");
+    }
+    try {
+        LibraryTraits::store(filename, fd, buffer.data(), buffer.size());
+    }
+    catch(...) {
+        static_cast<void>(::close(fd));
+        throw;
+    }
+    if(::close(fd) != 0) {
+        throw LibraryTraits::error(filename, "could not be written");
+    }
+}
+
+auto Library::has_image(const std::string& name) const -> bool
+{
+    return _images.find(name) != _images.end();
+}
+
+auto Library::get_names() const -> std::vector<std::string>
+{
+    std::vector<std::string> names;
+
+    for(auto& image : _images) {
+        names.push_back(image.first);
+    }
+    return names;
+}
+
+auto Library::get_stats() const -> Stats
+{
+    Stats stats;
+
+    stats.images       = _images.size();
+    stats.blobs        = _blobs.size();
+    stats.stored_bytes = _pack_size;
+    for(auto& image : _images) {
+        stats.image_bytes += image.second.size;
+    }
+    return stats;
+}
+
+auto Library::is_library(const std::string& directory) -> bool
+{
+    const std::string filename(directory + '/' + LibraryTraits::IMAGE_INDEX);
+
+    return ::access(filename.c_str(), R_OK) == 0;
+}
+
+auto Library::split_member(const std::string& path, std::string& directory, std::string& name) -> bool
+{
+    const size_t separator = path.rfind(MEMBER_SEPARATOR);
+
+    if((separator == std::string::npos) || (separator == 0) || (separator == (path.size() - 1))) {
+        return false;
+    }
+    if(is_library(path.substr(0, separator)) == false) {
+        return false;
+    }
+    directory = path.substr(0, separator);
+    name      = path.substr(separator + 1);
+    return true;
+}
+
+auto Library::load_blobs() -> uint64_t
+{
+    const std::string    filename(_directory + '/' + LibraryTraits::BLOB_INDEX);
+    std::vector<uint8_t> buffer;
+
+    LibraryTraits::fetch(filename, _blob_index, buffer);
+    if(LibraryTraits::check_magic(filename, buffer, LibraryTraits::BLOB_MAGIC) == false) {
+        if(_pack_size != 0) {
+            throw LibraryTraits::error(filename, "is missing");
+        }
+        return 0;
+    }
+    const size_t count = ((buffer.size() - LibraryTraits::MAGIC_SIZE) / LibraryTraits::BLOB_SIZE);
+    _blobs.reserve(count);
+    for(size_t index = 0; index < count; ++index) {
+        const uint8_t* record = &buffer[LibraryTraits::MAGIC_SIZE + (index * LibraryTraits::BLOB_SIZE)];
+        Blob blob;
+        blob.hash   = LibraryTraits::get(&record[0], 8);
+        blob.offset = LibraryTraits::get(&record[8], 8);
+        blob.size   = LibraryTraits::get(&record[16], 4);
+        if((blob.offset + blob.size) > _pack_size) {
+            break;
+        }
+        _hashes.emplace(blob.hash, static_cast<uint32_t>(_blobs.size()));
+        _blobs.push_back(blob);
+    }
+    return LibraryTraits::MAGIC_SIZE + (_blobs.size() * LibraryTraits::BLOB_SIZE);
+}
+
+auto Library::load_images() -> uint64_t
+{
+    const std::string    filename(_directory + '/' + LibraryTraits::IMAGE_INDEX);
+    std::vector<uint8_t> buffer;
+
+    LibraryTraits::fetch(filename, _image_index, buffer);
+    if(LibraryTraits::check_magic(filename, buffer, LibraryTraits::IMAGE_MAGIC) == false) {
+        return 0;
+    }
+    size_t offset = LibraryTraits::MAGIC_SIZE;
+    while((offset + 2) <= buffer.size()) {
+        const size_t length = LibraryTraits::get(&buffer[offset], 2);
+        if((offset + 2 + length + 12) > buffer.size()) {
+            break;
+        }
+        const size_t count = LibraryTraits::get(&buffer[offset + 2 + length + 8], 4);
+        const size_t next  = (offset + 2 + length + 12 + (count * 4));
+        if(next > buffer.size()) {
+            break;
+        }
+        Entry entry;
+        entry.size = LibraryTraits::get(&buffer[offset + 2 + length], 8);
+        for(size_t index = 0; index < count; ++index) {
+            const uint32_t segment = LibraryTraits::get(&buffer[offset + 2 + length + 12 + (index * 4)], 4);
+            if(segment >= _blobs.size()) {
+                break;
+            }
+            entry.segments.push_back(segment);
+        }
+        if(entry.segments.size() != count) {
+            break;
+        }
+        _images[std::string(reinterpret_cast<const char*>(&buffer[offset + 2]), length)] = std::move(entry);
+        offset = next;
+    }
+    return offset;
+}
+
+void Library::split(const DiskFile& disk, std::vector<uint32_t>& cuts) const
+{
+    const uint8_t* data  = disk.get_data();
+    const size_t   size  = disk.get_size();
+    const int      count = disk.get_number_of_blocks();
+
+    auto add_cut = [&](const uint8_t* pointer) -> void
+    {
+        const size_t offset = (pointer - data);
+        if(offset <= size) {
+            cuts.push_back(offset);
+        }
+    };
+
+    auto add_track = [&](const TrackView& track) -> void
+    {
+        add_cut(track.data());
+        add_cut(track.data() + 256);
+        const int number_of_sectors = std::min<int>(track.get_number_of_sectors(), 29);
+        for(int slot = 0; slot < number_of_sectors; ++slot) {
+            const SectorView sector(track.get_sector(slot));
+            add_cut(sector.data());
+            add_cut(sector.data() + sector.size());
+        }
+        add_cut(track.data() + track.size());
+    };
+
+    auto add_tracks = [&]() -> void
+    {
+        for(int index = 0; index < count; ++index) {
+            try {
+                const TrackView track(disk.get_track(index));
+                if(track.is_formatted() != false) {
+                    add_track(track);
+                }
+            }
+            catch(const std::exception&) {
+                break;
+            }
+        }
+    };
+
+    if(size > UINT32_MAX) {
+        throw std::runtime_error("disk image is too large for the disk library");
+    }
+    cuts.clear();
+    cuts.push_back(0);
+    add_cut(data + std::min<size_t>(size, sizeof(DiskRecord)));
+    add_tracks();
+    cuts.push_back(size);
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+}
+
+auto Library::find_blob(const uint8_t* data, const uint32_t size, const uint64_t hash) const -> int64_t
+{
+    std::vector<uint8_t> content;
+    const auto           range = _hashes.equal_range(hash);
+
+    for(auto iterator = range.first; iterator != range.second; ++iterator) {
+        const Blob& blob(_blobs[iterator->second]);
+        if(blob.size != size) {
+            continue;
+        }
+        content.resize(size);
+        fetch_blob(blob, content.data());
+        if(::memcmp(content.data(), data, size) == 0) {
+            return iterator->second;
+        }
+    }
+    return -1;
+}
+
+auto Library::store_blob(const uint8_t* data, const uint32_t size, const uint64_t hash) -> uint32_t
+{
+    const std::string    filename(_directory + '/' + LibraryTraits::BLOB_INDEX);
+    std::vector<uint8_t> record;
+    Blob                 blob;
+
+    blob.hash   = hash;
+    blob.offset = _pack_size;
+    blob.size   = size;
+    if(_blobs.empty() && (::lseek(_blob_index, 0, SEEK_END) == 0)) {
+        record.insert(record.end(), LibraryTraits::BLOB_MAGIC, LibraryTraits::BLOB_MAGIC + LibraryTraits::MAGIC_SIZE);
+    }
+    LibraryTraits::put(record, blob.hash, 8);
+    LibraryTraits::put(record, blob.offset, 8);
+    LibraryTraits::put(record, blob.size, 4);
+    LibraryTraits::store(_directory, _pack, data, size);
+    _pack_size += size;
+    LibraryTraits::store(filename, _blob_index, record.data(), record.size());
+    _hashes.emplace(blob.hash, static_cast<uint32_t>(_blobs.size()));
+    _blobs.push_back(blob);
+
+    return static_cast<uint32_t>(_blobs.size() - 1);
+}
+
+void Library::store_image(const std::string& name, const Entry& entry)
+{
+    const std::string    filename(_directory + '/' + LibraryTraits::IMAGE_INDEX);
+    std::vector<uint8_t> record;
+
+    if(name.size() > 0xffff) {
+        throw LibraryTraits::error(name, "is not a valid image name");
+    }
+    if(::lseek(_image_index, 0, SEEK_END) == 0) {
+        record.insert(record.end(), LibraryTraits::IMAGE_MAGIC, LibraryTraits::IMAGE_MAGIC + LibraryTraits::MAGIC_SIZE);
+    }
+    LibraryTraits::put(record, name.size(), 2);
+    record.insert(record.end(), name.begin(), name.end());
+    LibraryTraits::put(record, entry.size, 8);
+    LibraryTraits::put(record, entry.segments.size(), 4);
+    for(const uint32_t segment : entry.segments) {
+        LibraryTraits::put(record, segment, 4);
+    }
+    LibraryTraits::store(filename, _image_index, record.data(), record.size());
+}
+
+void Library::fetch_blob(const Blob& blob, uint8_t* data) const
+{
+    size_t count = 0;
+
+    while(count < blob.size) {
+        const ssize_t rc = ::pread(_pack, &data[count], (blob.size - count), (blob.offset + count));
+        if(rc < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            throw LibraryTraits::error(_directory, "could not be read");
+        }
+        if(rc == 0) {
+            throw LibraryTraits::error(_directory, "has a truncated pack file");
+        }
+        count += rc;
+    }
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,128 @@
+/*
+ * dsk-library.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_DSK_LIBRARY_H__
+#define __XCPC_DSK_LIBRARY_H__
+
+#include <xcpc/formats/dsk/dsk-format.h>
+
+// ---------------------------------------------------------------------------
+// dsk::Library
+// ---------------------------------------------------------------------------
+
+namespace dsk {
+
+class Library
+{
+public: // public types
+    struct Blob
+    {
+        uint64_t hash;   /* FNV-1a hash of the content   */
+        uint64_t offset; /* offset in the pack file      */
+        uint32_t size;   /* length of the content        */
+    };
+
+    struct Entry
+    {
+        uint64_t              size;     /* length of the rebuilt image */
+        std::vector<uint32_t> segments; /* blob ids, in file order     */
+    };
+
+    struct Stats
+    {
+        size_t images       = 0; /* number of stored images          */
+        size_t blobs        = 0; /* number of unique segments        */
+        size_t image_bytes  = 0; /* total length of the stored images */
+        size_t stored_bytes = 0; /* total length of the pack file     */
+    };
+
+    struct Added
+    {
+        size_t segments  = 0; /* number of segments of the image  */
+        size_t new_blobs = 0; /* segments that were not yet known */
+        size_t new_bytes = 0; /* bytes appended to the pack file  */
+    };
+
+public: // public interface
+    Library(const std::string& directory);
+
+    Library(Library&&) = delete;
+
+    Library(const Library&) = delete;
+
+    Library& operator=(Library&&) = delete;
+
+    Library& operator=(const Library&) = delete;
+
+    virtual ~Library();
+
+    void open(const bool writable);
+
+    void close();
+
+    auto add(const std::string& name, const DiskFile& disk) -> Added;
+
+    void extract(const std::string& name, std::vector<uint8_t>& buffer) const;
+
+    void restore(const std::string& name, const std::string& filename) const;
+
+    auto has_image(const std::string& name) const -> bool;
+
+    auto get_names() const -> std::vector<std::string>;
+
+    auto get_stats() const -> Stats;
+
+    static auto is_library(const std::string& directory) -> bool;
+
+    static auto split_member(const std::string& path, std::string& directory, std::string& name) -> bool;
+
+public: // public types
+    static constexpr char MEMBER_SEPARATOR = '#';
+
+private: // private interface
+    auto load_blobs() -> uint64_t;
+
+    auto load_images() -> uint64_t;
+
+    void split(const DiskFile& disk, std::vector<uint32_t>& cuts) const;
+
+    auto find_blob(const uint8_t* data, const uint32_t size, const uint64_t hash) const -> int64_t;
+
+    auto store_blob(const uint8_t* data, const uint32_t size, const uint64_t hash) -> uint32_t;
+
+    void store_image(const std::string& name, const Entry& entry);
+
+    void fetch_blob(const Blob& blob, uint8_t* data) const;
+
+private: // private data
+    const std::string                           _directory;
+    int                                         _lock;
+    int                                         _pack;
+    int                                         _blob_index;
+    int                                         _image_index;
+    uint64_t                                    _pack_size;
+    std::vector<Blob>                           _blobs;
+    std::unordered_multimap<uint64_t, uint32_t> _hashes;
+    std::map<std::string, Entry>                _images;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_DSK_LIBRARY_H__ */
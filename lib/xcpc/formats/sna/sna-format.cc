@@ -24,9 +24,25 @@
 #include <cstdarg>
 #include <cstdint>
 #include <climits>
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 #include <memory>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include "sna-format.h"
@@ -45,11 +61,16 @@ struct BasicTraits
     using Snapshot       = sna::Snapshot;
     using SnapshotReader = sna::SnapshotReader;
     using SnapshotWriter = sna::SnapshotWriter;
+    using SnapshotFile   = sna::SnapshotFile;
 
     static constexpr uint8_t SNAPSHOT_VERSION_1 = 1;
     static constexpr uint8_t SNAPSHOT_VERSION_2 = 2;
     static constexpr uint8_t SNAPSHOT_VERSION_3 = 3;
 
+    static constexpr size_t  MEMORY_BLOCK_SIZE  = 65536;
+    static constexpr size_t  MEMORY_BLOCK_COUNT = 9;
+    static constexpr uint8_t MEMORY_RLE_MARKER  = 0xe5;
+
     static const char signature[8];
     static const char reserved[8];
 };
@@ -95,7 +116,7 @@ struct StateTraits final
         init_version();
     }
 
-    static auto check(Header& header) -> void
+    static auto check(const Header& header) -> void
     {
         if(::memcmp(header.signature, signature, sizeof(header.signature)) != 0) {
             throw std::runtime_error("bad signature");
@@ -106,6 +127,150 @@ struct StateTraits final
             throw std::runtime_error("bad version");
         }
     }
+
+    static auto has_chunks(const Header& header) -> bool
+    {
+        return header.version >= SNAPSHOT_VERSION_3;
+    }
+
+    static auto get_ram_size(const Header& header) -> size_t
+    {
+        size_t ram_size = 0;
+        ram_size |= ((static_cast<size_t>(header.ram_size_h)) << 18);
+        ram_size |= ((static_cast<size_t>(header.ram_size_l)) << 10);
+        return ram_size;
+    }
+
+    static auto set_ram_size(Header& header, const size_t ram_size) -> void
+    {
+        header.ram_size_h = static_cast<uint8_t>(ram_size >> 18);
+        header.ram_size_l = static_cast<uint8_t>(ram_size >> 10);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// <anonymous>::ChunkTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct ChunkTraits final
+    : public BasicTraits
+{
+    struct Chunk
+    {
+        char    ident[4];
+        uint8_t size[4];
+    };
+
+    static_assert(sizeof(Chunk) == 8UL, "Chunk is invalid");
+
+    static auto get_size(const Chunk& chunk) -> uint32_t
+    {
+        uint32_t size = 0;
+        size |= ((static_cast<uint32_t>(chunk.size[0])) <<  0);
+        size |= ((static_cast<uint32_t>(chunk.size[1])) <<  8);
+        size |= ((static_cast<uint32_t>(chunk.size[2])) << 16);
+        size |= ((static_cast<uint32_t>(chunk.size[3])) << 24);
+        return size;
+    }
+
+    static auto set_size(Chunk& chunk, const uint32_t size) -> void
+    {
+        chunk.size[0] = static_cast<uint8_t>(size >>  0);
+        chunk.size[1] = static_cast<uint8_t>(size >>  8);
+        chunk.size[2] = static_cast<uint8_t>(size >> 16);
+        chunk.size[3] = static_cast<uint8_t>(size >> 24);
+    }
+
+    static auto get_memory_block(const Chunk& chunk) -> int
+    {
+        if((chunk.ident[0] == 'M')
+        && (chunk.ident[1] == 'E')
+        && (chunk.ident[2] == 'M')
+        && (chunk.ident[3] >= '0')
+        && (chunk.ident[3] <  static_cast<char>('0' + MEMORY_BLOCK_COUNT))) {
+            return chunk.ident[3] - '0';
+        }
+        return -1;
+    }
+
+    static auto set_memory_block(Chunk& chunk, const int block) -> void
+    {
+        chunk.ident[0] = 'M';
+        chunk.ident[1] = 'E';
+        chunk.ident[2] = 'M';
+        chunk.ident[3] = static_cast<char>('0' + block);
+    }
+
+    static auto encode(const uint8_t* data, const size_t size, std::vector<uint8_t>& output) -> void
+    {
+        const uint8_t marker = MEMORY_RLE_MARKER;
+        size_t        index  = 0;
+
+        output.clear();
+        while(index < size) {
+            const uint8_t value = data[index];
+            size_t        count = 1;
+            while(((index + count) < size) && (data[index + count] == value) && (count < 255)) {
+                ++count;
+            }
+            if((value == marker) && (count == 1)) {
+                output.push_back(marker);
+                output.push_back(0);
+            }
+            else if((value == marker) || (count >= 3)) {
+                output.push_back(marker);
+                output.push_back(static_cast<uint8_t>(count));
+                output.push_back(value);
+            }
+            else {
+                output.insert(output.end(), count, value);
+            }
+            index += count;
+        }
+    }
+
+    static auto decode(const uint8_t* data, const size_t size, uint8_t* output, const size_t output_size) -> void
+    {
+        size_t index  = 0;
+        size_t offset = 0;
+
+        auto put_bytes = [&](const uint8_t value, const size_t count) -> void
+        {
+            if((offset + count) > output_size) {
+                throw std::runtime_error("bad memory chunk");
+            }
+            static_cast<void>(::memset(&output[offset], value, count));
+            offset += count;
+        };
+
+        auto get_byte = [&]() -> uint8_t
+        {
+            if(index >= size) {
+                throw std::runtime_error("bad memory chunk");
+            }
+            return data[index++];
+        };
+
+        while(index < size) {
+            const uint8_t value = get_byte();
+            if(value != MEMORY_RLE_MARKER) {
+                put_bytes(value, 1);
+            }
+            else {
+                const uint8_t count = get_byte();
+                if(count == 0) {
+                    put_bytes(MEMORY_RLE_MARKER, 1);
+                }
+                else {
+                    put_bytes(get_byte(), count);
+                }
+            }
+        }
+    }
 };
 
 }
@@ -186,13 +351,70 @@ auto SnapshotReader::load(Snapshot& snapshot) -> void
         }
     };
 
+    auto load_chunk = [&](ChunkTraits::Chunk& chunk) -> bool
+    {
+        constexpr size_t chunk_size = sizeof(chunk);
+        const     size_t byte_count = ::fread(&chunk, 1, chunk_size, _file);
+
+        if(byte_count == 0) {
+            return false;
+        }
+        if(byte_count != chunk_size) {
+            throw std::runtime_error("unable to load snapshot chunk");
+        }
+        return true;
+    };
+
+    auto load_memory_chunk = [&](const int block, const uint32_t chunk_size) -> void
+    {
+        uint8_t* const block_data = snapshot->memory[block * (ChunkTraits::MEMORY_BLOCK_SIZE / sizeof(Memory))].data;
+
+        if(chunk_size == ChunkTraits::MEMORY_BLOCK_SIZE) {
+            if(::fread(block_data, 1, chunk_size, _file) != chunk_size) {
+                throw std::runtime_error("unable to load snapshot chunk");
+            }
+        }
+        else {
+            std::vector<uint8_t> buffer(chunk_size);
+            if(::fread(buffer.data(), 1, chunk_size, _file) != chunk_size) {
+                throw std::runtime_error("unable to load snapshot chunk");
+            }
+            ChunkTraits::decode(buffer.data(), buffer.size(), block_data, ChunkTraits::MEMORY_BLOCK_SIZE);
+        }
+        const size_t ram_size = (block + 1) * ChunkTraits::MEMORY_BLOCK_SIZE;
+        if(ram_size > StateTraits::get_ram_size(snapshot->header)) {
+            StateTraits::set_ram_size(snapshot->header, ram_size);
+        }
+    };
+
+    auto skip_chunk = [&](const uint32_t chunk_size) -> void
+    {
+        if(::fseek(_file, chunk_size, SEEK_CUR) != 0) {
+            throw std::runtime_error("unable to skip snapshot chunk");
+        }
+    };
+
+    auto load_chunks = [&]() -> void
+    {
+        ChunkTraits::Chunk chunk;
+
+        while(load_chunk(chunk) != false) {
+            const uint32_t chunk_size = ChunkTraits::get_size(chunk);
+            const int      block      = ChunkTraits::get_memory_block(chunk);
+            if(block >= 0) {
+                load_memory_chunk(block, chunk_size);
+            }
+            else {
+                skip_chunk(chunk_size);
+            }
+        }
+    };
+
     load_check(snapshot->header);
     load_header(snapshot->header);
     load_check(snapshot->header);
 
-    size_t remaining_bytes = 0;
-    remaining_bytes |= ((static_cast<size_t>(snapshot->header.ram_size_h)) << 18);
-    remaining_bytes |= ((static_cast<size_t>(snapshot->header.ram_size_l)) << 10);
+    size_t remaining_bytes = StateTraits::get_ram_size(snapshot->header);
     for(auto& memory : snapshot->memory) {
         constexpr size_t memory_size = sizeof(memory.data);
         if(remaining_bytes >= memory_size) {
@@ -203,6 +425,9 @@ auto SnapshotReader::load(Snapshot& snapshot) -> void
             break;
         }
     }
+    if(StateTraits::has_chunks(snapshot->header) != false) {
+        load_chunks();
+    }
 }
 
 }
@@ -255,23 +480,279 @@ auto SnapshotWriter::save(Snapshot& snapshot) -> void
         }
     };
 
+    auto save_chunk = [&](ChunkTraits::Chunk& chunk, const uint8_t* chunk_data, const uint32_t chunk_size) -> void
+    {
+        ChunkTraits::set_size(chunk, chunk_size);
+        if(::fwrite(&chunk, 1, sizeof(chunk), _file) != sizeof(chunk)) {
+            throw std::runtime_error("unable to save snapshot chunk");
+        }
+        if(::fwrite(chunk_data, 1, chunk_size, _file) != chunk_size) {
+            throw std::runtime_error("unable to save snapshot chunk");
+        }
+    };
+
+    auto save_memory_chunks = [&]() -> void
+    {
+        const size_t         ram_size = StateTraits::get_ram_size(snapshot->header);
+        ChunkTraits::Chunk   chunk;
+        std::vector<uint8_t> buffer;
+
+        for(size_t block = 0; block < ChunkTraits::MEMORY_BLOCK_COUNT; ++block) {
+            const uint8_t* const block_data = snapshot->memory[block * (ChunkTraits::MEMORY_BLOCK_SIZE / sizeof(Memory))].data;
+            if(((block + 1) * ChunkTraits::MEMORY_BLOCK_SIZE) > ram_size) {
+                break;
+            }
+            ChunkTraits::set_memory_block(chunk, block);
+            ChunkTraits::encode(block_data, ChunkTraits::MEMORY_BLOCK_SIZE, buffer);
+            if(buffer.size() < ChunkTraits::MEMORY_BLOCK_SIZE) {
+                save_chunk(chunk, buffer.data(), buffer.size());
+            }
+            else {
+                save_chunk(chunk, block_data, ChunkTraits::MEMORY_BLOCK_SIZE);
+            }
+        }
+    };
+
+    auto save_version_1 = [&]() -> void
+    {
+        save_header(snapshot->header);
+
+        size_t remaining_bytes = StateTraits::get_ram_size(snapshot->header);
+        for(auto& memory : snapshot->memory) {
+            constexpr size_t memory_size = sizeof(memory.data);
+            if(remaining_bytes >= memory_size) {
+                save_memory(memory);
+                remaining_bytes -= memory_size;
+            }
+            else {
+                break;
+            }
+        }
+    };
+
+    auto save_version_3 = [&]() -> void
+    {
+        Header header(snapshot->header);
+
+        StateTraits::set_ram_size(header, 0);
+        save_header(header);
+        save_memory_chunks();
+    };
+
     save_check(snapshot->header);
-    save_header(snapshot->header);
-    save_check(snapshot->header);
+    if(StateTraits::has_chunks(snapshot->header) != false) {
+        save_version_3();
+    }
+    else {
+        save_version_1();
+    }
+}
 
-    size_t remaining_bytes = 0;
-    remaining_bytes |= ((static_cast<size_t>(snapshot->header.ram_size_h)) << 18);
-    remaining_bytes |= ((static_cast<size_t>(snapshot->header.ram_size_l)) << 10);
-    for(auto& memory : snapshot->memory) {
-        constexpr size_t memory_size = sizeof(memory.data);
-        if(remaining_bytes >= memory_size) {
-            save_memory(memory);
-            remaining_bytes -= memory_size;
+}
+
+// ---------------------------------------------------------------------------
+// sna::SnapshotFile
+// ---------------------------------------------------------------------------
+
+namespace sna {
+
+SnapshotFile::SnapshotFile(const std::string& filename)
+    : _data(nullptr)
+    , _size(0)
+    , _mapped(0)
+    , _header(nullptr)
+    , _ram_size(0)
+    , _buffer()
+{
+    int fd = -1;
+
+    auto file_open = [&]() -> void
+    {
+        if((fd = ::open(filename.c_str(), O_RDONLY)) < 0) {
+            throw std::runtime_error("unable to open snapshot for reading");
         }
-        else {
-            break;
+    };
+
+    auto file_stat = [&]() -> void
+    {
+        struct stat statbuf;
+        if(::fstat(fd, &statbuf) != 0) {
+            throw std::runtime_error("unable to stat snapshot");
+        }
+        if(static_cast<size_t>(statbuf.st_size) < sizeof(Header)) {
+            throw std::runtime_error("unable to load snapshot header");
+        }
+        _size = static_cast<size_t>(statbuf.st_size);
+    };
+
+    auto file_map = [&]() -> bool
+    {
+#ifdef HAVE_SYS_MMAN_H
+        void* addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(addr != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            static_cast<void>(::madvise(addr, _size, MADV_SEQUENTIAL));
+#endif
+            _data   = static_cast<const uint8_t*>(addr);
+            _mapped = _size;
+            return true;
         }
+#endif
+        return false;
+    };
+
+    auto file_read = [&]() -> void
+    {
+        _buffer.resize(_size);
+        size_t count = 0;
+        while(count < _size) {
+            const ssize_t rc = ::read(fd, &_buffer[count], (_size - count));
+            if(rc < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("unable to read snapshot");
+            }
+            if(rc == 0) {
+                throw std::runtime_error("unable to read snapshot");
+            }
+            count += rc;
+        }
+        _data = _buffer.data();
+    };
+
+    auto file_close = [&]() -> void
+    {
+        if(fd >= 0) {
+            fd = (static_cast<void>(::close(fd)), -1);
+        }
+    };
+
+    auto check_header = [&]() -> void
+    {
+        _header = reinterpret_cast<const Header*>(_data);
+        StateTraits::check(*_header);
+        _ram_size = StateTraits::get_ram_size(*_header);
+        if((sizeof(Header) + _ram_size) > _size) {
+            throw std::runtime_error("unable to load snapshot memory");
+        }
+    };
+
+    auto check_chunks = [&]() -> void
+    {
+        size_t offset = sizeof(Header) + _ram_size;
+
+        if(StateTraits::has_chunks(*_header) == false) {
+            return;
+        }
+        while((offset + sizeof(ChunkTraits::Chunk)) <= _size) {
+            const auto&  chunk(*reinterpret_cast<const ChunkTraits::Chunk*>(&_data[offset]));
+            const size_t chunk_size  = ChunkTraits::get_size(chunk);
+            const int    chunk_block = ChunkTraits::get_memory_block(chunk);
+            offset += sizeof(chunk);
+            if(chunk_size > (_size - offset)) {
+                throw std::runtime_error("unable to load snapshot chunk");
+            }
+            if(chunk_block >= 0) {
+                const size_t ram_size = (chunk_block + 1) * ChunkTraits::MEMORY_BLOCK_SIZE;
+                if(_ram_size < ram_size) {
+                    _ram_size = ram_size;
+                }
+            }
+            offset += chunk_size;
+        }
+    };
+
+    try {
+        file_open();
+        file_stat();
+        if(file_map() == false) {
+            file_read();
+        }
+        file_close();
+        check_header();
+        check_chunks();
+    }
+    catch(...) {
+        file_close();
+#ifdef HAVE_SYS_MMAN_H
+        if(_mapped != 0) {
+            static_cast<void>(::munmap(const_cast<uint8_t*>(_data), _mapped));
+        }
+#endif
+        throw;
+    }
+}
+
+SnapshotFile::~SnapshotFile()
+{
+#ifdef HAVE_SYS_MMAN_H
+    if(_mapped != 0) {
+        static_cast<void>(::munmap(const_cast<uint8_t*>(_data), _mapped));
     }
+#endif
+    _data   = nullptr;
+    _header = nullptr;
+}
+
+auto SnapshotFile::load(uint8_t* data, const size_t size) const -> void
+{
+    const size_t dump_size = StateTraits::get_ram_size(*_header);
+    size_t       offset    = sizeof(Header);
+
+    auto load_dump = [&]() -> void
+    {
+        static_cast<void>(::memcpy(data, &_data[offset], std::min(size, dump_size)));
+        offset += dump_size;
+    };
+
+    auto load_block = [&](const int block, const uint8_t* chunk_data, const size_t chunk_size) -> void
+    {
+        const size_t block_offset = block * ChunkTraits::MEMORY_BLOCK_SIZE;
+        const size_t block_size   = ChunkTraits::MEMORY_BLOCK_SIZE;
+
+        if(block_offset >= size) {
+            return;
+        }
+        if((block_offset + block_size) <= size) {
+            if(chunk_size == block_size) {
+                static_cast<void>(::memcpy(&data[block_offset], chunk_data, block_size));
+            }
+            else {
+                ChunkTraits::decode(chunk_data, chunk_size, &data[block_offset], block_size);
+            }
+        }
+        else {
+            std::vector<uint8_t> buffer(block_size);
+            if(chunk_size == block_size) {
+                static_cast<void>(::memcpy(buffer.data(), chunk_data, block_size));
+            }
+            else {
+                ChunkTraits::decode(chunk_data, chunk_size, buffer.data(), block_size);
+            }
+            static_cast<void>(::memcpy(&data[block_offset], buffer.data(), (size - block_offset)));
+        }
+    };
+
+    auto load_chunks = [&]() -> void
+    {
+        if(StateTraits::has_chunks(*_header) == false) {
+            return;
+        }
+        while((offset + sizeof(ChunkTraits::Chunk)) <= _size) {
+            const auto&  chunk(*reinterpret_cast<const ChunkTraits::Chunk*>(&_data[offset]));
+            const size_t chunk_size  = ChunkTraits::get_size(chunk);
+            const int    chunk_block = ChunkTraits::get_memory_block(chunk);
+            offset += sizeof(chunk);
+            if(chunk_block >= 0) {
+                load_block(chunk_block, &_data[offset], chunk_size);
+            }
+            offset += chunk_size;
+        }
+    };
+
+    load_dump();
+    load_chunks();
 }
 
 }
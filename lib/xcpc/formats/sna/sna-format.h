@@ -120,7 +120,29 @@ struct Header
     uint8_t psg_reg_15;
     uint8_t ram_size_l;
     uint8_t ram_size_h;
-    uint8_t padding[147];
+    uint8_t cpc_type;
+    uint8_t int_number;
+    uint8_t multimode[6];
+    uint8_t reserved_75[39];
+    uint8_t fdd_motor;
+    uint8_t fdd_track[4];
+    uint8_t prt_data;
+    uint8_t reserved_a2[2];
+    uint8_t vdc_type;
+    uint8_t reserved_a5[4];
+    uint8_t vdc_hcc;
+    uint8_t reserved_aa;
+    uint8_t vdc_vcc;
+    uint8_t vdc_slc;
+    uint8_t vdc_vac;
+    uint8_t vdc_hsc;
+    uint8_t vdc_vsc;
+    uint8_t vdc_flags_l;
+    uint8_t vdc_flags_h;
+    uint8_t vga_vsync_delay;
+    uint8_t vga_int_counter;
+    uint8_t int_request;
+    uint8_t padding[75];
 };
 
 }
@@ -147,11 +169,11 @@ namespace sna {
 struct State
 {
     Header header;
-    Memory memory[32];
+    Memory memory[36];
 };
 
 static_assert(sizeof(State::header) == 256UL,          "State::header is invalid");
-static_assert(sizeof(State::memory) == 512UL * 1024UL, "State::memory is invalid");
+static_assert(sizeof(State::memory) == 576UL * 1024UL, "State::memory is invalid");
 
 }
 
@@ -249,6 +271,50 @@ private: // private data
 
 }
 
+// ---------------------------------------------------------------------------
+// sna::SnapshotFile
+// ---------------------------------------------------------------------------
+
+namespace sna {
+
+class SnapshotFile
+{
+public: // public interface
+    SnapshotFile(const std::string& filename);
+
+    SnapshotFile(SnapshotFile&&) = delete;
+
+    SnapshotFile(const SnapshotFile&) = delete;
+
+    SnapshotFile& operator=(SnapshotFile&&) = delete;
+
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    virtual ~SnapshotFile();
+
+    auto load(uint8_t* data, size_t size) const -> void;
+
+    auto header() const -> const Header&
+    {
+        return *_header;
+    }
+
+    auto ram_size() const -> size_t
+    {
+        return _ram_size;
+    }
+
+private: // private data
+    const uint8_t*       _data;
+    size_t               _size;
+    size_t               _mapped;
+    const Header*        _header;
+    size_t               _ram_size;
+    std::vector<uint8_t> _buffer;
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // End-Of-File
 // ---------------------------------------------------------------------------
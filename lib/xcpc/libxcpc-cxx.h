@@ -152,6 +152,23 @@ struct Utils
 
 }
 
+// ---------------------------------------------------------------------------
+// xcpc::StartupProfile
+// ---------------------------------------------------------------------------
+
+namespace xcpc {
+
+struct StartupProfile
+{
+    static auto enable(const bool enabled) -> void;
+
+    static auto mark(const char* phase) -> void;
+
+    static auto report(const char* phase) -> void;
+};
+
+}
+
 // ---------------------------------------------------------------------------
 // xcpc::Machine
 // ---------------------------------------------------------------------------
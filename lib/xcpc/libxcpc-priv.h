@@ -46,6 +46,9 @@
 #ifdef HAVE_SYS_SHM_H
 #include <sys/shm.h>
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif
@@ -58,6 +61,8 @@
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 #include <X11/Xlib.h>
@@ -75,6 +80,10 @@
 #define countof(array) (sizeof(array) / sizeof(array[0]))
 #endif
 
+#if defined(HAVE_SYS_MMAN_H) && !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
 // ---------------------------------------------------------------------------
 // End-Of-File
 // ---------------------------------------------------------------------------
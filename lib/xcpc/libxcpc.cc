@@ -1284,6 +1284,102 @@ auto Utils::renderer_type_to_string(const RendererType value) -> std::string
 
 }
 
+// ---------------------------------------------------------------------------
+// <anonymous>::StartupProfileTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct StartupProfileTraits
+{
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct Phase
+    {
+        const char* name;
+        TimePoint   time;
+    };
+
+    struct Profile
+    {
+        TimePoint          epoch    = Clock::now();
+        std::vector<Phase> phases   = {};
+        bool               enabled  = false;
+        bool               reported = false;
+    };
+
+    static auto profile() -> Profile&
+    {
+        static Profile profile;
+
+        return profile;
+    }
+
+    static auto elapsed_ms(const TimePoint& from, const TimePoint& to) -> double
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(to - from);
+
+        return static_cast<double>(elapsed.count()) / 1000.0;
+    }
+};
+
+/* record the epoch as early as possible, before main() is entered */
+const auto& startup_profile(StartupProfileTraits::profile());
+
+}
+
+// ---------------------------------------------------------------------------
+// xcpc::StartupProfile
+// ---------------------------------------------------------------------------
+
+namespace xcpc {
+
+auto StartupProfile::enable(const bool enabled) -> void
+{
+    auto& profile(StartupProfileTraits::profile());
+
+    profile.enabled = enabled;
+}
+
+auto StartupProfile::mark(const char* phase) -> void
+{
+    auto& profile(StartupProfileTraits::profile());
+
+    if(profile.reported == false) {
+        profile.phases.push_back(StartupProfileTraits::Phase{phase, StartupProfileTraits::Clock::now()});
+    }
+}
+
+auto StartupProfile::report(const char* phase) -> void
+{
+    auto& profile(StartupProfileTraits::profile());
+
+    auto do_report = [&]() -> void
+    {
+        auto previous = profile.epoch;
+        ::xcpc_log_print("startup profile:");
+        for(auto& current : profile.phases) {
+            const double phase_ms = StartupProfileTraits::elapsed_ms(previous, current.time);
+            const double total_ms = StartupProfileTraits::elapsed_ms(profile.epoch, current.time);
+            ::xcpc_log_print("    %-32s %9.3f ms %9.3f ms", current.name, phase_ms, total_ms);
+            previous = current.time;
+        }
+    };
+
+    if(profile.reported == false) {
+        mark(phase);
+        if(profile.enabled != false) {
+            do_report();
+        }
+        profile.phases.clear();
+        profile.phases.shrink_to_fit();
+        profile.reported = true;
+    }
+}
+
+}
+
 // ---------------------------------------------------------------------------
 // <anonymous>::AudioTraits
 // ---------------------------------------------------------------------------
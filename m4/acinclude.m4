@@ -86,6 +86,8 @@ AC_CHECK_HEADERS([windows.h])
 AC_CHECK_HEADERS([winioctl.h])
 AC_CHECK_HEADERS([sys/ipc.h])
 AC_CHECK_HEADERS([sys/shm.h])
+AC_CHECK_HEADERS([sys/mman.h])
+AC_CHECK_HEADERS([sys/file.h])
 ])
 
 # ----------------------------------------------------------------------------
@@ -97,6 +99,7 @@ AC_CHECK_FUNCS([strerror])
 AC_CHECK_FUNCS([mkstemp])
 AC_CHECK_FUNCS([fork])
 AC_CHECK_FUNCS([GetTempFileName])
+AC_CHECK_FUNCS([memfd_create])
 ])
 
 # ----------------------------------------------------------------------------
@@ -165,6 +168,17 @@ else
 fi
 ])
 
+# ----------------------------------------------------------------------------
+# AX_CHECK_DIRTY_TRACKING
+# ----------------------------------------------------------------------------
+
+AC_DEFUN([AX_CHECK_DIRTY_TRACKING], [
+AC_ARG_ENABLE([dirty-tracking], [AS_HELP_STRING([--enable-dirty-tracking], [track the ram pages written by the cpu [default=no]])], [], [enable_dirty_tracking='no'])
+if test "x${enable_dirty_tracking}" = 'xyes'; then
+    AC_DEFINE([ENABLE_DIRTY_TRACKING], [1], [Define to 1 if you want to track the ram pages written by the cpu.])
+fi
+])
+
 # ----------------------------------------------------------------------------
 # AX_DEFINES
 # ----------------------------------------------------------------------------
@@ -80,6 +80,21 @@ struct EmulatorOGLTraits
             ::gtk_emulator_ogl_set_joystick_emulation(emulator, enabled ? TRUE : FALSE);
         }
     }
+
+    static auto get_frame_clock(EmulatorOGL& emulator) -> bool
+    {
+        if(emulator) {
+            return ::gtk_emulator_ogl_get_frame_clock(emulator);
+        }
+        return false;
+    }
+
+    static auto set_frame_clock(EmulatorOGL& emulator, bool enabled) -> void
+    {
+        if(emulator) {
+            ::gtk_emulator_ogl_set_frame_clock(emulator, enabled ? TRUE : FALSE);
+        }
+    }
 };
 
 }
@@ -143,6 +158,16 @@ auto EmulatorOGL::set_joystick_emulation(bool enabled) -> void
     return traits::set_joystick_emulation(*this, enabled);
 }
 
+auto EmulatorOGL::get_frame_clock() -> bool
+{
+    return traits::get_frame_clock(*this);
+}
+
+auto EmulatorOGL::set_frame_clock(bool enabled) -> void
+{
+    return traits::set_frame_clock(*this, enabled);
+}
+
 auto EmulatorOGL::add_hotkey_callback(GCallback callback, void* data) -> void
 {
     return signal_connect(sig_hotkey, callback, data);
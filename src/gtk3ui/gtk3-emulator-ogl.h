@@ -60,6 +60,10 @@ public: // public interface
 
     auto set_joystick_emulation(bool enabled) -> void;
 
+    auto get_frame_clock() -> bool;
+
+    auto set_frame_clock(bool enabled) -> void;
+
     auto add_hotkey_callback(GCallback callback, void* data) -> void;
 };
 
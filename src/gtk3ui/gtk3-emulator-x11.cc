@@ -80,6 +80,21 @@ struct EmulatorX11Traits
             ::gtk_emulator_x11_set_joystick_emulation(emulator, enabled ? TRUE : FALSE);
         }
     }
+
+    static auto get_frame_clock(EmulatorX11& emulator) -> bool
+    {
+        if(emulator) {
+            return ::gtk_emulator_x11_get_frame_clock(emulator);
+        }
+        return false;
+    }
+
+    static auto set_frame_clock(EmulatorX11& emulator, bool enabled) -> void
+    {
+        if(emulator) {
+            ::gtk_emulator_x11_set_frame_clock(emulator, enabled ? TRUE : FALSE);
+        }
+    }
 };
 
 }
@@ -143,6 +158,16 @@ auto EmulatorX11::set_joystick_emulation(bool enabled) -> void
     return traits::set_joystick_emulation(*this, enabled);
 }
 
+auto EmulatorX11::get_frame_clock() -> bool
+{
+    return traits::get_frame_clock(*this);
+}
+
+auto EmulatorX11::set_frame_clock(bool enabled) -> void
+{
+    return traits::set_frame_clock(*this, enabled);
+}
+
 auto EmulatorX11::add_hotkey_callback(GCallback callback, void* data) -> void
 {
     return signal_connect(sig_hotkey, callback, data);
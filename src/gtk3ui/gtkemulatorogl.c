@@ -73,6 +73,47 @@ static gboolean timeout_handler(GtkWidget* widget)
     return G_SOURCE_REMOVE;
 }
 
+static gboolean tick_handler(GtkWidget* widget, GdkFrameClock* frame_clock, gpointer data)
+{
+    GtkEmulatorOGL* self       = GTK_EMULATOR_OGL(widget);
+    const gint64    frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+    const gint64    tick_time  = g_get_monotonic_time();
+    unsigned long   timeout    = 0UL;
+    int             steps      = 0;
+
+    /* make GL context current */ {
+        gtk_gl_area_make_current(GTK_GL_AREA(widget));
+    }
+    /* call on_clock while the emulation is behind the frame time */ {
+        while((frame_time >= self->tick_deadline) && (steps < EMULATOR_TURBO_STEPS)) {
+            GemBackend* backend = &self->backend;
+            GemEvent    closure;
+            closure.u.any.x11_event = gem_events_ogl_copy_or_fill(widget, &self->events, NULL);
+            timeout = (*backend->on_clock)(backend->instance, &closure);
+            self->tick_deadline += (gint64) (timeout * 1000UL);
+            ++steps;
+            /* a null timeout asks for full speed (turbo), keep stepping within the tick budget */
+            if((steps >= EMULATOR_MAXIMUM_STEPS) && ((timeout != 0UL) || ((g_get_monotonic_time() - tick_time) >= EMULATOR_TURBO_BUDGET))) {
+                break;
+            }
+        }
+    }
+    /* resync the deadline only when more than the maximum steps behind */ {
+        if(frame_time >= self->tick_deadline) {
+            self->tick_deadline = frame_time + (gint64) (timeout * 1000UL);
+        }
+    }
+    /* process throttled input event */ {
+        (void) gem_events_ogl_process(widget, &self->events);
+    }
+    /* queue a redraw */ {
+        if(steps != 0) {
+            gtk_gl_area_queue_render(GTK_GL_AREA(widget));
+        }
+    }
+    return G_SOURCE_CONTINUE;
+}
+
 static void reschedule(GtkWidget* widget, unsigned long timeout)
 {
     GtkEmulatorOGL* self = GTK_EMULATOR_OGL(widget);
@@ -80,6 +121,16 @@ static void reschedule(GtkWidget* widget, unsigned long timeout)
     if(self->timeout_id != 0) {
         self->timeout_id = ((void) g_source_remove(self->timeout_id), 0U);
     }
+    if(self->frame_clock != FALSE) {
+        self->tick_deadline = g_get_monotonic_time() + (gint64) (timeout * 1000UL);
+        if(self->tick_id == 0) {
+            self->tick_id = gtk_widget_add_tick_callback(widget, &tick_handler, NULL, NULL);
+        }
+        return;
+    }
+    if(self->tick_id != 0) {
+        self->tick_id = ((void) gtk_widget_remove_tick_callback(widget, self->tick_id), 0U);
+    }
     if(self->timeout_id == 0) {
         self->timeout_id = g_timeout_add(timeout, G_SOURCE_FUNC(&timeout_handler), self);
     }
@@ -92,6 +143,9 @@ static void unschedule(GtkWidget* widget)
     if(self->timeout_id != 0) {
         self->timeout_id = ((void) g_source_remove(self->timeout_id), 0U);
     }
+    if(self->tick_id != 0) {
+        self->tick_id = ((void) gtk_widget_remove_tick_callback(widget, self->tick_id), 0U);
+    }
 }
 
 static void impl_widget_destroy(GtkWidget* widget)
@@ -436,6 +490,11 @@ static void gtk_emulator_ogl_init(GtkEmulatorOGL* self)
     /* initialize timeout */ {
         self->timeout_id = 0;
     }
+    /* initialize frame clock */ {
+        self->tick_id       = 0;
+        self->tick_deadline = 0;
+        self->frame_clock   = FALSE;
+    }
     /* construct video */ {
         (void) gem_video_ogl_construct(widget, &self->video);
     }
@@ -521,6 +580,27 @@ void gtk_emulator_ogl_set_joystick_emulation(GtkWidget* widget, gboolean enabled
     }
 }
 
+gboolean gtk_emulator_ogl_get_frame_clock(GtkWidget* widget)
+{
+    GtkEmulatorOGL* self = GTK_EMULATOR_OGL(widget);
+
+    return self->frame_clock;
+}
+
+void gtk_emulator_ogl_set_frame_clock(GtkWidget* widget, gboolean enabled)
+{
+    GtkEmulatorOGL* self = GTK_EMULATOR_OGL(widget);
+
+    /* set frame clock */ {
+        self->frame_clock = (enabled != FALSE ? TRUE : FALSE);
+    }
+    /* reschedule if needed */ {
+        if((self->timeout_id != 0) || (self->tick_id != 0)) {
+            reschedule(widget, EMULATOR_DEFAULT_TIMEOUT);
+        }
+    }
+}
+
 GemVideo* gem_video_ogl_construct(GtkWidget* widget, GemVideo* video)
 {
     /* initialize */ {
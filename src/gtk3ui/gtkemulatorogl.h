@@ -45,6 +45,9 @@ struct _GtkEmulatorOGL
     guint       natural_width;
     guint       natural_height;
     guint       timeout_id;
+    guint       tick_id;
+    gint64      tick_deadline;
+    gboolean    frame_clock;
 };
 
 struct _GtkEmulatorOGLClass
@@ -60,6 +63,8 @@ extern void       gtk_emulator_ogl_set_backend            (GtkWidget* widget, co
 extern void       gtk_emulator_ogl_set_joystick           (GtkWidget* widget, int id, const char* device);
 extern gboolean   gtk_emulator_ogl_get_joystick_emulation (GtkWidget* widget);
 extern void       gtk_emulator_ogl_set_joystick_emulation (GtkWidget* widget, gboolean enabled);
+extern gboolean   gtk_emulator_ogl_get_frame_clock         (GtkWidget* widget);
+extern void       gtk_emulator_ogl_set_frame_clock         (GtkWidget* widget, gboolean enabled);
 
 G_END_DECLS
 
@@ -35,6 +35,18 @@ G_BEGIN_DECLS
 #define EMULATOR_DEFAULT_TIMEOUT 100UL
 #endif
 
+#ifndef EMULATOR_MAXIMUM_STEPS
+#define EMULATOR_MAXIMUM_STEPS 4
+#endif
+
+#ifndef EMULATOR_TURBO_STEPS
+#define EMULATOR_TURBO_STEPS 64
+#endif
+
+#ifndef EMULATOR_TURBO_BUDGET
+#define EMULATOR_TURBO_BUDGET 12000
+#endif
+
 #ifndef EMULATOR_MINIMUM_WIDTH
 #define EMULATOR_MINIMUM_WIDTH 320
 #endif
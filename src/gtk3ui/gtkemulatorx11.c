@@ -65,6 +65,39 @@ static gboolean timeout_handler(GtkWidget* widget)
     return G_SOURCE_REMOVE;
 }
 
+static gboolean tick_handler(GtkWidget* widget, GdkFrameClock* frame_clock, gpointer data)
+{
+    GtkEmulatorX11* self       = GTK_EMULATOR_X11(widget);
+    const gint64    frame_time = gdk_frame_clock_get_frame_time(frame_clock);
+    const gint64    tick_time  = g_get_monotonic_time();
+    unsigned long   timeout    = 0UL;
+    int             steps      = 0;
+
+    /* call on_clock while the emulation is behind the frame time */ {
+        while((frame_time >= self->tick_deadline) && (steps < EMULATOR_TURBO_STEPS)) {
+            GemBackend* backend = &self->backend;
+            GemEvent    closure;
+            closure.u.any.x11_event = gem_events_x11_copy_or_fill(widget, &self->events, NULL);
+            timeout = (*backend->on_clock)(backend->instance, &closure);
+            self->tick_deadline += (gint64) (timeout * 1000UL);
+            ++steps;
+            /* a null timeout asks for full speed (turbo), keep stepping within the tick budget */
+            if((steps >= EMULATOR_MAXIMUM_STEPS) && ((timeout != 0UL) || ((g_get_monotonic_time() - tick_time) >= EMULATOR_TURBO_BUDGET))) {
+                break;
+            }
+        }
+    }
+    /* resync the deadline only when more than the maximum steps behind */ {
+        if(frame_time >= self->tick_deadline) {
+            self->tick_deadline = frame_time + (gint64) (timeout * 1000UL);
+        }
+    }
+    /* process throttled input event */ {
+        (void) gem_events_x11_process(widget, &self->events);
+    }
+    return G_SOURCE_CONTINUE;
+}
+
 static void reschedule(GtkWidget* widget, unsigned long timeout)
 {
     GtkEmulatorX11* self = GTK_EMULATOR_X11(widget);
@@ -72,6 +105,16 @@ static void reschedule(GtkWidget* widget, unsigned long timeout)
     if(self->timeout_id != 0) {
         self->timeout_id = ((void) g_source_remove(self->timeout_id), 0U);
     }
+    if(self->frame_clock != FALSE) {
+        self->tick_deadline = g_get_monotonic_time() + (gint64) (timeout * 1000UL);
+        if(self->tick_id == 0) {
+            self->tick_id = gtk_widget_add_tick_callback(widget, &tick_handler, NULL, NULL);
+        }
+        return;
+    }
+    if(self->tick_id != 0) {
+        self->tick_id = ((void) gtk_widget_remove_tick_callback(widget, self->tick_id), 0U);
+    }
     if(self->timeout_id == 0) {
         self->timeout_id = g_timeout_add(timeout, G_SOURCE_FUNC(&timeout_handler), self);
     }
@@ -84,6 +127,9 @@ static void unschedule(GtkWidget* widget)
     if(self->timeout_id != 0) {
         self->timeout_id = ((void) g_source_remove(self->timeout_id), 0U);
     }
+    if(self->tick_id != 0) {
+        self->tick_id = ((void) gtk_widget_remove_tick_callback(widget, self->tick_id), 0U);
+    }
 }
 
 static void impl_widget_destroy(GtkWidget* widget)
@@ -114,6 +160,21 @@ static void impl_widget_destroy(GtkWidget* widget)
     }
 }
 
+static GdkFilterReturn impl_window_filter(GdkXEvent* gdk_xevent, GdkEvent* gdk_event, gpointer data)
+{
+    GtkWidget*      widget    = GTK_WIDGET(data);
+    GtkEmulatorX11* self      = GTK_EMULATOR_X11(widget);
+    XEvent*         x11_event = ((XEvent*)(gdk_xevent));
+
+    /* extension events (i.e. MIT-SHM completion) are unknown to gdk */ {
+        if(x11_event->type >= LASTEvent) {
+            (void) gem_events_x11_dispatch(widget, &self->events, x11_event);
+            return GDK_FILTER_REMOVE;
+        }
+    }
+    return GDK_FILTER_CONTINUE;
+}
+
 static void impl_widget_realize(GtkWidget* widget)
 {
     GtkEmulatorX11* self = GTK_EMULATOR_X11(widget);
@@ -153,6 +214,7 @@ static void impl_widget_realize(GtkWidget* widget)
         GdkWindow* window = gdk_window_new(gtk_widget_get_parent_window(widget), &attributes, attributes_mask);
         gtk_widget_register_window(widget, window);
         gtk_widget_set_window(widget, window);
+        gdk_window_add_filter(window, &impl_window_filter, widget);
     }
     /* realize video */ {
         (void) gem_video_x11_realize(widget, &self->video);
@@ -169,6 +231,9 @@ static void impl_widget_unrealize(GtkWidget* widget)
     /* unrealize video */ {
         (void) gem_video_x11_unrealize(widget, &self->video);
     }
+    /* remove window filter */ {
+        gdk_window_remove_filter(gtk_widget_get_window(widget), &impl_window_filter, widget);
+    }
     /* call superclass method */ {
         GTK_WIDGET_CLASS(gtk_emulator_x11_parent_class)->unrealize(widget);
     }
@@ -443,6 +508,11 @@ static void gtk_emulator_x11_init(GtkEmulatorX11* self)
     /* initialize timeout */ {
         self->timeout_id = 0;
     }
+    /* initialize frame clock */ {
+        self->tick_id       = 0;
+        self->tick_deadline = 0;
+        self->frame_clock   = FALSE;
+    }
     /* construct video */ {
         (void) gem_video_x11_construct(widget, &self->video);
     }
@@ -525,6 +595,27 @@ void gtk_emulator_x11_set_joystick_emulation(GtkWidget* widget, gboolean enabled
     }
 }
 
+gboolean gtk_emulator_x11_get_frame_clock(GtkWidget* widget)
+{
+    GtkEmulatorX11* self = GTK_EMULATOR_X11(widget);
+
+    return self->frame_clock;
+}
+
+void gtk_emulator_x11_set_frame_clock(GtkWidget* widget, gboolean enabled)
+{
+    GtkEmulatorX11* self = GTK_EMULATOR_X11(widget);
+
+    /* set frame clock */ {
+        self->frame_clock = (enabled != FALSE ? TRUE : FALSE);
+    }
+    /* reschedule if needed */ {
+        if((self->timeout_id != 0) || (self->tick_id != 0)) {
+            reschedule(widget, EMULATOR_DEFAULT_TIMEOUT);
+        }
+    }
+}
+
 GemVideo* gem_video_x11_construct(GtkWidget* widget, GemVideo* video)
 {
     /* initialize */ {
@@ -671,6 +762,9 @@ GemEvents* gem_events_x11_dispatch(GtkWidget* widget, GemEvents* events, XEvent*
                 }
                 break;
             default:
+                if(x11_event->type >= LASTEvent) {
+                    (void) (*backend->on_expose_window)(backend->instance, &closure);
+                }
                 break;
         }
     }
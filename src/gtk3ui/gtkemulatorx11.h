@@ -45,6 +45,9 @@ struct _GtkEmulatorX11
     guint       natural_width;
     guint       natural_height;
     guint       timeout_id;
+    guint       tick_id;
+    gint64      tick_deadline;
+    gboolean    frame_clock;
 };
 
 struct _GtkEmulatorX11Class
@@ -60,6 +63,8 @@ extern void       gtk_emulator_x11_set_backend            (GtkWidget* widget, co
 extern void       gtk_emulator_x11_set_joystick           (GtkWidget* widget, int id, const char* device);
 extern gboolean   gtk_emulator_x11_get_joystick_emulation (GtkWidget* widget);
 extern void       gtk_emulator_x11_set_joystick_emulation (GtkWidget* widget, gboolean enabled);
+extern gboolean   gtk_emulator_x11_get_frame_clock         (GtkWidget* widget);
+extern void       gtk_emulator_x11_set_frame_clock         (GtkWidget* widget, gboolean enabled);
 
 G_END_DECLS
 
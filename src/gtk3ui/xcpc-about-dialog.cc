@@ -30,6 +30,8 @@
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 #include "xcpc-about-dialog.h"
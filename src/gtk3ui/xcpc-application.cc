@@ -30,6 +30,8 @@
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 #include <epoxy/gl.h>
@@ -2365,6 +2367,16 @@ auto WorkWnd::set_joystick(int id, const std::string& device) -> void
     }
 }
 
+auto WorkWnd::set_frame_clock(bool enabled) -> void
+{
+    if(_emulator_x11 != false) {
+        _emulator_x11.set_frame_clock(enabled);
+    }
+    if(_emulator_ogl != false) {
+        _emulator_ogl.set_frame_clock(enabled);
+    }
+}
+
 }
 
 // ---------------------------------------------------------------------------
@@ -2519,6 +2531,7 @@ Application::Application(int& argc, char**& argv)
     , _app_icon(nullptr)
     , _app_window(*this)
     , _timer(0)
+    , _snapshot()
 {
 }
 
@@ -2834,28 +2847,51 @@ auto Application::on_startup() -> void
         _app_window.build();
     };
 
+    auto get_upscaler = [&](const std::string& upscaler) -> int
+    {
+        if(upscaler == "scale2x") {
+            return 1;
+        }
+        if(upscaler == "scale3x") {
+            return 2;
+        }
+        if(upscaler == "scale4x") {
+            return 3;
+        }
+        if(upscaler == "xbr2x") {
+            return 4;
+        }
+        return 0;
+    };
+
     auto apply_settings = [&]() -> void
     {
-        set_parameterf("video.ogl.u_hsampling" , _globals.video.u_hsampling );
-        set_parameterf("video.ogl.u_vsampling" , _globals.video.u_vsampling );
-        set_parameterf("video.ogl.u_curvature" , _globals.video.u_curvature );
-        set_parameterf("video.ogl.u_corner"    , _globals.video.u_corner    );
-        set_parameterf("video.ogl.u_dotline"   , _globals.video.u_dotline   );
-        set_parameterf("video.ogl.u_dotmask"   , _globals.video.u_dotmask   );
-        set_parameterf("video.ogl.u_vignetting", _globals.video.u_vignetting);
-        set_parameterf("video.ogl.u_brightness", _globals.video.u_brightness);
+        set_parameterb("video.ogl.frame_blending", _globals.video.frame_blending);
+        set_parameteri("video.upscaler", get_upscaler(_globals.video.upscaler));
+        set_parameterf("video.u_hsampling" , _globals.video.u_hsampling );
+        set_parameterf("video.u_vsampling" , _globals.video.u_vsampling );
+        set_parameterf("video.u_curvature" , _globals.video.u_curvature );
+        set_parameterf("video.u_corner"    , _globals.video.u_corner    );
+        set_parameterf("video.u_dotline"   , _globals.video.u_dotline   );
+        set_parameterf("video.u_dotmask"   , _globals.video.u_dotmask   );
+        set_parameterf("video.u_vignetting", _globals.video.u_vignetting);
+        set_parameterf("video.u_brightness", _globals.video.u_brightness);
         set_volume(_globals.audio.volume);
         set_joystick_emulation(_globals.input.joystick_emulation);
+        work_wnd().set_frame_clock(_globals.video.frame_clock);
     };
 
     auto do_startup = [&]() -> void
     {
         check_ximage();
         check_opengl();
+        StartupProfile::mark("frontend: probe renderers");
         create_app_icon(Utils::get_datdir(), "pixmaps", "xcpc.png");
         create_main_window();
+        StartupProfile::mark("frontend: build main window");
         apply_settings();
         start_timer();
+        StartupProfile::mark("frontend: apply settings");
     };
 
     return do_startup();
@@ -2885,6 +2921,7 @@ auto Application::on_shutdown() -> void
 
 auto Application::on_statistics() -> void
 {
+    update_snapshot();
     update_stats();
 }
 
@@ -3134,14 +3171,14 @@ auto Application::on_video_settings() -> void
 
     run_dialog(dialog);
 
-    set_parameterf("video.ogl.u_hsampling" , _globals.video.u_hsampling );
-    set_parameterf("video.ogl.u_vsampling" , _globals.video.u_vsampling );
-    set_parameterf("video.ogl.u_curvature" , _globals.video.u_curvature );
-    set_parameterf("video.ogl.u_corner"    , _globals.video.u_corner    );
-    set_parameterf("video.ogl.u_dotline"   , _globals.video.u_dotline   );
-    set_parameterf("video.ogl.u_dotmask"   , _globals.video.u_dotmask   );
-    set_parameterf("video.ogl.u_vignetting", _globals.video.u_vignetting);
-    set_parameterf("video.ogl.u_brightness", _globals.video.u_brightness);
+    set_parameterf("video.u_hsampling" , _globals.video.u_hsampling );
+    set_parameterf("video.u_vsampling" , _globals.video.u_vsampling );
+    set_parameterf("video.u_curvature" , _globals.video.u_curvature );
+    set_parameterf("video.u_corner"    , _globals.video.u_corner    );
+    set_parameterf("video.u_dotline"   , _globals.video.u_dotline   );
+    set_parameterf("video.u_dotmask"   , _globals.video.u_dotmask   );
+    set_parameterf("video.u_vignetting", _globals.video.u_vignetting);
+    set_parameterf("video.u_brightness", _globals.video.u_brightness);
     update_all();
 }
 
@@ -3407,7 +3444,42 @@ auto Application::update_stats() -> void
 {
     auto do_update = [&]() -> void
     {
-        info_bar().set_stats(_machine->get_statistics());
+        std::string stats(_machine->get_statistics());
+        if(_snapshot.pending != 0) {
+            stats += ' ';
+            stats += '-';
+            stats += ' ';
+            stats += _("Saving snapshot...");
+        }
+        info_bar().set_stats(stats);
+    };
+
+    return do_update();
+}
+
+auto Application::update_snapshot() -> void
+{
+    const cpc::SnapshotProgress progress(_machine->get_snapshot_progress());
+
+    auto report_saved = [&]() -> void
+    {
+        if(progress.saved != _snapshot.saved) {
+            ::xcpc_log_print("snapshot saved <%s>", progress.filename.c_str());
+        }
+    };
+
+    auto report_failed = [&]() -> void
+    {
+        if(progress.failed != _snapshot.failed) {
+            ::xcpc_log_error("save-snapshot has failed (%s)", progress.error.c_str());
+        }
+    };
+
+    auto do_update = [&]() -> void
+    {
+        report_saved();
+        report_failed();
+        _snapshot = progress;
     };
 
     return do_update();
@@ -3431,6 +3503,7 @@ auto Application::update_all() -> void
     update_drive1();
     update_system();
     update_volume();
+    update_snapshot();
     update_stats();
     update_input();
 }
@@ -664,6 +664,8 @@ public: // public interface
 
     auto set_joystick(int id, const std::string& device) -> void;
 
+    auto set_frame_clock(bool enabled) -> void;
+
 private: // private data
     gtk3::HBox&       _self;
     gtk3::Viewport    _viewport;
@@ -883,9 +885,9 @@ public: // public methods
 
     virtual auto set_joystick_emulation(const bool enabled) -> void override final;
 
-    virtual auto set_joystick0(const std::string& device) -> void override final;
+    auto set_joystick0(const std::string& device) -> void;
 
-    virtual auto set_joystick1(const std::string& device) -> void override final;
+    auto set_joystick1(const std::string& device) -> void;
 
 public: // public signals
     virtual auto on_open(GFile** files, int num_files) -> void override final;
@@ -966,25 +968,25 @@ public: // public signals
 
     virtual auto on_volume_decrease() -> void override final;
 
-    virtual auto on_audio_settings() -> void override final;
+    auto on_audio_settings() -> void;
 
-    virtual auto on_renderer_ximage() -> void override final;
+    auto on_renderer_ximage() -> void;
 
-    virtual auto on_renderer_opengl() -> void override final;
+    auto on_renderer_opengl() -> void;
 
     virtual auto on_crt_emulation_enable() -> void override final;
 
     virtual auto on_crt_emulation_disable() -> void override final;
 
-    virtual auto on_video_settings() -> void override final;
+    auto on_video_settings() -> void;
 
-    virtual auto on_joystick0_connect() -> void override final;
+    auto on_joystick0_connect() -> void;
 
-    virtual auto on_joystick0_disconnect() -> void override final;
+    auto on_joystick0_disconnect() -> void;
 
-    virtual auto on_joystick1_connect() -> void override final;
+    auto on_joystick1_connect() -> void;
 
-    virtual auto on_joystick1_disconnect() -> void override final;
+    auto on_joystick1_disconnect() -> void;
 
     virtual auto on_joystick_emulation_enable() -> void override final;
 
@@ -1027,16 +1029,19 @@ private: // private interface
 
     auto update_stats() -> void;
 
+    auto update_snapshot() -> void;
+
     auto update_input() -> void;
 
     auto update_all() -> void;
 
 private: // private data
-    std::string     _app_title;
-    std::string     _app_state;
-    gdk3::Pixbuf    _app_icon;
-    impl::AppWindow _app_window;
-    guint           _timer;
+    std::string           _app_title;
+    std::string           _app_state;
+    gdk3::Pixbuf          _app_icon;
+    impl::AppWindow       _app_window;
+    guint                 _timer;
+    cpc::SnapshotProgress _snapshot;
 };
 
 }
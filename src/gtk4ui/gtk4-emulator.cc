@@ -0,0 +1,586 @@
+/*
+ * gtk4-emulator.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include "gtk4-emulator.h"
+
+// ---------------------------------------------------------------------------
+// gtk4::Emulator::Callbacks
+// ---------------------------------------------------------------------------
+
+namespace gtk4 {
+
+struct Emulator::Callbacks
+{
+    static auto on_realize(GtkWidget* widget, Emulator* emulator) -> void
+    {
+        if(emulator != nullptr) {
+            emulator->realize();
+        }
+    }
+
+    static auto on_unrealize(GtkWidget* widget, Emulator* emulator) -> void
+    {
+        if(emulator != nullptr) {
+            emulator->unrealize();
+        }
+    }
+
+    static auto on_destroy(GtkWidget* widget, Emulator* emulator) -> void
+    {
+        if(emulator != nullptr) {
+            emulator->_widget = nullptr;
+        }
+    }
+
+    static auto on_render(GtkGLArea* area, GdkGLContext* context, Emulator* emulator) -> gboolean
+    {
+        if(emulator != nullptr) {
+            emulator->render();
+        }
+        return TRUE;
+    }
+
+    static auto on_resize(GtkGLArea* area, int width, int height, Emulator* emulator) -> void
+    {
+        if(emulator != nullptr) {
+            emulator->resize(width, height);
+        }
+    }
+
+    static auto on_tick(GtkWidget* widget, GdkFrameClock* frame_clock, gpointer data) -> gboolean
+    {
+        Emulator* emulator = reinterpret_cast<Emulator*>(data);
+
+        if(emulator != nullptr) {
+            emulator->tick(frame_clock);
+        }
+        return G_SOURCE_CONTINUE;
+    }
+
+    static auto on_key_pressed(GtkEventControllerKey* controller, guint keyval, guint keycode, GdkModifierType state, Emulator* emulator) -> gboolean
+    {
+        if(emulator != nullptr) {
+            return (emulator->key_event(KeyPress, keyval, state) != false ? TRUE : FALSE);
+        }
+        return FALSE;
+    }
+
+    static auto on_key_released(GtkEventControllerKey* controller, guint keyval, guint keycode, GdkModifierType state, Emulator* emulator) -> void
+    {
+        if(emulator != nullptr) {
+            static_cast<void>(emulator->key_event(KeyRelease, keyval, state));
+        }
+    }
+
+    static auto on_click_pressed(GtkGestureClick* gesture, int n_press, double x, double y, Emulator* emulator) -> void
+    {
+        if(emulator != nullptr) {
+            emulator->grab_focus();
+        }
+    }
+
+    static auto on_drop(GtkDropTarget* target, const GValue* value, double x, double y, Emulator* emulator) -> gboolean
+    {
+        if((emulator != nullptr) && (G_VALUE_HOLDS(value, GDK_TYPE_FILE_LIST))) {
+            GdkFileList* list  = reinterpret_cast<GdkFileList*>(::g_value_get_boxed(value));
+            GSList*      files = ::gdk_file_list_get_files(list);
+            for(GSList* iter = files; iter != nullptr; iter = iter->next) {
+                char* path = ::g_file_get_path(G_FILE(iter->data));
+                if(path != nullptr) {
+                    emulator->_listener.on_drop_file(path);
+                    path = (::g_free(path), nullptr);
+                }
+            }
+            files = (::g_slist_free(files), nullptr);
+            return TRUE;
+        }
+        return FALSE;
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// gtk4::Emulator
+// ---------------------------------------------------------------------------
+
+namespace gtk4 {
+
+Emulator::Emulator(EmulatorListener& listener)
+    : _listener(listener)
+    , _backend()
+    , _widget(nullptr)
+    , _tick_id(0)
+    , _deadline(0)
+    , _realized(false)
+    , _keyboard()
+    , _events()
+{
+}
+
+Emulator::~Emulator()
+{
+    if(_widget != nullptr) {
+        if(_tick_id != 0) {
+            _tick_id = (::gtk_widget_remove_tick_callback(_widget, _tick_id), 0U);
+        }
+        static_cast<void>(::g_signal_handlers_disconnect_by_data(_widget, this));
+        _widget = nullptr;
+    }
+}
+
+auto Emulator::create(const XcpcBackend* backend) -> GtkWidget*
+{
+    auto create_area = [&]() -> void
+    {
+        GtkGLArea* area = nullptr;
+
+        if(_widget == nullptr) {
+            _widget = ::gtk_gl_area_new();
+            area = GTK_GL_AREA(_widget);
+            ::gtk_gl_area_set_required_version(area, 3, 3);
+#if GTK_CHECK_VERSION(4,12,0)
+            ::gtk_gl_area_set_allowed_apis(area, GDK_GL_API_GL);
+#endif
+            ::gtk_gl_area_set_auto_render(area, FALSE);
+            ::gtk_gl_area_set_has_depth_buffer(area, FALSE);
+            ::gtk_gl_area_set_has_stencil_buffer(area, FALSE);
+            ::gtk_widget_set_focusable(_widget, TRUE);
+            ::gtk_widget_set_hexpand(_widget, TRUE);
+            ::gtk_widget_set_vexpand(_widget, TRUE);
+            ::gtk_widget_set_size_request(_widget, MINIMUM_WIDTH, MINIMUM_HEIGHT);
+        }
+    };
+
+    auto set_backend = [&]() -> void
+    {
+        if(backend != nullptr) {
+            _backend = *backend;
+        }
+    };
+
+    auto connect_signals = [&]() -> void
+    {
+        static_cast<void>(::g_signal_connect(G_OBJECT(_widget), "realize", G_CALLBACK(&Callbacks::on_realize), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(_widget), "unrealize", G_CALLBACK(&Callbacks::on_unrealize), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(_widget), "destroy", G_CALLBACK(&Callbacks::on_destroy), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(_widget), "render", G_CALLBACK(&Callbacks::on_render), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(_widget), "resize", G_CALLBACK(&Callbacks::on_resize), this));
+    };
+
+    auto add_controllers = [&]() -> void
+    {
+        GtkEventController* keyboard = ::gtk_event_controller_key_new();
+        GtkGesture*         click    = ::gtk_gesture_click_new();
+        GtkDropTarget*      drop     = ::gtk_drop_target_new(GDK_TYPE_FILE_LIST, GDK_ACTION_COPY);
+
+        static_cast<void>(::g_signal_connect(G_OBJECT(keyboard), "key-pressed", G_CALLBACK(&Callbacks::on_key_pressed), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(keyboard), "key-released", G_CALLBACK(&Callbacks::on_key_released), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(click), "pressed", G_CALLBACK(&Callbacks::on_click_pressed), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(drop), "drop", G_CALLBACK(&Callbacks::on_drop), this));
+        ::gtk_widget_add_controller(_widget, keyboard);
+        ::gtk_widget_add_controller(_widget, GTK_EVENT_CONTROLLER(click));
+        ::gtk_widget_add_controller(_widget, GTK_EVENT_CONTROLLER(drop));
+    };
+
+    auto do_create = [&]() -> GtkWidget*
+    {
+        if(_widget == nullptr) {
+            create_area();
+            set_backend();
+            connect_signals();
+            add_controllers();
+        }
+        return _widget;
+    };
+
+    return do_create();
+}
+
+auto Emulator::grab_focus() -> void
+{
+    if(_widget != nullptr) {
+        if(::gtk_widget_has_focus(_widget) == FALSE) {
+            static_cast<void>(::gtk_widget_grab_focus(_widget));
+        }
+    }
+}
+
+auto Emulator::get_joystick_emulation() const -> bool
+{
+    return _keyboard.js_enabled;
+}
+
+auto Emulator::set_joystick_emulation(bool enabled) -> void
+{
+    if(_keyboard.js_enabled != enabled) {
+        _keyboard.js_enabled = enabled;
+        _keyboard.js_axis_x  = 0;
+        _keyboard.js_axis_y  = 0;
+        _keyboard.js_button0 = 0;
+        _keyboard.js_button1 = 0;
+    }
+}
+
+auto Emulator::realize() -> void
+{
+    GtkGLArea* area = GTK_GL_AREA(_widget);
+
+    /* make GL context current */ {
+        ::gtk_gl_area_make_current(area);
+        if(::gtk_gl_area_get_error(area) != nullptr) {
+            ::xcpc_log_error("unable to create the OpenGL context (%s)", ::gtk_gl_area_get_error(area)->message);
+            return;
+        }
+    }
+    /* call on_create_window */ {
+        XEvent    x11_event = forge(CreateNotify);
+        XcpcEvent closure;
+        closure.u.any.x11_event = &x11_event;
+        if(_backend.on_create_window != nullptr) {
+            static_cast<void>((*_backend.on_create_window)(_backend.instance, &closure));
+        }
+        _realized = true;
+    }
+    /* start the frame-clock driven emulation */ {
+        _deadline = ::g_get_monotonic_time() + (DEFAULT_TIMEOUT * 1000);
+        if(_tick_id == 0) {
+            _tick_id = ::gtk_widget_add_tick_callback(_widget, &Callbacks::on_tick, this, nullptr);
+        }
+    }
+}
+
+auto Emulator::unrealize() -> void
+{
+    /* stop the frame-clock driven emulation */ {
+        if(_tick_id != 0) {
+            _tick_id = (::gtk_widget_remove_tick_callback(_widget, _tick_id), 0U);
+        }
+    }
+    /* call on_delete_window with the GL context current */ {
+        if(_realized != false) {
+            XEvent    x11_event = forge(DestroyNotify);
+            XcpcEvent closure;
+            closure.u.any.x11_event = &x11_event;
+            ::gtk_gl_area_make_current(GTK_GL_AREA(_widget));
+            if(_backend.on_delete_window != nullptr) {
+                static_cast<void>((*_backend.on_delete_window)(_backend.instance, &closure));
+            }
+            _realized = false;
+        }
+    }
+}
+
+auto Emulator::render() -> void
+{
+    if(_realized != false) {
+        XEvent    x11_event = forge(Expose);
+        XcpcEvent closure;
+        x11_event.xexpose.width  = ::gtk_widget_get_width(_widget) * ::gtk_widget_get_scale_factor(_widget);
+        x11_event.xexpose.height = ::gtk_widget_get_height(_widget) * ::gtk_widget_get_scale_factor(_widget);
+        closure.u.any.x11_event = &x11_event;
+        if(_backend.on_expose_window != nullptr) {
+            static_cast<void>((*_backend.on_expose_window)(_backend.instance, &closure));
+        }
+    }
+}
+
+auto Emulator::resize(int width, int height) -> void
+{
+    if(_realized != false) {
+        XEvent    x11_event = forge(ConfigureNotify);
+        XcpcEvent closure;
+        x11_event.xconfigure.width  = width;
+        x11_event.xconfigure.height = height;
+        closure.u.any.x11_event = &x11_event;
+        if(_backend.on_resize_window != nullptr) {
+            static_cast<void>((*_backend.on_resize_window)(_backend.instance, &closure));
+        }
+    }
+}
+
+auto Emulator::tick(GdkFrameClock* frame_clock) -> void
+{
+    const gint64  frame_time = ::gdk_frame_clock_get_frame_time(frame_clock);
+    const gint64  tick_time  = ::g_get_monotonic_time();
+    unsigned long timeout    = 0UL;
+    int           steps      = 0;
+
+    if(_realized == false) {
+        return;
+    }
+    /* make GL context current */ {
+        ::gtk_gl_area_make_current(GTK_GL_AREA(_widget));
+    }
+    /* call on_clock while the emulation is behind the frame time */ {
+        while((frame_time >= _deadline) && (steps < TURBO_STEPS)) {
+            XEvent    x11_event = forge(GenericEvent);
+            XcpcEvent closure;
+            closure.u.any.x11_event = &x11_event;
+            if(_backend.on_clock != nullptr) {
+                timeout = (*_backend.on_clock)(_backend.instance, &closure);
+            }
+            _deadline += static_cast<gint64>(timeout * 1000UL);
+            ++steps;
+            /* a null timeout asks for full speed (turbo), keep stepping within the tick budget */
+            if((steps >= MAXIMUM_STEPS) && ((timeout != 0UL) || ((::g_get_monotonic_time() - tick_time) >= TURBO_BUDGET))) {
+                break;
+            }
+        }
+    }
+    /* resync the deadline only when more than the maximum steps behind */ {
+        if(frame_time >= _deadline) {
+            _deadline = frame_time + static_cast<gint64>(timeout * 1000UL);
+        }
+    }
+    /* process throttled input event */ {
+        process();
+    }
+    /* queue a redraw */ {
+        if(steps != 0) {
+            ::gtk_gl_area_queue_render(GTK_GL_AREA(_widget));
+        }
+    }
+}
+
+auto Emulator::key_event(int type, guint keyval, GdkModifierType state) -> bool
+{
+    XEvent x11_event = forge(type);
+
+    /* gdk keyvals are x11 keysyms, they are carried in place of the keycode */ {
+        x11_event.xkey.keycode = keyval;
+        x11_event.xkey.state   = 0;
+    }
+    /* adjust event state */ {
+        if(state & GDK_SHIFT_MASK  ) x11_event.xkey.state |= ShiftMask;
+        if(state & GDK_LOCK_MASK   ) x11_event.xkey.state |= LockMask;
+        if(state & GDK_CONTROL_MASK) x11_event.xkey.state |= ControlMask;
+        if(state & GDK_ALT_MASK    ) x11_event.xkey.state |= Mod1Mask;
+    }
+    /* detect and discard auto-repeat */ {
+        const XEvent& x11_prev(_events.last_key_event);
+        if((type == KeyPress) && (x11_prev.type == KeyPress)) {
+            if(x11_prev.xkey.keycode == x11_event.xkey.keycode) {
+                return true;
+            }
+        }
+        _events.last_key_event = x11_event;
+    }
+    /* preprocess keyboard event */ {
+        if(preprocess(x11_event) != false) {
+            return true;
+        }
+    }
+    /* throttle input event */ {
+        throttle(x11_event);
+    }
+    return true;
+}
+
+auto Emulator::preprocess(const XEvent& event) -> bool
+{
+    const KeySym keysym = static_cast<KeySym>(event.xkey.keycode);
+
+    auto toggle_joystick = [&]() -> bool
+    {
+        set_joystick_emulation(_keyboard.js_enabled == false);
+
+        return true;
+    };
+
+    auto emit_hotkey = [&]() -> bool
+    {
+        _listener.on_hotkey(static_cast<unsigned int>(keysym));
+
+        return true;
+    };
+
+    auto emit_button = [&](int number, int value) -> bool
+    {
+        XEvent x11_event = forge(value != 0 ? ButtonPress : ButtonRelease);
+
+        if(number == 0) {
+            _keyboard.js_button0 = value;
+        }
+        else {
+            _keyboard.js_button1 = value;
+        }
+        x11_event.xbutton.x      = _keyboard.js_axis_x;
+        x11_event.xbutton.y      = _keyboard.js_axis_y;
+        x11_event.xbutton.state  = AnyModifier << (_keyboard.js_id + 1);
+        x11_event.xbutton.button = number;
+        dispatch(x11_event);
+
+        return true;
+    };
+
+    auto emit_motion = [&](int number, int value) -> bool
+    {
+        XEvent x11_event = forge(MotionNotify);
+
+        if(number == 0) {
+            _keyboard.js_axis_x = value;
+        }
+        else {
+            _keyboard.js_axis_y = value;
+        }
+        x11_event.xmotion.x     = _keyboard.js_axis_x;
+        x11_event.xmotion.y     = _keyboard.js_axis_y;
+        x11_event.xmotion.state = AnyModifier << (_keyboard.js_id + 1);
+        dispatch(x11_event);
+
+        return true;
+    };
+
+    auto preprocess_joystick = [&]() -> bool
+    {
+        const bool pressed = (event.type == KeyPress);
+
+        switch(keysym) {
+            case XCPC_KEY_Up:
+                return emit_motion(1, (pressed ? -32767 : 0));
+            case XCPC_KEY_Down:
+                return emit_motion(1, (pressed ? +32767 : 0));
+            case XCPC_KEY_Left:
+                return emit_motion(0, (pressed ? -32767 : 0));
+            case XCPC_KEY_Right:
+                return emit_motion(0, (pressed ? +32767 : 0));
+            case XCPC_KEY_Control_L:
+                return emit_button(0, (pressed ? 1 : 0));
+            case XCPC_KEY_Alt_L:
+                return emit_button(1, (pressed ? 1 : 0));
+            default:
+                break;
+        }
+        return false;
+    };
+
+    if(event.type == KeyPress) {
+        if((keysym == XCPC_KEY_Home) || (keysym == XCPC_KEY_End)) {
+            return toggle_joystick();
+        }
+        if(((keysym >= XCPC_KEY_F1) && (keysym <= XCPC_KEY_F35)) || (keysym == XCPC_KEY_Pause)) {
+            return emit_hotkey();
+        }
+    }
+    if(_keyboard.js_enabled != false) {
+        return preprocess_joystick();
+    }
+    return false;
+}
+
+auto Emulator::dispatch(XEvent& event) -> void
+{
+    XcpcEvent closure;
+
+    auto call = [&](unsigned long (*callback)(void*, XcpcEvent*)) -> void
+    {
+        if(callback != nullptr) {
+            static_cast<void>((*callback)(_backend.instance, &closure));
+        }
+    };
+
+    /* initialize closure */ {
+        closure.u.any.x11_event = &event;
+    }
+    /* dispatch x11_event */ {
+        switch(event.type) {
+            case KeyPress:
+                call(_backend.on_key_press);
+                break;
+            case KeyRelease:
+                call(_backend.on_key_release);
+                break;
+            case ButtonPress:
+                call(_backend.on_button_press);
+                break;
+            case ButtonRelease:
+                call(_backend.on_button_release);
+                break;
+            case MotionNotify:
+                call(_backend.on_motion_notify);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+auto Emulator::throttle(const XEvent& event) -> void
+{
+    const unsigned int head = ((_events.head + 0) % EVENT_COUNT);
+    const unsigned int tail = ((_events.tail + 1) % EVENT_COUNT);
+
+    if(tail != head) {
+        _events.list[_events.tail] = event;
+        _events.head = head;
+        _events.tail = tail;
+    }
+}
+
+auto Emulator::process() -> void
+{
+    int event_type = 0;
+
+    while(_events.head != _events.tail) {
+        XEvent& event(_events.list[_events.head]);
+        if(event_type == 0) {
+            event_type = event.type;
+        }
+        if(event.type == event_type) {
+            dispatch(event);
+            _events.head = ((_events.head + 1) % EVENT_COUNT);
+        }
+        else {
+            break;
+        }
+    }
+}
+
+auto Emulator::forge(int type) const -> XEvent
+{
+    XEvent x11_event;
+
+    /* display-less events, the renderer is driven by the GL area and not by an x11 window */ {
+        ::memset(&x11_event, 0, sizeof(x11_event));
+        x11_event.xany.type       = type;
+        x11_event.xany.serial     = 0UL;
+        x11_event.xany.send_event = True;
+        x11_event.xany.display    = nullptr;
+        x11_event.xany.window     = None;
+    }
+    return x11_event;
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,151 @@
+/*
+ * gtk4-emulator.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_GTK4UI_EMULATOR_H__
+#define __XCPC_GTK4UI_EMULATOR_H__
+
+#include <gtk/gtk.h>
+#include <xcpc/libxcpc.h>
+
+// ---------------------------------------------------------------------------
+// gtk4::EmulatorListener
+// ---------------------------------------------------------------------------
+
+namespace gtk4 {
+
+class EmulatorListener
+{
+public: // public interface
+    EmulatorListener() = default;
+
+    EmulatorListener(const EmulatorListener&) = default;
+
+    EmulatorListener& operator=(const EmulatorListener&) = default;
+
+    virtual ~EmulatorListener() = default;
+
+    virtual auto on_hotkey(unsigned int keysym) -> void = 0;
+
+    virtual auto on_drop_file(const std::string& filename) -> void = 0;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// gtk4::Emulator
+// ---------------------------------------------------------------------------
+
+namespace gtk4 {
+
+class Emulator
+{
+public: // public interface
+    Emulator(EmulatorListener& listener);
+
+    Emulator(Emulator&&) = delete;
+
+    Emulator(const Emulator&) = delete;
+
+    Emulator& operator=(Emulator&&) = delete;
+
+    Emulator& operator=(const Emulator&) = delete;
+
+    virtual ~Emulator();
+
+    auto create(const XcpcBackend* backend) -> GtkWidget*;
+
+    auto grab_focus() -> void;
+
+    auto get_joystick_emulation() const -> bool;
+
+    auto set_joystick_emulation(bool enabled) -> void;
+
+    auto get_widget() const -> GtkWidget*
+    {
+        return _widget;
+    }
+
+public: // public types
+    static constexpr int   MINIMUM_WIDTH   = 320;
+    static constexpr int   MINIMUM_HEIGHT  = 200;
+    static constexpr int   MAXIMUM_STEPS   = 4;
+    static constexpr int   TURBO_STEPS     = 64;
+    static constexpr gint64 TURBO_BUDGET    = 12000;
+    static constexpr int   EVENT_COUNT     = 256;
+    static constexpr gint64 DEFAULT_TIMEOUT = 100;
+
+private: // private types
+    struct Keyboard
+    {
+        bool js_enabled = false;
+        int  js_id      = 0;
+        int  js_axis_x  = 0;
+        int  js_axis_y  = 0;
+        int  js_button0 = 0;
+        int  js_button1 = 0;
+    };
+
+    struct Events
+    {
+        XEvent       last_key_event;
+        XEvent       list[EVENT_COUNT];
+        unsigned int head;
+        unsigned int tail;
+    };
+
+    struct Callbacks;
+
+private: // private interface
+    auto realize() -> void;
+
+    auto unrealize() -> void;
+
+    auto render() -> void;
+
+    auto resize(int width, int height) -> void;
+
+    auto tick(GdkFrameClock* frame_clock) -> void;
+
+    auto key_event(int type, guint keyval, GdkModifierType state) -> bool;
+
+    auto preprocess(const XEvent& event) -> bool;
+
+    auto dispatch(XEvent& event) -> void;
+
+    auto throttle(const XEvent& event) -> void;
+
+    auto process() -> void;
+
+    auto forge(int type) const -> XEvent;
+
+private: // private data
+    EmulatorListener& _listener;
+    XcpcBackend       _backend;
+    GtkWidget*        _widget;
+    guint             _tick_id;
+    gint64            _deadline;
+    bool              _realized;
+    Keyboard          _keyboard;
+    Events            _events;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_GTK4UI_EMULATOR_H__ */
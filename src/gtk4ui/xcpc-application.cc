@@ -0,0 +1,1480 @@
+/*
+ * xcpc-application.cc - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include "xcpc-application.h"
+
+#define NIL ""
+#define EOL "\n"
+
+// ---------------------------------------------------------------------------
+// <anonymous>::traits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct traits
+{
+    static auto has_extension(const char* filename, const char* extension) -> bool
+    {
+        if((filename != nullptr) && (extension != nullptr)) {
+            const int filename_length  = ::strlen(filename);
+            const int extension_length = ::strlen(extension);
+            if(filename_length >= extension_length) {
+                if(::strcasecmp(&filename[filename_length - extension_length], extension) == 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    static const char* snapshot_patterns[];
+
+    static const char* disk_patterns[];
+
+    static const char help_primary[];
+
+    static const char help_secondary[];
+};
+
+const char* traits::snapshot_patterns[] = {
+    "*.sna",
+    nullptr
+};
+
+const char* traits::disk_patterns[] = {
+    "*.dsk",
+    "*.dsk.gz",
+    "*.dsk.bz2",
+    "*.zip",
+    nullptr
+};
+
+const char traits::help_primary[] = ""
+    "Xcpc, an Amstrad CPC emulator for Linux, BSD and Unix" NIL
+    ;
+
+const char traits::help_secondary[] = ""
+    "Hotkeys:"                                                                                EOL
+    ""                                                                                        EOL
+    "    - F1                help"                                                            EOL
+    "    - F2                load snapshot"                                                   EOL
+    "    - F3                save snapshot"                                                   EOL
+    "    - F5                reset emulator"                                                  EOL
+    "    - F6                insert disk into drive A"                                        EOL
+    "    - F7                remove disk from drive A"                                        EOL
+    "    - F8                insert disk into drive B"                                        EOL
+    "    - F9                remove disk from drive B"                                        EOL
+    "    - Pause             pause emulator"                                                  EOL
+    ""                                                                                        EOL
+    "Keyboard emulation:"                                                                     EOL
+    ""                                                                                        EOL
+    "The left shift and control keys are forwarded to the simulation."                        EOL
+    "You must use the right shift and control keys to compose characters."                    EOL
+    ""                                                                                        EOL
+    "Joystick emulation:"                                                                     EOL
+    ""                                                                                        EOL
+    "    - Home/End          enable/disable"                                                  EOL
+    "    - Arrows            up/down/left/right"                                              EOL
+    "    - Left Ctrl         fire1"                                                           EOL
+    "    - Left Alt          fire2"                                                           EOL
+    ""                                                                                        EOL
+    "Drag'n Drop:"                                                                            EOL
+    ""                                                                                        EOL
+    "You can use your file manager to drag'n drop a supported file directly to the emulator." EOL
+    ""                                                                                        EOL
+    "The supported file extensions are: '.dsk', '.dsk.gz', '.dsk.bz2', '.zip', '.sna'"        NIL
+    ;
+
+}
+
+// ---------------------------------------------------------------------------
+// xcpc::Application::Callbacks
+// ---------------------------------------------------------------------------
+
+namespace xcpc {
+
+struct Application::Callbacks
+{
+    struct FileRequest
+    {
+        Application* application;
+        FileCallback callback;
+        bool         save;
+    };
+
+    template <void (Application::*Method)()>
+    static auto activate(GSimpleAction* action, GVariant* parameter, gpointer data) -> void
+    {
+        Application* application = reinterpret_cast<Application*>(data);
+
+        if(application != nullptr) {
+            (application->*Method)();
+        }
+    }
+
+    static auto on_statistics(Application* application) -> gboolean
+    {
+        if(application != nullptr) {
+            application->on_statistics();
+        }
+        return TRUE;
+    }
+
+    static auto on_startup(GApplication* object, Application* application) -> void
+    {
+        if(application != nullptr) {
+            application->on_startup();
+        }
+    }
+
+    static auto on_shutdown(GApplication* object, Application* application) -> void
+    {
+        if(application != nullptr) {
+            application->on_shutdown();
+        }
+    }
+
+    static auto on_activate(GApplication* object, Application* application) -> void
+    {
+        if(application != nullptr) {
+            application->on_activate();
+        }
+    }
+
+    static auto on_open(GApplication* object, GFile** files, int num_files, char* hint, Application* application) -> void
+    {
+        if(application != nullptr) {
+            application->on_open(files, num_files);
+        }
+    }
+
+    static auto on_window_destroy(GtkWidget* widget, Application* application) -> void
+    {
+        if(application != nullptr) {
+            application->_window   = nullptr;
+            application->_info_bar = InfoBar();
+        }
+    }
+
+    static auto on_file_dialog(GObject* object, GAsyncResult* result, gpointer data) -> void
+    {
+        const std::unique_ptr<FileRequest> request(reinterpret_cast<FileRequest*>(data));
+        GtkFileDialog* dialog = GTK_FILE_DIALOG(object);
+        GFile*         file   = nullptr;
+
+        /* finish the dialog, a dismissed dialog yields no file */ {
+            if(request->save != false) {
+                file = ::gtk_file_dialog_save_finish(dialog, result, nullptr);
+            }
+            else {
+                file = ::gtk_file_dialog_open_finish(dialog, result, nullptr);
+            }
+        }
+        /* apply the selected file */ {
+            if(file != nullptr) {
+                char* path = ::g_file_get_path(file);
+                if(path != nullptr) {
+                    (request->application->*(request->callback))(path);
+                    path = (::g_free(path), nullptr);
+                }
+                file = (::g_object_unref(file), nullptr);
+            }
+        }
+        /* resume the emulation paused by run_file_dialog */ {
+            request->application->play_emulator();
+        }
+        ::g_object_unref(dialog);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// xcpc::Application
+// ---------------------------------------------------------------------------
+
+namespace xcpc {
+
+Application::Application(int& argc, char**& argv)
+    : base::Application(argc, argv)
+    , gtk4::EmulatorListener()
+    , _application(nullptr)
+    , _window(nullptr)
+    , _info_bar()
+    , _emulator(*this)
+    , _app_title(_("Xcpc - Amstrad CPC emulator"))
+    , _app_state(_("Unknown"))
+    , _timer(0)
+    , _snapshot()
+{
+}
+
+Application::~Application()
+{
+    stop_timer();
+    if(_application != nullptr) {
+        _application = (::g_object_unref(_application), nullptr);
+    }
+}
+
+auto Application::main() -> int
+{
+    if(_settings->quit() == false) {
+        _application = ::gtk_application_new("org.gtk.xcpc", G_APPLICATION_HANDLES_OPEN);
+        static_cast<void>(::g_signal_connect(G_OBJECT(_application), "startup", G_CALLBACK(&Callbacks::on_startup), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(_application), "shutdown", G_CALLBACK(&Callbacks::on_shutdown), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(_application), "activate", G_CALLBACK(&Callbacks::on_activate), this));
+        static_cast<void>(::g_signal_connect(G_OBJECT(_application), "open", G_CALLBACK(&Callbacks::on_open), this));
+    }
+    if(_application != nullptr) {
+        return ::g_application_run(G_APPLICATION(_application), _argc, _argv);
+    }
+    return EXIT_FAILURE;
+}
+
+auto Application::has_ximage() -> bool
+{
+    return false;
+}
+
+auto Application::has_opengl() -> bool
+{
+    return true;
+}
+
+auto Application::load_snapshot(const std::string& filename) -> void
+{
+    try {
+        _machine->load_snapshot(filename);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("load-snapshot has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::save_snapshot(const std::string& filename) -> void
+{
+    try {
+        _machine->save_snapshot(filename);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("save-snapshot has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::exit() -> void
+{
+    try {
+        if(_window != nullptr) {
+            ::gtk_window_destroy(GTK_WINDOW(_window));
+        }
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("exit-emulator has failed (%s)", e.what());
+    }
+}
+
+auto Application::play_emulator() -> void
+{
+    try {
+        _machine->play();
+        set_state(_("Playing"));
+        set_action_enabled("emulator-play", false);
+        set_action_enabled("emulator-pause", true);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("play-emulator has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::pause_emulator() -> void
+{
+    try {
+        _machine->pause();
+        set_state(_("Paused"));
+        set_action_enabled("emulator-play", true);
+        set_action_enabled("emulator-pause", false);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("pause-emulator has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::reset_emulator() -> void
+{
+    try {
+        pause_emulator();
+        _machine->reset();
+        play_emulator();
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("reset-emulator has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::create_disk_into_drive0(const std::string& filename) -> void
+{
+    try {
+        _machine->create_disk_into_drive0(filename);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("create-disk-into-drive0 has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::insert_disk_into_drive0(const std::string& filename) -> void
+{
+    try {
+        _machine->insert_disk_into_drive0(filename);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("insert-disk-into-drive0 has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::remove_disk_from_drive0() -> void
+{
+    try {
+        _machine->remove_disk_from_drive0();
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("remove-disk-from-drive0 has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::create_disk_into_drive1(const std::string& filename) -> void
+{
+    try {
+        _machine->create_disk_into_drive1(filename);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("create-disk-into-drive1 has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::insert_disk_into_drive1(const std::string& filename) -> void
+{
+    try {
+        _machine->insert_disk_into_drive1(filename);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("insert-disk-into-drive1 has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::remove_disk_from_drive1() -> void
+{
+    try {
+        _machine->remove_disk_from_drive1();
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("remove-disk-from-drive1 has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::set_volume(const float volume) -> void
+{
+    set_parameterf("audio.volume", volume);
+    update_all();
+}
+
+auto Application::set_crt_emulation(const bool crt_emulation) -> void
+{
+    set_parameterb("video.crt_emulation", crt_emulation);
+    update_all();
+}
+
+auto Application::set_company_name(const std::string& company_name) -> void
+{
+    try {
+        _machine->set_company_name(company_name);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("set-company-name has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::set_machine_type(const std::string& machine_type) -> void
+{
+    try {
+        _machine->set_machine_type(machine_type);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("set-machine-type has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::set_monitor_type(const std::string& monitor_type) -> void
+{
+    try {
+        _machine->set_monitor_type(monitor_type);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("set-monitor-type has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::set_refresh_rate(const std::string& refresh_rate) -> void
+{
+    try {
+        _machine->set_refresh_rate(refresh_rate);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("set-refresh-rate has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::set_keyboard_type(const std::string& keyboard_type) -> void
+{
+    try {
+        _machine->set_keyboard_type(keyboard_type);
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("set-keyboard-type has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::set_renderer_type(const std::string& renderer_type) -> void
+{
+    try {
+        if(renderer_type != "opengl") {
+            throw std::runtime_error(std::string("unsupported renderer") + ' ' + '<' + renderer_type + '>');
+        }
+        if(renderer_type != _machine->get_renderer_type()) {
+            _machine->set_renderer_type(renderer_type);
+        }
+    }
+    catch(const std::exception& e) {
+        ::xcpc_log_error("set-renderer-type has failed (%s)", e.what());
+    }
+    update_all();
+}
+
+auto Application::set_joystick_emulation(const bool enabled) -> void
+{
+    _emulator.set_joystick_emulation(enabled);
+    update_input();
+}
+
+auto Application::on_startup() -> void
+{
+    auto check_opengl = [&]() -> void
+    {
+        if(get_renderer_type() != "opengl") {
+            ::xcpc_log_debug("the gtk4 frontend always uses the opengl renderer");
+        }
+        _machine->set_renderer_type("opengl");
+    };
+
+    auto get_upscaler = [&](const std::string& upscaler) -> int
+    {
+        if(upscaler == "scale2x") {
+            return 1;
+        }
+        if(upscaler == "scale3x") {
+            return 2;
+        }
+        if(upscaler == "scale4x") {
+            return 3;
+        }
+        if(upscaler == "xbr2x") {
+            return 4;
+        }
+        return 0;
+    };
+
+    auto apply_settings = [&]() -> void
+    {
+        set_parameterb("video.ogl.frame_blending", _globals.video.frame_blending);
+        set_parameteri("video.upscaler", get_upscaler(_globals.video.upscaler));
+        set_parameterf("video.u_hsampling" , _globals.video.u_hsampling );
+        set_parameterf("video.u_vsampling" , _globals.video.u_vsampling );
+        set_parameterf("video.u_curvature" , _globals.video.u_curvature );
+        set_parameterf("video.u_corner"    , _globals.video.u_corner    );
+        set_parameterf("video.u_dotline"   , _globals.video.u_dotline   );
+        set_parameterf("video.u_dotmask"   , _globals.video.u_dotmask   );
+        set_parameterf("video.u_vignetting", _globals.video.u_vignetting);
+        set_parameterf("video.u_brightness", _globals.video.u_brightness);
+        set_volume(_globals.audio.volume);
+        set_joystick_emulation(_globals.input.joystick_emulation);
+    };
+
+    auto do_startup = [&]() -> void
+    {
+        check_opengl();
+        StartupProfile::mark("frontend: probe renderers");
+        build_actions();
+        build_menu_bar();
+        build_window();
+        StartupProfile::mark("frontend: build main window");
+        apply_settings();
+        play_emulator();
+        start_timer();
+        StartupProfile::mark("frontend: apply settings");
+    };
+
+    return do_startup();
+}
+
+auto Application::on_shutdown() -> void
+{
+    auto destroy_main_window = [&]() -> void
+    {
+        if(_window != nullptr) {
+            ::gtk_window_destroy(GTK_WINDOW(_window));
+        }
+    };
+
+    auto do_shutdown = [&]() -> void
+    {
+        stop_timer();
+        save_settings();
+        destroy_main_window();
+    };
+
+    return do_shutdown();
+}
+
+auto Application::on_activate() -> void
+{
+    if(_window != nullptr) {
+        ::gtk_window_present(GTK_WINDOW(_window));
+        _emulator.grab_focus();
+    }
+}
+
+auto Application::on_open(GFile** files, int num_files) -> void
+{
+    const int count = num_files;
+    for(int index = 0; index < count; ++index) {
+        char* path = ::g_file_get_path(files[index]);
+        if(path != nullptr) {
+            open_file(path);
+            path = (::g_free(path), nullptr);
+        }
+    }
+    on_activate();
+}
+
+auto Application::on_statistics() -> void
+{
+    update_snapshot();
+    update_stats();
+}
+
+auto Application::on_snapshot_load() -> void
+{
+    run_file_dialog(_("Load snapshot"), Utils::get_snadir(), traits::snapshot_patterns, false, &Application::load_snapshot);
+}
+
+auto Application::on_snapshot_save() -> void
+{
+    run_file_dialog(_("Save snapshot"), Utils::get_snadir(), traits::snapshot_patterns, true, &Application::save_snapshot);
+}
+
+auto Application::on_exit() -> void
+{
+    exit();
+}
+
+auto Application::on_emulator_play() -> void
+{
+    play_emulator();
+}
+
+auto Application::on_emulator_pause() -> void
+{
+    pause_emulator();
+}
+
+auto Application::on_emulator_reset() -> void
+{
+    reset_emulator();
+}
+
+auto Application::on_machine_cpc464() -> void
+{
+    set_machine_type("cpc464");
+}
+
+auto Application::on_machine_cpc664() -> void
+{
+    set_machine_type("cpc664");
+}
+
+auto Application::on_machine_cpc6128() -> void
+{
+    set_machine_type("cpc6128");
+}
+
+auto Application::on_company_isp() -> void
+{
+    set_company_name("isp");
+}
+
+auto Application::on_company_triumph() -> void
+{
+    set_company_name("triumph");
+}
+
+auto Application::on_company_saisho() -> void
+{
+    set_company_name("saisho");
+}
+
+auto Application::on_company_solavox() -> void
+{
+    set_company_name("solavox");
+}
+
+auto Application::on_company_awa() -> void
+{
+    set_company_name("awa");
+}
+
+auto Application::on_company_schneider() -> void
+{
+    set_company_name("schneider");
+}
+
+auto Application::on_company_orion() -> void
+{
+    set_company_name("orion");
+}
+
+auto Application::on_company_amstrad() -> void
+{
+    set_company_name("amstrad");
+}
+
+auto Application::on_monitor_color() -> void
+{
+    set_monitor_type("color");
+}
+
+auto Application::on_monitor_green() -> void
+{
+    set_monitor_type("green");
+}
+
+auto Application::on_monitor_gray() -> void
+{
+    set_monitor_type("gray");
+}
+
+auto Application::on_refresh_50hz() -> void
+{
+    set_refresh_rate("50hz");
+}
+
+auto Application::on_refresh_60hz() -> void
+{
+    set_refresh_rate("60hz");
+}
+
+auto Application::on_keyboard_english() -> void
+{
+    set_keyboard_type("english");
+}
+
+auto Application::on_keyboard_french() -> void
+{
+    set_keyboard_type("french");
+}
+
+auto Application::on_keyboard_german() -> void
+{
+    set_keyboard_type("german");
+}
+
+auto Application::on_keyboard_spanish() -> void
+{
+    set_keyboard_type("spanish");
+}
+
+auto Application::on_keyboard_danish() -> void
+{
+    set_keyboard_type("danish");
+}
+
+auto Application::on_drive0_disk_create() -> void
+{
+    run_file_dialog(_("Drive A - Create disk"), Utils::get_dskdir(), traits::disk_patterns, true, &Application::create_disk_into_drive0);
+}
+
+auto Application::on_drive0_disk_insert() -> void
+{
+    run_file_dialog(_("Drive A - Insert disk"), Utils::get_dskdir(), traits::disk_patterns, false, &Application::insert_disk_into_drive0);
+}
+
+auto Application::on_drive0_disk_remove() -> void
+{
+    remove_disk_from_drive0();
+}
+
+auto Application::on_drive1_disk_create() -> void
+{
+    run_file_dialog(_("Drive B - Create disk"), Utils::get_dskdir(), traits::disk_patterns, true, &Application::create_disk_into_drive1);
+}
+
+auto Application::on_drive1_disk_insert() -> void
+{
+    run_file_dialog(_("Drive B - Insert disk"), Utils::get_dskdir(), traits::disk_patterns, false, &Application::insert_disk_into_drive1);
+}
+
+auto Application::on_drive1_disk_remove() -> void
+{
+    remove_disk_from_drive1();
+}
+
+auto Application::on_volume_increase() -> void
+{
+    if((_globals.audio.volume += 0.05f) > 1.0f) {
+        _globals.audio.volume = 1.0f;
+    }
+    set_volume(_globals.audio.volume);
+}
+
+auto Application::on_volume_decrease() -> void
+{
+    if((_globals.audio.volume -= 0.05f) < 0.0f) {
+        _globals.audio.volume = 0.0f;
+    }
+    set_volume(_globals.audio.volume);
+}
+
+auto Application::on_crt_emulation_enable() -> void
+{
+    set_crt_emulation(true);
+    _globals.video.crt_emulation = true;
+}
+
+auto Application::on_crt_emulation_disable() -> void
+{
+    set_crt_emulation(false);
+    _globals.video.crt_emulation = false;
+}
+
+auto Application::on_joystick_emulation_enable() -> void
+{
+    set_joystick_emulation(true);
+    _globals.input.joystick_emulation = true;
+}
+
+auto Application::on_joystick_emulation_disable() -> void
+{
+    set_joystick_emulation(false);
+    _globals.input.joystick_emulation = false;
+}
+
+auto Application::on_help() -> void
+{
+    GtkAlertDialog* dialog = ::gtk_alert_dialog_new("%s", traits::help_primary);
+
+    ::gtk_alert_dialog_set_detail(dialog, traits::help_secondary);
+    ::gtk_alert_dialog_set_modal(dialog, TRUE);
+    ::gtk_alert_dialog_show(dialog, (_window != nullptr ? GTK_WINDOW(_window) : nullptr));
+    dialog = (::g_object_unref(dialog), nullptr);
+}
+
+auto Application::on_about() -> void
+{
+    const std::string version(Utils::get_version());
+    const std::string copyright(Utils::get_copyright());
+    const std::string comments(Utils::get_comments());
+    const std::string website(Utils::get_website());
+    const std::string license(Utils::get_license());
+    const std::string logo(Utils::get_datdir() + '/' + "pixmaps" + '/' + "xcpc.png");
+    GdkTexture*       texture = ::gdk_texture_new_from_filename(logo.c_str(), nullptr);
+
+    ::gtk_show_about_dialog ( (_window != nullptr ? GTK_WINDOW(_window) : nullptr)
+                            , "program-name", _("Xcpc")
+                            , "version"     , version.c_str()
+                            , "copyright"   , copyright.c_str()
+                            , "comments"    , comments.c_str()
+                            , "website"     , website.c_str()
+                            , "license"     , license.c_str()
+                            , "logo"        , texture
+                            , nullptr );
+    if(texture != nullptr) {
+        texture = (::g_object_unref(texture), nullptr);
+    }
+}
+
+auto Application::on_hotkey(unsigned int keysym) -> void
+{
+    switch(keysym) {
+        case XCPC_KEY_Pause:
+            on_emulator_pause();
+            break;
+        case XCPC_KEY_F1:
+            on_help();
+            break;
+        case XCPC_KEY_F2:
+            on_snapshot_load();
+            break;
+        case XCPC_KEY_F3:
+            on_snapshot_save();
+            break;
+        case XCPC_KEY_F5:
+            on_emulator_reset();
+            break;
+        case XCPC_KEY_F6:
+            on_drive0_disk_insert();
+            break;
+        case XCPC_KEY_F7:
+            on_drive0_disk_remove();
+            break;
+        case XCPC_KEY_F8:
+            on_drive1_disk_insert();
+            break;
+        case XCPC_KEY_F9:
+            on_drive1_disk_remove();
+            break;
+        default:
+            break;
+    }
+}
+
+auto Application::on_drop_file(const std::string& filename) -> void
+{
+    open_file(filename);
+}
+
+auto Application::build_actions() -> void
+{
+    static const GActionEntry entries[] = {
+        { "snapshot-load"             , &Callbacks::activate<&Application::on_snapshot_load>             , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "snapshot-save"             , &Callbacks::activate<&Application::on_snapshot_save>             , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "exit"                      , &Callbacks::activate<&Application::on_exit>                      , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "emulator-play"             , &Callbacks::activate<&Application::on_emulator_play>             , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "emulator-pause"            , &Callbacks::activate<&Application::on_emulator_pause>            , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "emulator-reset"            , &Callbacks::activate<&Application::on_emulator_reset>            , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "machine-cpc464"            , &Callbacks::activate<&Application::on_machine_cpc464>            , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "machine-cpc664"            , &Callbacks::activate<&Application::on_machine_cpc664>            , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "machine-cpc6128"           , &Callbacks::activate<&Application::on_machine_cpc6128>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-isp"               , &Callbacks::activate<&Application::on_company_isp>               , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-triumph"           , &Callbacks::activate<&Application::on_company_triumph>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-saisho"            , &Callbacks::activate<&Application::on_company_saisho>            , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-solavox"           , &Callbacks::activate<&Application::on_company_solavox>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-awa"               , &Callbacks::activate<&Application::on_company_awa>               , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-schneider"         , &Callbacks::activate<&Application::on_company_schneider>         , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-orion"             , &Callbacks::activate<&Application::on_company_orion>             , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "company-amstrad"           , &Callbacks::activate<&Application::on_company_amstrad>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "monitor-color"             , &Callbacks::activate<&Application::on_monitor_color>             , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "monitor-green"             , &Callbacks::activate<&Application::on_monitor_green>             , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "monitor-gray"              , &Callbacks::activate<&Application::on_monitor_gray>              , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "refresh-50hz"              , &Callbacks::activate<&Application::on_refresh_50hz>              , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "refresh-60hz"              , &Callbacks::activate<&Application::on_refresh_60hz>              , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "keyboard-english"          , &Callbacks::activate<&Application::on_keyboard_english>          , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "keyboard-french"           , &Callbacks::activate<&Application::on_keyboard_french>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "keyboard-german"           , &Callbacks::activate<&Application::on_keyboard_german>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "keyboard-spanish"          , &Callbacks::activate<&Application::on_keyboard_spanish>          , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "keyboard-danish"           , &Callbacks::activate<&Application::on_keyboard_danish>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "drive0-disk-create"        , &Callbacks::activate<&Application::on_drive0_disk_create>        , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "drive0-disk-insert"        , &Callbacks::activate<&Application::on_drive0_disk_insert>        , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "drive0-disk-remove"        , &Callbacks::activate<&Application::on_drive0_disk_remove>        , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "drive1-disk-create"        , &Callbacks::activate<&Application::on_drive1_disk_create>        , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "drive1-disk-insert"        , &Callbacks::activate<&Application::on_drive1_disk_insert>        , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "drive1-disk-remove"        , &Callbacks::activate<&Application::on_drive1_disk_remove>        , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "volume-increase"           , &Callbacks::activate<&Application::on_volume_increase>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "volume-decrease"           , &Callbacks::activate<&Application::on_volume_decrease>           , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "crt-emulation-enable"      , &Callbacks::activate<&Application::on_crt_emulation_enable>      , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "crt-emulation-disable"     , &Callbacks::activate<&Application::on_crt_emulation_disable>     , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "joystick-emulation-enable" , &Callbacks::activate<&Application::on_joystick_emulation_enable> , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "joystick-emulation-disable", &Callbacks::activate<&Application::on_joystick_emulation_disable>, nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "help"                      , &Callbacks::activate<&Application::on_help>                      , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+        { "about"                     , &Callbacks::activate<&Application::on_about>                     , nullptr, nullptr, nullptr, { 0, 0, 0 } },
+    };
+
+    ::g_action_map_add_action_entries(G_ACTION_MAP(_application), entries, G_N_ELEMENTS(entries), this);
+}
+
+auto Application::build_menu_bar() -> void
+{
+    GMenu* menu_bar = ::g_menu_new();
+
+    auto append_item = [&](GMenu* menu, const char* label, const char* action) -> void
+    {
+        ::g_menu_append(menu, label, action);
+    };
+
+    auto append_section = [&](GMenu* menu, GMenu* section) -> void
+    {
+        ::g_menu_append_section(menu, nullptr, G_MENU_MODEL(section));
+        ::g_object_unref(section);
+    };
+
+    auto append_submenu = [&](GMenu* menu, const char* label, GMenu* submenu) -> void
+    {
+        ::g_menu_append_submenu(menu, label, G_MENU_MODEL(submenu));
+        ::g_object_unref(submenu);
+    };
+
+    auto build_file_menu = [&]() -> void
+    {
+        GMenu* menu     = ::g_menu_new();
+        GMenu* snapshot = ::g_menu_new();
+        GMenu* session  = ::g_menu_new();
+        append_item(snapshot, _("Load snapshot..."), "app.snapshot-load");
+        append_item(snapshot, _("Save snapshot..."), "app.snapshot-save");
+        append_item(session, _("Exit"), "app.exit");
+        append_section(menu, snapshot);
+        append_section(menu, session);
+        append_submenu(menu_bar, _("File"), menu);
+    };
+
+    auto build_controls_menu = [&]() -> void
+    {
+        GMenu* menu    = ::g_menu_new();
+        GMenu* running = ::g_menu_new();
+        GMenu* reset   = ::g_menu_new();
+        append_item(running, _("Play"), "app.emulator-play");
+        append_item(running, _("Pause"), "app.emulator-pause");
+        append_item(reset, _("Reset"), "app.emulator-reset");
+        append_section(menu, running);
+        append_section(menu, reset);
+        append_submenu(menu_bar, _("Controls"), menu);
+    };
+
+    auto build_machine_menu = [&]() -> void
+    {
+        GMenu* menu     = ::g_menu_new();
+        GMenu* machine  = ::g_menu_new();
+        GMenu* company  = ::g_menu_new();
+        GMenu* monitor  = ::g_menu_new();
+        GMenu* refresh  = ::g_menu_new();
+        GMenu* keyboard = ::g_menu_new();
+        append_item(machine, _("CPC 464"), "app.machine-cpc464");
+        append_item(machine, _("CPC 664"), "app.machine-cpc664");
+        append_item(machine, _("CPC 6128"), "app.machine-cpc6128");
+        append_item(company, _("Isp"), "app.company-isp");
+        append_item(company, _("Triumph"), "app.company-triumph");
+        append_item(company, _("Saisho"), "app.company-saisho");
+        append_item(company, _("Solavox"), "app.company-solavox");
+        append_item(company, _("Awa"), "app.company-awa");
+        append_item(company, _("Schneider"), "app.company-schneider");
+        append_item(company, _("Orion"), "app.company-orion");
+        append_item(company, _("Amstrad"), "app.company-amstrad");
+        append_item(monitor, _("Color monitor"), "app.monitor-color");
+        append_item(monitor, _("Green monitor"), "app.monitor-green");
+        append_item(monitor, _("Gray monitor"), "app.monitor-gray");
+        append_item(refresh, _("50Hz"), "app.refresh-50hz");
+        append_item(refresh, _("60Hz"), "app.refresh-60hz");
+        append_item(keyboard, _("English"), "app.keyboard-english");
+        append_item(keyboard, _("French"), "app.keyboard-french");
+        append_item(keyboard, _("German"), "app.keyboard-german");
+        append_item(keyboard, _("Spanish"), "app.keyboard-spanish");
+        append_item(keyboard, _("Danish"), "app.keyboard-danish");
+        append_submenu(menu, _("Machine"), machine);
+        append_submenu(menu, _("Company"), company);
+        append_submenu(menu, _("Monitor"), monitor);
+        append_submenu(menu, _("Refresh"), refresh);
+        append_submenu(menu, _("Keyboard"), keyboard);
+        append_submenu(menu_bar, _("Machine"), menu);
+    };
+
+    auto build_drive_menu = [&](const char* label, const char* drive) -> void
+    {
+        GMenu* menu = ::g_menu_new();
+        const std::string prefix(std::string("app.") + drive);
+        append_item(menu, _("Create disk..."), (prefix + "-disk-create").c_str());
+        append_item(menu, _("Insert disk..."), (prefix + "-disk-insert").c_str());
+        append_item(menu, _("Remove disk..."), (prefix + "-disk-remove").c_str());
+        append_submenu(menu_bar, label, menu);
+    };
+
+    auto build_audio_menu = [&]() -> void
+    {
+        GMenu* menu = ::g_menu_new();
+        append_item(menu, _("Increase volume"), "app.volume-increase");
+        append_item(menu, _("Decrease volume"), "app.volume-decrease");
+        append_submenu(menu_bar, _("Audio"), menu);
+    };
+
+    auto build_video_menu = [&]() -> void
+    {
+        GMenu* menu = ::g_menu_new();
+        GMenu* crt  = ::g_menu_new();
+        append_item(crt, _("Enable"), "app.crt-emulation-enable");
+        append_item(crt, _("Disable"), "app.crt-emulation-disable");
+        append_submenu(menu, _("CRT emulation"), crt);
+        append_submenu(menu_bar, _("Video"), menu);
+    };
+
+    auto build_input_menu = [&]() -> void
+    {
+        GMenu* menu     = ::g_menu_new();
+        GMenu* joystick = ::g_menu_new();
+        append_item(joystick, _("Enable"), "app.joystick-emulation-enable");
+        append_item(joystick, _("Disable"), "app.joystick-emulation-disable");
+        append_submenu(menu, _("Joystick emulation"), joystick);
+        append_submenu(menu_bar, _("Input"), menu);
+    };
+
+    auto build_help_menu = [&]() -> void
+    {
+        GMenu* menu = ::g_menu_new();
+        append_item(menu, _("Help"), "app.help");
+        append_item(menu, _("About"), "app.about");
+        append_submenu(menu_bar, _("Help"), menu);
+    };
+
+    auto build_all = [&]() -> void
+    {
+        build_file_menu();
+        build_controls_menu();
+        build_machine_menu();
+        build_drive_menu(_("Drive A"), "drive0");
+        build_drive_menu(_("Drive B"), "drive1");
+        build_audio_menu();
+        build_video_menu();
+        build_input_menu();
+        build_help_menu();
+        ::gtk_application_set_menubar(_application, G_MENU_MODEL(menu_bar));
+        menu_bar = (::g_object_unref(menu_bar), nullptr);
+    };
+
+    return build_all();
+}
+
+auto Application::build_window() -> void
+{
+    GtkWidget* layout   = nullptr;
+    GtkWidget* info_bar = nullptr;
+
+    auto create_label = [&](const char* text, bool expand) -> GtkWidget*
+    {
+        GtkWidget* label = ::gtk_label_new(text);
+        ::gtk_label_set_ellipsize(GTK_LABEL(label), PANGO_ELLIPSIZE_MIDDLE);
+        ::gtk_widget_set_hexpand(label, (expand != false ? TRUE : FALSE));
+        ::gtk_widget_set_margin_start(label, 2);
+        ::gtk_widget_set_margin_end(label, 2);
+        ::gtk_box_append(GTK_BOX(info_bar), label);
+        return label;
+    };
+
+    auto build_main_window = [&]() -> void
+    {
+        _window = ::gtk_application_window_new(_application);
+        ::gtk_application_window_set_show_menubar(GTK_APPLICATION_WINDOW(_window), TRUE);
+        ::gtk_window_set_title(GTK_WINDOW(_window), _app_title.c_str());
+        ::gtk_window_set_default_size(GTK_WINDOW(_window), 800, 600);
+        static_cast<void>(::g_signal_connect(G_OBJECT(_window), "destroy", G_CALLBACK(&Callbacks::on_window_destroy), this));
+    };
+
+    auto build_layout = [&]() -> void
+    {
+        layout = ::gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
+        ::gtk_window_set_child(GTK_WINDOW(_window), layout);
+    };
+
+    auto build_emulator = [&]() -> void
+    {
+        ::gtk_box_append(GTK_BOX(layout), _emulator.create(get_backend()));
+    };
+
+    auto build_info_bar = [&]() -> void
+    {
+        info_bar = ::gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0);
+        ::gtk_box_append(GTK_BOX(layout), info_bar);
+        _info_bar.state  = create_label(_("State")  , false);
+        _info_bar.drive0 = create_label(_("Drive A"), false);
+        _info_bar.drive1 = create_label(_("Drive B"), false);
+        _info_bar.system = create_label(_("System") , true );
+        _info_bar.volume = create_label(_("Volume") , false);
+        _info_bar.stats  = create_label(_("Stats")  , false);
+    };
+
+    auto build_all = [&]() -> void
+    {
+        build_main_window();
+        build_layout();
+        build_emulator();
+        build_info_bar();
+        _emulator.grab_focus();
+    };
+
+    return build_all();
+}
+
+auto Application::open_file(const std::string& filename) -> void
+{
+    const char* c_str = filename.c_str();
+
+    if(traits::has_extension(c_str, ".sna") != false) {
+        load_snapshot(filename);
+        play_emulator();
+    }
+    else if(traits::has_extension(c_str, ".dsk") != false) {
+        insert_disk_into_drive0(filename);
+        play_emulator();
+    }
+    else if(traits::has_extension(c_str, ".dsk.gz") != false) {
+        insert_disk_into_drive0(filename);
+        play_emulator();
+    }
+    else if(traits::has_extension(c_str, ".dsk.bz2") != false) {
+        insert_disk_into_drive0(filename);
+        play_emulator();
+    }
+    else if(traits::has_extension(c_str, ".zip") != false) {
+        insert_disk_into_drive0(filename);
+        play_emulator();
+    }
+}
+
+auto Application::run_file_dialog(const std::string& title, const std::string& folder, const char* patterns[], bool save, FileCallback callback) -> void
+{
+    GtkFileDialog* dialog  = ::gtk_file_dialog_new();
+    GtkFileFilter* filter  = ::gtk_file_filter_new();
+    GListStore*    filters = ::g_list_store_new(GTK_TYPE_FILE_FILTER);
+    GFile*         initial = ::g_file_new_for_path(folder.c_str());
+
+    /* setup the dialog */ {
+        for(int index = 0; patterns[index] != nullptr; ++index) {
+            ::gtk_file_filter_add_pattern(filter, patterns[index]);
+        }
+        ::g_list_store_append(filters, filter);
+        ::gtk_file_dialog_set_title(dialog, title.c_str());
+        ::gtk_file_dialog_set_modal(dialog, TRUE);
+        ::gtk_file_dialog_set_filters(dialog, G_LIST_MODEL(filters));
+        ::gtk_file_dialog_set_initial_folder(dialog, initial);
+        initial = (::g_object_unref(initial), nullptr);
+        filters = (::g_object_unref(filters), nullptr);
+        filter  = (::g_object_unref(filter), nullptr);
+    }
+    /* the dialog is asynchronous, the emulation is resumed when it completes */ {
+        Callbacks::FileRequest* request = new Callbacks::FileRequest { this, callback, save };
+        GtkWindow*              parent  = (_window != nullptr ? GTK_WINDOW(_window) : nullptr);
+        pause_emulator();
+        if(save != false) {
+            ::gtk_file_dialog_save(dialog, parent, nullptr, &Callbacks::on_file_dialog, request);
+        }
+        else {
+            ::gtk_file_dialog_open(dialog, parent, nullptr, &Callbacks::on_file_dialog, request);
+        }
+    }
+}
+
+auto Application::set_action_enabled(const char* action, bool enabled) -> void
+{
+    if(_application != nullptr) {
+        GAction* instance = ::g_action_map_lookup_action(G_ACTION_MAP(_application), action);
+        if(instance != nullptr) {
+            ::g_simple_action_set_enabled(G_SIMPLE_ACTION(instance), (enabled != false ? TRUE : FALSE));
+        }
+    }
+}
+
+auto Application::start_timer() -> void
+{
+    static constexpr guint interval = 1511;
+
+    if(_timer != 0) {
+        _timer = (static_cast<void>(::g_source_remove(_timer)), 0);
+    }
+    if(_timer == 0) {
+        _timer = ::g_timeout_add(interval, G_SOURCE_FUNC(&Callbacks::on_statistics), this);
+    }
+}
+
+auto Application::stop_timer() -> void
+{
+    if(_timer != 0) {
+        _timer = (static_cast<void>(::g_source_remove(_timer)), 0);
+    }
+}
+
+auto Application::set_state(const std::string& state) -> void
+{
+    _app_state = state;
+    update_state();
+}
+
+auto Application::update_title() -> void
+{
+    std::string title;
+
+    auto format_title = [&]() -> void
+    {
+        title += _app_title;
+        title += ' ';
+        title += '-';
+        title += ' ';
+        title += _app_state;
+    };
+
+    auto update_title = [&]() -> void
+    {
+        if(_window != nullptr) {
+            ::gtk_window_set_title(GTK_WINDOW(_window), title.c_str());
+        }
+    };
+
+    auto do_update = [&]() -> void
+    {
+        format_title();
+        update_title();
+    };
+
+    return do_update();
+}
+
+auto Application::update_state() -> void
+{
+    std::string label(_app_state);
+
+    auto format_label = [&]() -> void
+    {
+        if(label.empty()) {
+            std::string(_("{unknown}")).swap(label);
+        }
+    };
+
+    auto update_label = [&]() -> void
+    {
+        if(_info_bar.state != nullptr) {
+            ::gtk_label_set_text(GTK_LABEL(_info_bar.state), label.c_str());
+        }
+    };
+
+    auto do_update = [&]() -> void
+    {
+        format_label();
+        update_label();
+    };
+
+    return do_update();
+}
+
+auto Application::update_drive0() -> void
+{
+    std::string label(_machine->get_drive0_filename());
+
+    auto format_label = [&]() -> void
+    {
+        const char* c_str = label.c_str();
+        const char* slash = ::strrchr(c_str, '/');
+        if(slash != nullptr) {
+            std::string(slash + 1).swap(label);
+        }
+        if(label.empty()) {
+            std::string(_("{empty}")).swap(label);
+        }
+    };
+
+    auto update_label = [&]() -> void
+    {
+        if(_info_bar.drive0 != nullptr) {
+            ::gtk_label_set_text(GTK_LABEL(_info_bar.drive0), label.c_str());
+        }
+    };
+
+    auto do_update = [&]() -> void
+    {
+        format_label();
+        update_label();
+    };
+
+    return do_update();
+}
+
+auto Application::update_drive1() -> void
+{
+    std::string label(_machine->get_drive1_filename());
+
+    auto format_label = [&]() -> void
+    {
+        const char* c_str = label.c_str();
+        const char* slash = ::strrchr(c_str, '/');
+        if(slash != nullptr) {
+            std::string(slash + 1).swap(label);
+        }
+        if(label.empty()) {
+            std::string(_("{empty}")).swap(label);
+        }
+    };
+
+    auto update_label = [&]() -> void
+    {
+        if(_info_bar.drive1 != nullptr) {
+            ::gtk_label_set_text(GTK_LABEL(_info_bar.drive1), label.c_str());
+        }
+    };
+
+    auto do_update = [&]() -> void
+    {
+        format_label();
+        update_label();
+    };
+
+    return do_update();
+}
+
+auto Application::update_system() -> void
+{
+    auto do_update = [&]() -> void
+    {
+        if(_info_bar.system != nullptr) {
+            ::gtk_label_set_text(GTK_LABEL(_info_bar.system), _machine->get_system_info().c_str());
+        }
+    };
+
+    return do_update();
+}
+
+auto Application::update_volume() -> void
+{
+    std::string label(_("Vol:"));
+
+    auto format_label = [&]() -> void
+    {
+        label += ' ';
+        label += std::to_string(static_cast<int>((_machine->get_volume() + 0.005f) * 100.0f));
+        label += '%';
+    };
+
+    auto update_label = [&]() -> void
+    {
+        if(_info_bar.volume != nullptr) {
+            ::gtk_label_set_text(GTK_LABEL(_info_bar.volume), label.c_str());
+        }
+    };
+
+    auto do_update = [&]() -> void
+    {
+        format_label();
+        update_label();
+    };
+
+    return do_update();
+}
+
+auto Application::update_stats() -> void
+{
+    auto do_update = [&]() -> void
+    {
+        std::string stats(_machine->get_statistics());
+        if(_snapshot.pending != 0) {
+            stats += ' ';
+            stats += '-';
+            stats += ' ';
+            stats += _("Saving snapshot...");
+        }
+        if(_info_bar.stats != nullptr) {
+            ::gtk_label_set_text(GTK_LABEL(_info_bar.stats), stats.c_str());
+        }
+    };
+
+    return do_update();
+}
+
+auto Application::update_snapshot() -> void
+{
+    const cpc::SnapshotProgress progress(_machine->get_snapshot_progress());
+
+    auto report_saved = [&]() -> void
+    {
+        if(progress.saved != _snapshot.saved) {
+            ::xcpc_log_print("snapshot saved <%s>", progress.filename.c_str());
+        }
+    };
+
+    auto report_failed = [&]() -> void
+    {
+        if(progress.failed != _snapshot.failed) {
+            ::xcpc_log_error("save-snapshot has failed (%s)", progress.error.c_str());
+        }
+    };
+
+    auto do_update = [&]() -> void
+    {
+        report_saved();
+        report_failed();
+        _snapshot = progress;
+    };
+
+    return do_update();
+}
+
+auto Application::update_input() -> void
+{
+    auto do_update = [&]() -> void
+    {
+        const bool enabled = _emulator.get_joystick_emulation();
+        set_action_enabled("joystick-emulation-enable", (enabled == false));
+        set_action_enabled("joystick-emulation-disable", (enabled != false));
+    };
+
+    return do_update();
+}
+
+auto Application::update_all() -> void
+{
+    update_title();
+    update_state();
+    update_drive0();
+    update_drive1();
+    update_system();
+    update_volume();
+    update_snapshot();
+    update_stats();
+    update_input();
+}
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
@@ -0,0 +1,273 @@
+/*
+ * xcpc-application.h - Copyright (c) 2001-2026 - Olivier Poncet
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef __XCPC_GTK4UI_APPLICATION_H__
+#define __XCPC_GTK4UI_APPLICATION_H__
+
+#include <gtk4ui/gtk4-emulator.h>
+#include "xcpc.h"
+
+// ---------------------------------------------------------------------------
+// xcpc forward declarations
+// ---------------------------------------------------------------------------
+
+namespace xcpc {
+
+class Application;
+
+}
+
+// ---------------------------------------------------------------------------
+// xcpc::Application
+// ---------------------------------------------------------------------------
+
+namespace xcpc {
+
+class Application final
+    : public base::Application
+    , public gtk4::EmulatorListener
+{
+public: // public interface
+    Application(int& argc, char**& argv);
+
+    Application(Application&&) = delete;
+
+    Application(const Application&) = delete;
+
+    Application& operator=(Application&&) = delete;
+
+    Application& operator=(const Application&) = delete;
+
+    virtual ~Application();
+
+    virtual auto main() -> int override final;
+
+public: // public methods
+    virtual auto has_ximage() -> bool override final;
+
+    virtual auto has_opengl() -> bool override final;
+
+    virtual auto load_snapshot(const std::string& filename) -> void override final;
+
+    virtual auto save_snapshot(const std::string& filename) -> void override final;
+
+    virtual auto exit() -> void override final;
+
+    virtual auto play_emulator() -> void override final;
+
+    virtual auto pause_emulator() -> void override final;
+
+    virtual auto reset_emulator() -> void override final;
+
+    virtual auto create_disk_into_drive0(const std::string& filename) -> void override final;
+
+    virtual auto insert_disk_into_drive0(const std::string& filename) -> void override final;
+
+    virtual auto remove_disk_from_drive0() -> void override final;
+
+    virtual auto create_disk_into_drive1(const std::string& filename) -> void override final;
+
+    virtual auto insert_disk_into_drive1(const std::string& filename) -> void override final;
+
+    virtual auto remove_disk_from_drive1() -> void override final;
+
+    virtual auto set_volume(const float value) -> void override final;
+
+    virtual auto set_crt_emulation(const bool crt_emulation) -> void override final;
+
+    virtual auto set_company_name(const std::string& company_name) -> void override final;
+
+    virtual auto set_machine_type(const std::string& machine_type) -> void override final;
+
+    virtual auto set_monitor_type(const std::string& monitor_type) -> void override final;
+
+    virtual auto set_refresh_rate(const std::string& refresh_rate) -> void override final;
+
+    virtual auto set_keyboard_type(const std::string& keyboard_type) -> void override final;
+
+    virtual auto set_renderer_type(const std::string& renderer_type) -> void override final;
+
+    virtual auto set_joystick_emulation(const bool enabled) -> void override final;
+
+public: // public signals
+    virtual auto on_startup() -> void override final;
+
+    virtual auto on_shutdown() -> void override final;
+
+    virtual auto on_statistics() -> void override final;
+
+    virtual auto on_snapshot_load() -> void override final;
+
+    virtual auto on_snapshot_save() -> void override final;
+
+    virtual auto on_exit() -> void override final;
+
+    virtual auto on_emulator_play() -> void override final;
+
+    virtual auto on_emulator_pause() -> void override final;
+
+    virtual auto on_emulator_reset() -> void override final;
+
+    virtual auto on_machine_cpc464() -> void override final;
+
+    virtual auto on_machine_cpc664() -> void override final;
+
+    virtual auto on_machine_cpc6128() -> void override final;
+
+    virtual auto on_company_isp() -> void override final;
+
+    virtual auto on_company_triumph() -> void override final;
+
+    virtual auto on_company_saisho() -> void override final;
+
+    virtual auto on_company_solavox() -> void override final;
+
+    virtual auto on_company_awa() -> void override final;
+
+    virtual auto on_company_schneider() -> void override final;
+
+    virtual auto on_company_orion() -> void override final;
+
+    virtual auto on_company_amstrad() -> void override final;
+
+    virtual auto on_monitor_color() -> void override final;
+
+    virtual auto on_monitor_green() -> void override final;
+
+    virtual auto on_monitor_gray() -> void override final;
+
+    virtual auto on_refresh_50hz() -> void override final;
+
+    virtual auto on_refresh_60hz() -> void override final;
+
+    virtual auto on_keyboard_english() -> void override final;
+
+    virtual auto on_keyboard_french() -> void override final;
+
+    virtual auto on_keyboard_german() -> void override final;
+
+    virtual auto on_keyboard_spanish() -> void override final;
+
+    virtual auto on_keyboard_danish() -> void override final;
+
+    virtual auto on_drive0_disk_create() -> void override final;
+
+    virtual auto on_drive0_disk_insert() -> void override final;
+
+    virtual auto on_drive0_disk_remove() -> void override final;
+
+    virtual auto on_drive1_disk_create() -> void override final;
+
+    virtual auto on_drive1_disk_insert() -> void override final;
+
+    virtual auto on_drive1_disk_remove() -> void override final;
+
+    virtual auto on_volume_increase() -> void override final;
+
+    virtual auto on_volume_decrease() -> void override final;
+
+    virtual auto on_crt_emulation_enable() -> void override final;
+
+    virtual auto on_crt_emulation_disable() -> void override final;
+
+    virtual auto on_joystick_emulation_enable() -> void override final;
+
+    virtual auto on_joystick_emulation_disable() -> void override final;
+
+    virtual auto on_help() -> void override final;
+
+    virtual auto on_about() -> void override final;
+
+    virtual auto on_hotkey(unsigned int keysym) -> void override final;
+
+    virtual auto on_drop_file(const std::string& filename) -> void override final;
+
+    auto on_activate() -> void;
+
+    auto on_open(GFile** files, int num_files) -> void;
+
+private: // private types
+    struct Callbacks;
+
+    struct InfoBar
+    {
+        GtkWidget* state  = nullptr;
+        GtkWidget* drive0 = nullptr;
+        GtkWidget* drive1 = nullptr;
+        GtkWidget* system = nullptr;
+        GtkWidget* volume = nullptr;
+        GtkWidget* stats  = nullptr;
+    };
+
+    using FileCallback = void (Application::*)(const std::string&);
+
+private: // private interface
+    auto build_actions() -> void;
+
+    auto build_menu_bar() -> void;
+
+    auto build_window() -> void;
+
+    auto open_file(const std::string& filename) -> void;
+
+    auto run_file_dialog(const std::string& title, const std::string& folder, const char* patterns[], bool save, FileCallback callback) -> void;
+
+    auto set_action_enabled(const char* action, bool enabled) -> void;
+
+    auto start_timer() -> void;
+
+    auto stop_timer() -> void;
+
+    auto set_state(const std::string& state) -> void;
+
+    auto update_title() -> void;
+
+    auto update_state() -> void;
+
+    auto update_drive0() -> void;
+
+    auto update_drive1() -> void;
+
+    auto update_system() -> void;
+
+    auto update_volume() -> void;
+
+    auto update_stats() -> void;
+
+    auto update_snapshot() -> void;
+
+    auto update_input() -> void;
+
+    auto update_all() -> void;
+
+private: // private data
+    GtkApplication*       _application;
+    GtkWidget*            _window;
+    InfoBar               _info_bar;
+    gtk4::Emulator        _emulator;
+    std::string           _app_title;
+    std::string           _app_state;
+    guint                 _timer;
+    cpc::SnapshotProgress _snapshot;
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// End-Of-File
+// ---------------------------------------------------------------------------
+
+#endif /* __XCPC_GTK4UI_APPLICATION_H__ */
@@ -27,8 +27,14 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
+#include "xcpc-application.h"
 #include "xcpc-main.h"
 
 // ---------------------------------------------------------------------------
@@ -37,7 +43,9 @@
 
 int xcpc_main(int* argc, char*** argv)
 {
-    return EXIT_SUCCESS;
+    const auto application(std::make_unique<xcpc::Application>(*argc, *argv));
+
+    return application->main();
 }
 
 // ---------------------------------------------------------------------------
@@ -23,10 +23,21 @@
 #include <cstring>
 #include <cstdint>
 #include <climits>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <strings.h>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
 #include <iostream>
+#include <algorithm>
 #include <stdexcept>
 #include "xcpc-dsk.h"
 
@@ -62,6 +73,29 @@ auto HelpCmd::run() -> void
     _console.println("    help        display this help");
     _console.println("    dump        dump the content of an existing disk image");
     _console.println("    create      create a new disk image");
+    _console.println("    check       check the structure of many disk images");
+    _console.println("    info        describe many disk images");
+    _console.println("    convert     convert many disk images to DSK or EDSK");
+    _console.println("    store       add many disk images to a deduplicated disk library");
+    _console.println("    restore     rebuild disk images from a disk library");
+    _console.println("    stats       describe the content of a disk library");
+    _console.println("");
+    _console.println("batch options (check, info, convert, store):");
+    _console.println("");
+    _console.println("    --json           report one JSON object per line");
+    _console.println("    --jobs=N         process N images in parallel");
+    _console.println("    --format=FORMAT  convert to 'dsk' or 'edsk' (default: edsk)");
+    _console.println("    --output=DIR     write the converted images into DIR");
+    _console.println("");
+    _console.println("library options (store, restore, stats):");
+    _console.println("");
+    _console.println("    --library=DIR    use the disk library stored in DIR");
+    _console.println("    --output=DIR     write the restored images into DIR");
+    _console.println("");
+    _console.println("restore rebuilds the named images, or every image if none is given");
+    _console.println("the emulator mounts a library image with the path DIR#NAME");
+    _console.println("");
+    _console.println("directories are searched recursively for .dsk, .edsk and compressed images");
     _console.println("");
 }
 
@@ -153,6 +187,718 @@ auto CreateCmd::run() -> void
     }
 }
 
+// ---------------------------------------------------------------------------
+// <anonymous>::BatchTraits
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct BatchTraits
+{
+    static auto has_suffix(const std::string& string, const char* suffix) -> bool
+    {
+        const size_t length = ::strlen(suffix);
+
+        if(string.size() < length) {
+            return false;
+        }
+        return ::strcasecmp(&string[string.size() - length], suffix) == 0;
+    }
+
+    static auto is_disk_name(const std::string& name) -> bool
+    {
+        static const char* const suffixes[] = {
+            ".dsk",
+            ".edsk",
+            ".dsk.gz",
+            ".dsk.bz2",
+            ".zip",
+        };
+        for(const char* suffix : suffixes) {
+            if(has_suffix(name, suffix)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static auto strip_compression(std::string name) -> std::string
+    {
+        static const char* const suffixes[] = {
+            ".gz",
+            ".bz2",
+            ".zip",
+        };
+        for(const char* suffix : suffixes) {
+            if(has_suffix(name, suffix)) {
+                name.resize(name.size() - ::strlen(suffix));
+                break;
+            }
+        }
+        if((has_suffix(name, ".dsk") == false) && (has_suffix(name, ".edsk") == false)) {
+            name += ".dsk";
+        }
+        return name;
+    }
+
+    static auto is_relative_path(const std::string& path) -> bool
+    {
+        size_t start = 0;
+
+        if(path.empty() || (path[0] == '/')) {
+            return false;
+        }
+        while(start <= path.size()) {
+            size_t slash = path.find('/', start);
+            if(slash == std::string::npos) {
+                slash = path.size();
+            }
+            if(path.compare(start, (slash - start), "..") == 0) {
+                return false;
+            }
+            start = slash + 1;
+        }
+        return true;
+    }
+
+    static auto is_directory(const std::string& path) -> bool
+    {
+        struct stat statbuf;
+
+        if(::stat(path.c_str(), &statbuf) != 0) {
+            return false;
+        }
+        return S_ISDIR(statbuf.st_mode);
+    }
+
+    static auto make_directories(const std::string& path) -> void
+    {
+        size_t slash = 0;
+
+        while((slash = path.find('/', slash + 1)) != std::string::npos) {
+            static_cast<void>(::mkdir(path.substr(0, slash).c_str(), 0755));
+        }
+    }
+
+    static auto get_library_stats(const dsk::Library& library) -> std::string
+    {
+        const dsk::Library::Stats stats(library.get_stats());
+        const double              ratio = (stats.stored_bytes != 0 ? (static_cast<double>(stats.image_bytes) / stats.stored_bytes) : 0.0);
+        char                      buffer[256];
+
+        static_cast<void>(::snprintf ( buffer, sizeof(buffer)
+                                     , "%zu images, %zu bytes stored as %zu unique segments in %zu bytes (%.2fx)"
+                                     , stats.images
+                                     , stats.image_bytes
+                                     , stats.blobs
+                                     , stats.stored_bytes
+                                     , ratio ));
+        return buffer;
+    }
+
+    static auto get_hardware_concurrency() -> unsigned int
+    {
+        const unsigned int count = std::thread::hardware_concurrency();
+
+        return (count != 0 ? count : 1);
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// BatchCmd
+// ---------------------------------------------------------------------------
+
+BatchCmd::BatchCmd ( base::Console&     console
+                   , const std::string& program
+                   , const std::string& command )
+    : Command(console, program, command)
+    , _json(false)
+    , _jobs(BatchTraits::get_hardware_concurrency())
+    , _mutex()
+{
+}
+
+auto BatchCmd::run() -> void
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<Entry>       entries;
+    std::vector<std::thread> workers;
+    std::atomic<size_t>      next(0);
+    size_t                   succeeded = 0;
+    size_t                   failed    = 0;
+    size_t                   bytes     = 0;
+
+    auto parse_arguments = [&]() -> void
+    {
+        for(auto& argument : _arguments) {
+            if(argument.compare(0, 2, "--") == 0) {
+                if(parse_option(argument) == false) {
+                    throw std::runtime_error(std::string() + '<' + argument + '>' + ' ' + "is not a valid option");
+                }
+            }
+            else {
+                collect(argument, entries);
+            }
+        }
+    };
+
+    auto check_targets = [&]() -> void
+    {
+        std::map<std::string, std::string> targets;
+        for(auto& entry : entries) {
+            const std::string target(get_target(entry));
+            if(target.empty()) {
+                continue;
+            }
+            const auto inserted = targets.emplace(target, entry.path);
+            if(inserted.second == false) {
+                throw std::runtime_error(std::string() + '<' + inserted.first->second + '>' + " and " + '<' + entry.path + '>' + ' ' + "would both be written as" + ' ' + '<' + target + '>');
+            }
+        }
+    };
+
+    auto process_entries = [&]() -> void
+    {
+        size_t index = 0;
+        while((index = next++) < entries.size()) {
+            Result result;
+            result.entry = entries[index];
+            try {
+                process(result);
+            }
+            catch(const std::exception& e) {
+                result.success = false;
+                result.error   = e.what();
+            }
+            report(result);
+            const std::lock_guard<std::mutex> lock(_mutex);
+            if(result.success != false) {
+                ++succeeded;
+            }
+            else {
+                ++failed;
+            }
+            bytes += result.bytes;
+        }
+    };
+
+    auto run_workers = [&]() -> void
+    {
+        const size_t count = std::min<size_t>(_jobs, entries.size());
+        for(size_t worker = 1; worker < count; ++worker) {
+            workers.emplace_back(process_entries);
+        }
+        process_entries();
+        for(auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    auto report_summary = [&](const double seconds) -> void
+    {
+        const double images_per_second = (seconds > 0.0 ? (entries.size() / seconds) : 0.0);
+        const double mbytes_per_second = (seconds > 0.0 ? (bytes / seconds / 1048576.0) : 0.0);
+        if(_json != false) {
+            _console.println ( "{\"summary\":{\"command\":%s,\"images\":%zu,\"succeeded\":%zu,\"failed\":%zu,\"bytes\":%zu,\"jobs\":%u,\"seconds\":%.6f,\"images_per_second\":%.1f,\"mib_per_second\":%.1f}}"
+                             , quote(_command).c_str()
+                             , entries.size()
+                             , succeeded
+                             , failed
+                             , bytes
+                             , _jobs
+                             , seconds
+                             , images_per_second
+                             , mbytes_per_second );
+        }
+        else {
+            _console.println ( "%s: %zu images (%zu succeeded, %zu failed) in %.3f s with %u jobs, %.1f images/s, %.1f MiB/s"
+                             , _command.c_str()
+                             , entries.size()
+                             , succeeded
+                             , failed
+                             , seconds
+                             , _jobs
+                             , images_per_second
+                             , mbytes_per_second );
+        }
+    };
+
+    auto do_run = [&]() -> void
+    {
+        parse_arguments();
+        prepare();
+        check_targets();
+        if(_jobs == 0) {
+            _jobs = 1;
+        }
+        const Clock::time_point start(Clock::now());
+        run_workers();
+        const Clock::time_point stop(Clock::now());
+        report_summary(std::chrono::duration<double>(stop - start).count());
+        finish();
+        if(failed != 0) {
+            throw std::runtime_error(std::to_string(failed) + ' ' + "image(s) failed");
+        }
+    };
+
+    return do_run();
+}
+
+auto BatchCmd::parse_option(const std::string& option) -> bool
+{
+    if(option == "--json") {
+        _json = true;
+        return true;
+    }
+    if(option.compare(0, 7, "--jobs=") == 0) {
+        _jobs = static_cast<unsigned int>(::strtoul(option.c_str() + 7, nullptr, 10));
+        return true;
+    }
+    return false;
+}
+
+auto BatchCmd::get_target(const Entry& entry) -> std::string
+{
+    return std::string();
+}
+
+auto BatchCmd::prepare() -> void
+{
+}
+
+auto BatchCmd::finish() -> void
+{
+}
+
+auto BatchCmd::collect(const std::string& path, std::vector<Entry>& entries) -> void
+{
+    std::vector<Entry> found;
+
+    auto walk = [&](const std::string& directory, const std::string& prefix, auto& recurse) -> void
+    {
+        DIR* dir = ::opendir(directory.c_str());
+        if(dir == nullptr) {
+            throw std::runtime_error(std::string() + '<' + directory + '>' + ' ' + "could not be opened");
+        }
+        struct dirent* dirent = nullptr;
+        while((dirent = ::readdir(dir)) != nullptr) {
+            const std::string name(dirent->d_name);
+            if((name == ".") || (name == "..")) {
+                continue;
+            }
+            const std::string child(directory + '/' + name);
+            if(BatchTraits::is_directory(child)) {
+                recurse(child, prefix + name + '/', recurse);
+            }
+            else if(BatchTraits::is_disk_name(name)) {
+                found.push_back(Entry { child, prefix + name });
+            }
+        }
+        static_cast<void>(::closedir(dir));
+    };
+
+    auto do_collect = [&]() -> void
+    {
+        if(BatchTraits::is_directory(path)) {
+            walk(path, std::string(), walk);
+            std::sort(found.begin(), found.end(), [](const Entry& lhs, const Entry& rhs) -> bool
+            {
+                return lhs.name < rhs.name;
+            });
+        }
+        else {
+            const size_t slash = path.rfind('/');
+            found.push_back(Entry { path, (slash != std::string::npos ? path.substr(slash + 1) : path) });
+        }
+        entries.insert(entries.end(), found.begin(), found.end());
+    };
+
+    return do_collect();
+}
+
+auto BatchCmd::report(const Result& result) -> void
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+
+    if(_json != false) {
+        std::string line;
+        line += "{\"file\":" + quote(result.entry.path);
+        line += ",\"status\":" + quote(result.success != false ? "ok" : "error");
+        line += ",\"bytes\":" + std::to_string(result.bytes);
+        if(result.fields.empty() == false) {
+            line += ',' + result.fields;
+        }
+        if(result.error.empty() == false) {
+            line += ",\"error\":" + quote(result.error);
+        }
+        line += '}';
+        _console.println("%s", line.c_str());
+    }
+    else {
+        if(result.error.empty() == false) {
+            _console.errorln("%s: error: %s", result.entry.path.c_str(), result.error.c_str());
+        }
+        else {
+            _console.println("%s: %s", result.entry.path.c_str(), (result.success != false ? "ok" : "invalid"));
+        }
+        if(result.text.empty() == false) {
+            _console.println("%s", result.text.c_str());
+        }
+    }
+}
+
+auto BatchCmd::quote(const std::string& string) -> std::string
+{
+    std::string quoted("\"");
+
+    for(const char character : string) {
+        switch(character) {
+            case '"':
+                quoted += "\\\"";
+                break;
+            case '\\':
+                quoted += "\\\\";
+                break;
+            case '\n':
+                quoted += "\\n";
+                break;
+            case '\r':
+                quoted += "\\r";
+                break;
+            case '\t':
+                quoted += "\\t";
+                break;
+            default:
+                if((static_cast<unsigned char>(character) < 0x20) || (static_cast<unsigned char>(character) >= 0x7f)) {
+                    char escaped[8];
+                    static_cast<void>(::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(character)));
+                    quoted += escaped;
+                }
+                else {
+                    quoted += character;
+                }
+                break;
+        }
+    }
+    return quoted += '"';
+}
+
+auto BatchCmd::quote(const std::vector<std::string>& strings) -> std::string
+{
+    std::string quoted("[");
+
+    for(auto& string : strings) {
+        if(quoted.size() > 1) {
+            quoted += ',';
+        }
+        quoted += quote(string);
+    }
+    return quoted += ']';
+}
+
+// ---------------------------------------------------------------------------
+// CheckCmd
+// ---------------------------------------------------------------------------
+
+CheckCmd::CheckCmd(base::Console& console, const std::string& program)
+    : BatchCmd(console, program, "check")
+{
+}
+
+auto CheckCmd::process(Result& result) -> void
+{
+    const dsk::DiskFile           disk(result.entry.path);
+    const dsk::DiskFile::Summary summary(disk.inspect());
+
+    result.success = summary.errors.empty();
+    result.bytes   = disk.get_size();
+    result.fields += "\"format\":" + quote(disk.is_extended() != false ? "EDSK" : "DSK");
+    result.fields += ",\"errors\":" + quote(summary.errors);
+    result.fields += ",\"warnings\":" + quote(summary.warnings);
+    for(auto& error : summary.errors) {
+        result.text += (result.text.empty() ? "" : "\n") + std::string("    error: ") + error;
+    }
+    for(auto& warning : summary.warnings) {
+        result.text += (result.text.empty() ? "" : "\n") + std::string("    warning: ") + warning;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// InfoCmd
+// ---------------------------------------------------------------------------
+
+InfoCmd::InfoCmd(base::Console& console, const std::string& program)
+    : BatchCmd(console, program, "info")
+{
+}
+
+auto InfoCmd::process(Result& result) -> void
+{
+    const dsk::DiskFile           disk(result.entry.path);
+    const dsk::DiskFile::Summary summary(disk.inspect());
+    const char*                  format = (disk.is_extended() != false ? "EDSK" : "DSK");
+
+    result.success = true;
+    result.bytes   = disk.get_size();
+    result.fields += "\"format\":" + quote(format);
+    result.fields += ",\"compressed\":" + std::string(disk.is_compressed() != false ? "true" : "false");
+    result.fields += ",\"creator\":" + quote(disk.get_creator());
+    result.fields += ",\"tracks\":" + std::to_string(disk.get_number_of_tracks());
+    result.fields += ",\"sides\":" + std::to_string(disk.get_number_of_sides());
+    result.fields += ",\"formatted_tracks\":" + std::to_string(summary.tracks);
+    result.fields += ",\"sectors\":" + std::to_string(summary.sectors);
+    result.fields += ",\"data_bytes\":" + std::to_string(summary.data);
+    result.fields += ",\"valid\":" + std::string(summary.errors.empty() ? "true" : "false");
+    result.text   += "    format ........... " + std::string(format) + (disk.is_compressed() != false ? " (compressed)" : "") + '\n';
+    result.text   += "    creator .......... " + disk.get_creator() + '\n';
+    result.text   += "    tracks ........... " + std::to_string(disk.get_number_of_tracks()) + '\n';
+    result.text   += "    sides ............ " + std::to_string(disk.get_number_of_sides()) + '\n';
+    result.text   += "    formatted tracks . " + std::to_string(summary.tracks) + '\n';
+    result.text   += "    sectors .......... " + std::to_string(summary.sectors) + '\n';
+    result.text   += "    data bytes ....... " + std::to_string(summary.data) + '\n';
+    result.text   += "    valid ............ " + std::string(summary.errors.empty() ? "yes" : "no");
+}
+
+// ---------------------------------------------------------------------------
+// ConvertCmd
+// ---------------------------------------------------------------------------
+
+ConvertCmd::ConvertCmd(base::Console& console, const std::string& program)
+    : BatchCmd(console, program, "convert")
+    , _extended(true)
+    , _output()
+{
+}
+
+auto ConvertCmd::parse_option(const std::string& option) -> bool
+{
+    if(option == "--format=dsk") {
+        _extended = false;
+        return true;
+    }
+    if(option == "--format=edsk") {
+        _extended = true;
+        return true;
+    }
+    if(option.compare(0, 9, "--output=") == 0) {
+        _output = option.substr(9);
+        return true;
+    }
+    return BatchCmd::parse_option(option);
+}
+
+auto ConvertCmd::process(Result& result) -> void
+{
+    const std::string   output(get_target(result.entry));
+    const dsk::DiskFile disk(result.entry.path);
+
+    if(output == result.entry.path) {
+        throw std::runtime_error(std::string() + '<' + output + '>' + ' ' + "would overwrite its source");
+    }
+    BatchTraits::make_directories(output);
+    disk.convert(output, _extended);
+    result.success = true;
+    result.bytes   = disk.get_size();
+    result.fields += "\"output\":" + quote(output);
+    result.fields += ",\"format\":" + quote(_extended != false ? "EDSK" : "DSK");
+    result.text   += "    converted to " + output;
+}
+
+auto ConvertCmd::get_target(const Entry& entry) -> std::string
+{
+    return _output + '/' + BatchTraits::strip_compression(entry.name);
+}
+
+auto ConvertCmd::prepare() -> void
+{
+    if(_output.empty()) {
+        throw std::runtime_error("no output directory given (use --output=DIR)");
+    }
+}
+
+// ---------------------------------------------------------------------------
+// StoreCmd
+// ---------------------------------------------------------------------------
+
+StoreCmd::StoreCmd(base::Console& console, const std::string& program)
+    : BatchCmd(console, program, "store")
+    , _directory()
+    , _library()
+    , _library_mutex()
+{
+}
+
+auto StoreCmd::parse_option(const std::string& option) -> bool
+{
+    if(option.compare(0, 10, "--library=") == 0) {
+        _directory = option.substr(10);
+        return true;
+    }
+    return BatchCmd::parse_option(option);
+}
+
+auto StoreCmd::process(Result& result) -> void
+{
+    const std::string   name(get_target(result.entry));
+    const dsk::DiskFile disk(result.entry.path);
+    dsk::Library::Added added;
+
+    /* parse and inflate in parallel, append to the library one image at a time */ {
+        const std::lock_guard<std::mutex> lock(_library_mutex);
+        added = _library->add(name, disk);
+    }
+    result.success = true;
+    result.bytes   = disk.get_size();
+    result.fields += "\"name\":" + quote(name);
+    result.fields += ",\"segments\":" + std::to_string(added.segments);
+    result.fields += ",\"new_segments\":" + std::to_string(added.new_blobs);
+    result.fields += ",\"new_bytes\":" + std::to_string(added.new_bytes);
+    result.text   += "    stored as " + name + " (" + std::to_string(added.segments) + " segments, " + std::to_string(added.new_blobs) + " new, " + std::to_string(added.new_bytes) + " bytes added)";
+}
+
+auto StoreCmd::get_target(const Entry& entry) -> std::string
+{
+    return BatchTraits::strip_compression(entry.name);
+}
+
+auto StoreCmd::prepare() -> void
+{
+    if(_directory.empty()) {
+        throw std::runtime_error("no library directory given (use --library=DIR)");
+    }
+    _library = std::make_unique<dsk::Library>(_directory);
+    _library->open(true);
+}
+
+auto StoreCmd::finish() -> void
+{
+    const dsk::Library::Stats stats(_library->get_stats());
+
+    if(_json != false) {
+        _console.println ( "{\"library\":{\"directory\":%s,\"images\":%zu,\"image_bytes\":%zu,\"segments\":%zu,\"stored_bytes\":%zu}}"
+                         , quote(_directory).c_str()
+                         , stats.images
+                         , stats.image_bytes
+                         , stats.blobs
+                         , stats.stored_bytes );
+    }
+    else {
+        _console.println("%s: %s", _directory.c_str(), BatchTraits::get_library_stats(*_library).c_str());
+    }
+    _library->close();
+}
+
+// ---------------------------------------------------------------------------
+// RestoreCmd
+// ---------------------------------------------------------------------------
+
+RestoreCmd::RestoreCmd(base::Console& console, const std::string& program)
+    : Command(console, program, "restore")
+{
+}
+
+auto RestoreCmd::run() -> void
+{
+    std::string              directory;
+    std::string              output;
+    std::vector<std::string> names;
+
+    auto parse_arguments = [&]() -> void
+    {
+        for(auto& argument : _arguments) {
+            if(argument.compare(0, 10, "--library=") == 0) {
+                directory = argument.substr(10);
+            }
+            else if(argument.compare(0, 9, "--output=") == 0) {
+                output = argument.substr(9);
+            }
+            else if(argument.compare(0, 2, "--") == 0) {
+                throw std::runtime_error(std::string() + '<' + argument + '>' + ' ' + "is not a valid option");
+            }
+            else {
+                names.push_back(argument);
+            }
+        }
+        if(directory.empty()) {
+            throw std::runtime_error("no library directory given (use --library=DIR)");
+        }
+        if(output.empty()) {
+            throw std::runtime_error("no output directory given (use --output=DIR)");
+        }
+    };
+
+    auto do_restore = [&](dsk::Library& library) -> void
+    {
+        if(names.empty()) {
+            names = library.get_names();
+        }
+        for(auto& name : names) {
+            if(BatchTraits::is_relative_path(name) == false) {
+                throw std::runtime_error(std::string() + '<' + name + '>' + ' ' + "is not a safe image name");
+            }
+            const std::string filename(output + '/' + name);
+            BatchTraits::make_directories(filename);
+            library.restore(name, filename);
+            _console.println("%s: restored to %s", name.c_str(), filename.c_str());
+        }
+    };
+
+    auto do_run = [&]() -> void
+    {
+        parse_arguments();
+        dsk::Library library(directory);
+        library.open(false);
+        do_restore(library);
+    };
+
+    return do_run();
+}
+
+// ---------------------------------------------------------------------------
+// StatsCmd
+// ---------------------------------------------------------------------------
+
+StatsCmd::StatsCmd(base::Console& console, const std::string& program)
+    : Command(console, program, "stats")
+{
+}
+
+auto StatsCmd::run() -> void
+{
+    std::string directory;
+
+    auto parse_arguments = [&]() -> void
+    {
+        for(auto& argument : _arguments) {
+            if(argument.compare(0, 10, "--library=") == 0) {
+                directory = argument.substr(10);
+            }
+            else {
+                throw std::runtime_error(std::string() + '<' + argument + '>' + ' ' + "is not a valid option");
+            }
+        }
+        if(directory.empty()) {
+            throw std::runtime_error("no library directory given (use --library=DIR)");
+        }
+    };
+
+    auto do_run = [&]() -> void
+    {
+        parse_arguments();
+        dsk::Library library(directory);
+        library.open(false);
+        for(auto& name : library.get_names()) {
+            _console.println("%s%c%s", directory.c_str(), dsk::Library::MEMBER_SEPARATOR, name.c_str());
+        }
+        _console.println("%s: %s", directory.c_str(), BatchTraits::get_library_stats(library).c_str());
+    };
+
+    return do_run();
+}
+
 // ---------------------------------------------------------------------------
 // Program
 // ---------------------------------------------------------------------------
@@ -191,6 +937,36 @@ auto Program::main() -> void
         _command = std::make_unique<CreateCmd>(_console, _program);
     };
 
+    auto build_check_cmd = [&]() -> void
+    {
+        _command = std::make_unique<CheckCmd>(_console, _program);
+    };
+
+    auto build_info_cmd = [&]() -> void
+    {
+        _command = std::make_unique<InfoCmd>(_console, _program);
+    };
+
+    auto build_convert_cmd = [&]() -> void
+    {
+        _command = std::make_unique<ConvertCmd>(_console, _program);
+    };
+
+    auto build_store_cmd = [&]() -> void
+    {
+        _command = std::make_unique<StoreCmd>(_console, _program);
+    };
+
+    auto build_restore_cmd = [&]() -> void
+    {
+        _command = std::make_unique<RestoreCmd>(_console, _program);
+    };
+
+    auto build_stats_cmd = [&]() -> void
+    {
+        _command = std::make_unique<StatsCmd>(_console, _program);
+    };
+
     auto build_command = [&](const std::string& command) -> void
     {
         if(command == "help") {
@@ -202,6 +978,24 @@ auto Program::main() -> void
         if(command == "create") {
             return build_create_cmd();
         }
+        if(command == "check") {
+            return build_check_cmd();
+        }
+        if(command == "info") {
+            return build_info_cmd();
+        }
+        if(command == "convert") {
+            return build_convert_cmd();
+        }
+        if(command == "store") {
+            return build_store_cmd();
+        }
+        if(command == "restore") {
+            return build_restore_cmd();
+        }
+        if(command == "stats") {
+            return build_stats_cmd();
+        }
         throw std::runtime_error(std::string() + '<' + command + '>' + ' ' + "is not a valid command");
     };
 
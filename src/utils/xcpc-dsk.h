@@ -18,6 +18,7 @@
 #define __XCPC_DSK_H__
 
 #include <xcpc/formats/dsk/dsk-format.h>
+#include <xcpc/formats/dsk/dsk-library.h>
 #include "arglist.h"
 #include "console.h"
 #include "program.h"
@@ -105,6 +106,187 @@ public: // public interface
     virtual auto run() -> void override final;
 };
 
+// ---------------------------------------------------------------------------
+// BatchCmd
+// ---------------------------------------------------------------------------
+
+class BatchCmd
+    : public Command
+{
+public: // public interface
+    BatchCmd ( base::Console&     console
+             , const std::string& program
+             , const std::string& command );
+
+    virtual ~BatchCmd() = default;
+
+    virtual auto run() -> void override;
+
+protected: // protected types
+    struct Entry
+    {
+        std::string path; /* path of the image             */
+        std::string name; /* path relative to its argument */
+    };
+
+    struct Result
+    {
+        Entry       entry;
+        bool        success = false;
+        size_t      bytes   = 0;
+        std::string fields;
+        std::string text;
+        std::string error;
+    };
+
+protected: // protected interface
+    virtual auto parse_option(const std::string& option) -> bool;
+
+    virtual auto process(Result& result) -> void = 0;
+
+    virtual auto get_target(const Entry& entry) -> std::string;
+
+    virtual auto prepare() -> void;
+
+    virtual auto finish() -> void;
+
+    auto collect(const std::string& path, std::vector<Entry>& entries) -> void;
+
+    auto report(const Result& result) -> void;
+
+    static auto quote(const std::string& string) -> std::string;
+
+    static auto quote(const std::vector<std::string>& strings) -> std::string;
+
+protected: // protected data
+    bool         _json;
+    unsigned int _jobs;
+    std::mutex   _mutex;
+};
+
+// ---------------------------------------------------------------------------
+// CheckCmd
+// ---------------------------------------------------------------------------
+
+class CheckCmd final
+    : public BatchCmd
+{
+public: // public interface
+    CheckCmd ( base::Console&     console
+             , const std::string& program );
+
+    virtual ~CheckCmd() = default;
+
+protected: // protected interface
+    virtual auto process(Result& result) -> void override final;
+};
+
+// ---------------------------------------------------------------------------
+// InfoCmd
+// ---------------------------------------------------------------------------
+
+class InfoCmd final
+    : public BatchCmd
+{
+public: // public interface
+    InfoCmd ( base::Console&     console
+            , const std::string& program );
+
+    virtual ~InfoCmd() = default;
+
+protected: // protected interface
+    virtual auto process(Result& result) -> void override final;
+};
+
+// ---------------------------------------------------------------------------
+// ConvertCmd
+// ---------------------------------------------------------------------------
+
+class ConvertCmd final
+    : public BatchCmd
+{
+public: // public interface
+    ConvertCmd ( base::Console&     console
+               , const std::string& program );
+
+    virtual ~ConvertCmd() = default;
+
+protected: // protected interface
+    virtual auto parse_option(const std::string& option) -> bool override final;
+
+    virtual auto process(Result& result) -> void override final;
+
+    virtual auto get_target(const Entry& entry) -> std::string override final;
+
+    virtual auto prepare() -> void override final;
+
+protected: // protected data
+    bool        _extended;
+    std::string _output;
+};
+
+// ---------------------------------------------------------------------------
+// StoreCmd
+// ---------------------------------------------------------------------------
+
+class StoreCmd final
+    : public BatchCmd
+{
+public: // public interface
+    StoreCmd ( base::Console&     console
+             , const std::string& program );
+
+    virtual ~StoreCmd() = default;
+
+protected: // protected interface
+    virtual auto parse_option(const std::string& option) -> bool override final;
+
+    virtual auto process(Result& result) -> void override final;
+
+    virtual auto get_target(const Entry& entry) -> std::string override final;
+
+    virtual auto prepare() -> void override final;
+
+    virtual auto finish() -> void override final;
+
+protected: // protected data
+    std::string                   _directory;
+    std::unique_ptr<dsk::Library> _library;
+    std::mutex                    _library_mutex;
+};
+
+// ---------------------------------------------------------------------------
+// RestoreCmd
+// ---------------------------------------------------------------------------
+
+class RestoreCmd final
+    : public Command
+{
+public: // public interface
+    RestoreCmd ( base::Console&     console
+               , const std::string& program );
+
+    virtual ~RestoreCmd() = default;
+
+    virtual auto run() -> void override final;
+};
+
+// ---------------------------------------------------------------------------
+// StatsCmd
+// ---------------------------------------------------------------------------
+
+class StatsCmd final
+    : public Command
+{
+public: // public interface
+    StatsCmd ( base::Console&     console
+             , const std::string& program );
+
+    virtual ~StatsCmd() = default;
+
+    virtual auto run() -> void override final;
+};
+
 // ---------------------------------------------------------------------------
 // Program
 // ---------------------------------------------------------------------------
@@ -31,6 +31,8 @@
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <stdexcept>
 #include "xcpc.h"
@@ -115,16 +117,20 @@ struct SettingsTraits
         {
             const auto& video(settings_file.table("video"));
 
-            globals.video.renderer      = video.entry("renderer"     ).get_string(globals.video.renderer     );
-            globals.video.crt_emulation = video.entry("crt_emulation").get_bool  (globals.video.crt_emulation);
-            globals.video.u_hsampling   = video.entry("u_hsampling"  ).get_double(globals.video.u_hsampling  );
-            globals.video.u_vsampling   = video.entry("u_vsampling"  ).get_double(globals.video.u_vsampling  );
-            globals.video.u_curvature   = video.entry("u_curvature"  ).get_double(globals.video.u_curvature  );
-            globals.video.u_corner      = video.entry("u_corner"     ).get_double(globals.video.u_corner     );
-            globals.video.u_dotline     = video.entry("u_dotline"    ).get_double(globals.video.u_dotline    );
-            globals.video.u_dotmask     = video.entry("u_dotmask"    ).get_double(globals.video.u_dotmask    );
-            globals.video.u_vignetting  = video.entry("u_vignetting" ).get_double(globals.video.u_vignetting );
-            globals.video.u_brightness  = video.entry("u_brightness" ).get_double(globals.video.u_brightness );
+            globals.video.renderer       = video.entry("renderer"      ).get_string(globals.video.renderer      );
+            globals.video.crt_emulation  = video.entry("crt_emulation" ).get_bool  (globals.video.crt_emulation );
+            globals.video.crt_filter     = video.entry("crt_filter"    ).get_bool  (globals.video.crt_filter    );
+            globals.video.frame_clock    = video.entry("frame_clock"   ).get_bool  (globals.video.frame_clock   );
+            globals.video.frame_blending = video.entry("frame_blending").get_bool  (globals.video.frame_blending);
+            globals.video.upscaler       = video.entry("upscaler"      ).get_string(globals.video.upscaler      );
+            globals.video.u_hsampling    = video.entry("u_hsampling"   ).get_double(globals.video.u_hsampling   );
+            globals.video.u_vsampling    = video.entry("u_vsampling"   ).get_double(globals.video.u_vsampling   );
+            globals.video.u_curvature    = video.entry("u_curvature"   ).get_double(globals.video.u_curvature   );
+            globals.video.u_corner       = video.entry("u_corner"      ).get_double(globals.video.u_corner      );
+            globals.video.u_dotline      = video.entry("u_dotline"     ).get_double(globals.video.u_dotline     );
+            globals.video.u_dotmask      = video.entry("u_dotmask"     ).get_double(globals.video.u_dotmask     );
+            globals.video.u_vignetting   = video.entry("u_vignetting"  ).get_double(globals.video.u_vignetting  );
+            globals.video.u_brightness   = video.entry("u_brightness"  ).get_double(globals.video.u_brightness  );
         };
 
         auto load_input_settings = [&](base::SettingsFile& settings_file) -> void
@@ -151,15 +157,22 @@ struct SettingsTraits
     {
         std::unique_ptr<cpc::Settings> settings(new cpc::Settings());
 
+        /* profile the ini file loading */ {
+            xcpc::StartupProfile::mark("settings: load ini file");
+        }
         /* seed cli defaults from ini values */ {
             if(globals.video.renderer != "default") {
                 settings->opt_renderer = globals.video.renderer;
             }
             settings->opt_crt_emulation = globals.video.crt_emulation;
+            settings->opt_crt_filter    = globals.video.crt_filter;
         }
         /* parse cli, overriding any seeded defaults */ {
             settings->parse(argc, argv);
         }
+        /* profile the cli parsing */ {
+            xcpc::StartupProfile::mark("settings: parse command line");
+        }
         return settings.release();
     }
 };
@@ -179,6 +192,7 @@ Application::Application(int& argc, char**& argv)
     , _settings(SettingsTraits::make_settings(_globals, argc, argv))
     , _machine(new cpc::Machine(*_settings))
 {
+    xcpc::StartupProfile::mark("machine: start audio");
 }
 
 auto Application::run_dialog(Dialog& dialog) -> void
@@ -206,16 +220,20 @@ auto Application::save_settings() -> void
     {
         auto& video(settings_file.table("video"));
 
-        video.entry("renderer"     ).set_string(_globals.video.renderer     );
-        video.entry("crt_emulation").set_bool  (_globals.video.crt_emulation);
-        video.entry("u_hsampling"  ).set_double(_globals.video.u_hsampling  );
-        video.entry("u_vsampling"  ).set_double(_globals.video.u_vsampling  );
-        video.entry("u_curvature"  ).set_double(_globals.video.u_curvature  );
-        video.entry("u_corner"     ).set_double(_globals.video.u_corner     );
-        video.entry("u_dotline"    ).set_double(_globals.video.u_dotline    );
-        video.entry("u_dotmask"    ).set_double(_globals.video.u_dotmask    );
-        video.entry("u_vignetting" ).set_double(_globals.video.u_vignetting );
-        video.entry("u_brightness" ).set_double(_globals.video.u_brightness );
+        video.entry("renderer"      ).set_string(_globals.video.renderer      );
+        video.entry("crt_emulation" ).set_bool  (_globals.video.crt_emulation );
+        video.entry("crt_filter"    ).set_bool  (_globals.video.crt_filter    );
+        video.entry("frame_clock"   ).set_bool  (_globals.video.frame_clock   );
+        video.entry("frame_blending").set_bool  (_globals.video.frame_blending);
+        video.entry("upscaler"      ).set_string(_globals.video.upscaler      );
+        video.entry("u_hsampling"   ).set_double(_globals.video.u_hsampling   );
+        video.entry("u_vsampling"   ).set_double(_globals.video.u_vsampling   );
+        video.entry("u_curvature"   ).set_double(_globals.video.u_curvature   );
+        video.entry("u_corner"      ).set_double(_globals.video.u_corner      );
+        video.entry("u_dotline"     ).set_double(_globals.video.u_dotline     );
+        video.entry("u_dotmask"     ).set_double(_globals.video.u_dotmask     );
+        video.entry("u_vignetting"  ).set_double(_globals.video.u_vignetting  );
+        video.entry("u_brightness"  ).set_double(_globals.video.u_brightness  );
     };
 
     auto save_input_settings = [&](SettingsFile& settings_file) -> void
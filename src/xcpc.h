@@ -97,16 +97,20 @@ namespace base {
 
 struct VideoSettings
 {
-    std::string renderer      = "default";
-    bool        crt_emulation = true;
-    float       u_hsampling   = 0.75f;
-    float       u_vsampling   = 0.25f;
-    float       u_curvature   = 0.10f;
-    float       u_corner      = 0.15f;
-    float       u_dotline     = 0.30f;
-    float       u_dotmask     = 0.10f;
-    float       u_vignetting  = 1.00f;
-    float       u_brightness  = 1.30f;
+    std::string renderer       = "default";
+    bool        crt_emulation  = true;
+    bool        crt_filter     = false;
+    bool        frame_clock    = false;
+    bool        frame_blending = false;
+    std::string upscaler       = "none";
+    float       u_hsampling    = 0.75f;
+    float       u_vsampling    = 0.25f;
+    float       u_curvature    = 0.10f;
+    float       u_corner       = 0.15f;
+    float       u_dotline      = 0.30f;
+    float       u_dotmask      = 0.10f;
+    float       u_vignetting   = 1.00f;
+    float       u_brightness   = 1.30f;
 };
 
 }
@@ -270,10 +274,6 @@ public: // public methods
 
     virtual auto set_joystick_emulation(const bool enabled) -> void = 0;
 
-    virtual auto set_joystick0(const std::string& device) -> void = 0;
-
-    virtual auto set_joystick1(const std::string& device) -> void = 0;
-
     auto get_machine_type() const -> const std::string
     {
         return _machine->get_machine_type();
@@ -381,26 +381,10 @@ public: // public signals
 
     virtual auto on_volume_decrease() -> void = 0;
 
-    virtual auto on_audio_settings() -> void = 0;
-
-    virtual auto on_renderer_ximage() -> void = 0;
-
-    virtual auto on_renderer_opengl() -> void = 0;
-
     virtual auto on_crt_emulation_enable() -> void = 0;
 
     virtual auto on_crt_emulation_disable() -> void = 0;
 
-    virtual auto on_video_settings() -> void = 0;
-
-    virtual auto on_joystick0_connect() -> void = 0;
-
-    virtual auto on_joystick0_disconnect() -> void = 0;
-
-    virtual auto on_joystick1_connect() -> void = 0;
-
-    virtual auto on_joystick1_disconnect() -> void = 0;
-
     virtual auto on_joystick_emulation_enable() -> void = 0;
 
     virtual auto on_joystick_emulation_disable() -> void = 0;